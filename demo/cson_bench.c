@@ -0,0 +1,449 @@
+/**
+ * @file cson_bench.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief cson性能测试
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 不依赖shell和log组件，可以直接在PC上编译运行：
+ *       gcc -O2 -Isrc demo/cson_bench.c src/cson.c src/cJSON.c src/cson_number.c src/cson_pool.c -lm -o cson_bench
+ *       ./cson_bench [每项测试时间(秒)]
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include "cson.h"
+
+
+#define BENCH_LIST_SIZE         1000        /**< 链表测试元素数量 */
+#define BENCH_NEST_DEPTH        32          /**< 嵌套测试深度 */
+#define BENCH_FREE_BATCH        64          /**< 释放测试每批对象数量 */
+
+
+/**
+ * @brief 内存分配统计
+ *
+ */
+static struct
+{
+    unsigned long mallocCount;              /**< 分配次数 */
+    unsigned long freeCount;                /**< 释放次数 */
+} benchAlloc;
+
+
+static void *benchMalloc(size_t size)
+{
+    benchAlloc.mallocCount++;
+    return malloc(size);
+}
+
+
+static void benchFree(void *ptr)
+{
+    if (ptr)
+    {
+        benchAlloc.freeCount++;
+    }
+    free(ptr);
+}
+
+
+/** 简单结构体 */
+struct flat
+{
+    int id;
+    short port;
+    char enable;
+    double ratio;
+    char *name;
+    char *host;
+};
+
+CsonModel flatModel[] =
+{
+    CSON_MODEL_OBJ(struct flat),
+    CSON_MODEL_INT(struct flat, id),
+    CSON_MODEL_SHORT(struct flat, port),
+    CSON_MODEL_BOOL(struct flat, enable),
+    CSON_MODEL_DOUBLE(struct flat, ratio),
+    CSON_MODEL_STRING(struct flat, name),
+    CSON_MODEL_STRING(struct flat, host),
+};
+
+
+/** 嵌套结构体 */
+struct nest
+{
+    int depth;
+    char *tag;
+    struct nest *child;
+};
+
+extern CsonModel nestModel[];
+
+CsonModel nestModel[] =
+{
+    CSON_MODEL_OBJ(struct nest),
+    CSON_MODEL_INT(struct nest, depth),
+    CSON_MODEL_STRING(struct nest, tag),
+    CSON_MODEL_STRUCT(struct nest, child, nestModel, 4),
+};
+
+
+/** 宽结构体 */
+#define BENCH_WIDE_FIELDS(X) \
+    X(f00) X(f01) X(f02) X(f03) X(f04) X(f05) X(f06) X(f07) \
+    X(f08) X(f09) X(f10) X(f11) X(f12) X(f13) X(f14) X(f15) \
+    X(f16) X(f17) X(f18) X(f19) X(f20) X(f21) X(f22) X(f23) \
+    X(f24) X(f25) X(f26) X(f27) X(f28) X(f29) X(f30) X(f31) \
+    X(f32) X(f33) X(f34) X(f35) X(f36) X(f37) X(f38) X(f39) \
+    X(f40) X(f41) X(f42) X(f43) X(f44) X(f45) X(f46) X(f47) \
+    X(f48) X(f49) X(f50) X(f51) X(f52) X(f53) X(f54) X(f55) \
+    X(f56) X(f57) X(f58) X(f59) X(f60) X(f61) X(f62) X(f63)
+
+#define BENCH_WIDE_MEMBER(name)     int name;
+#define BENCH_WIDE_MODEL(name)      CSON_MODEL_INT(struct wide, name),
+
+struct wide
+{
+    BENCH_WIDE_FIELDS(BENCH_WIDE_MEMBER)
+    char *comment;
+};
+
+CsonModel wideModel[] =
+{
+    CSON_MODEL_OBJ(struct wide),
+    BENCH_WIDE_FIELDS(BENCH_WIDE_MODEL)
+    CSON_MODEL_STRING(struct wide, comment),
+};
+
+
+/** 结构体链表 */
+struct records
+{
+    int count;
+    CsonList *items;
+};
+
+CsonModel recordsModel[] =
+{
+    CSON_MODEL_OBJ(struct records),
+    CSON_MODEL_INT(struct records, count),
+    CSON_MODEL_LIST(struct records, items, flatModel, sizeof(flatModel) / sizeof(CsonModel)),
+};
+
+
+/** 基本类型链表 */
+struct scalars
+{
+    CsonList *ints;
+    CsonList *doubles;
+    CsonList *strs;
+};
+
+CsonModel scalarsModel[] =
+{
+    CSON_MODEL_OBJ(struct scalars),
+    CSON_MODEL_LIST(struct scalars, ints, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_LIST(struct scalars, doubles, CSON_MODEL_DOUBLE_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_LIST(struct scalars, strs, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+};
+
+
+/**
+ * @brief 测试用例
+ *
+ */
+typedef struct
+{
+    const char *name;                       /**< 用例名称 */
+    CsonModel *model;                       /**< 数据模型 */
+    int modelSize;                          /**< 数据模型数量 */
+    char *json;                             /**< 输入json */
+    int jsonLen;                            /**< 输入json长度 */
+} BenchCase;
+
+
+/**
+ * @brief 测试结果
+ *
+ */
+typedef struct
+{
+    double seconds;                         /**< 耗时 */
+    unsigned long count;                    /**< 处理消息数量 */
+    unsigned long bytes;                    /**< 处理字节数 */
+    unsigned long allocs;                   /**< 内存分配次数 */
+} BenchResult;
+
+
+static char *benchFlatJson(char *p, int id)
+{
+    return p + sprintf(p,
+        "{\"id\": %d, \"port\": %d, \"enable\": %s, \"ratio\": %d.%03d, "
+        "\"name\": \"node-%d\", \"host\": \"10.0.%d.%d\"}",
+        id, 8000 + id % 1000, id & 1 ? "true" : "false", id % 100, id % 1000,
+        id, (id >> 8) & 0xFF, id & 0xFF);
+}
+
+
+static char *benchBuildFlat(void)
+{
+    char *json = malloc(256);
+    benchFlatJson(json, 42);
+    return json;
+}
+
+
+static char *benchBuildNest(void)
+{
+    char *json = malloc(BENCH_NEST_DEPTH * 64 + 16);
+    char *p = json;
+
+    for (int i = 0; i < BENCH_NEST_DEPTH; i++)
+    {
+        p += sprintf(p, "{\"depth\": %d, \"tag\": \"level%d\", \"child\": %s",
+            i, i, i + 1 < BENCH_NEST_DEPTH ? "" : "null");
+    }
+    for (int i = 0; i < BENCH_NEST_DEPTH; i++)
+    {
+        *p++ = '}';
+    }
+    *p = 0;
+    return json;
+}
+
+
+static char *benchBuildWide(void)
+{
+    char *json = malloc(64 * 24 + 64);
+    char *p = json;
+
+    *p++ = '{';
+    for (int i = 0; i < 64; i++)
+    {
+        p += sprintf(p, "\"f%02d\": %d, ", i, i * 1001);
+    }
+    sprintf(p, "\"comment\": \"wide object\"}");
+    return json;
+}
+
+
+static char *benchBuildRecords(void)
+{
+    char *json = malloc(BENCH_LIST_SIZE * 128 + 64);
+    char *p = json;
+
+    p += sprintf(p, "{\"count\": %d, \"items\": [", BENCH_LIST_SIZE);
+    for (int i = 0; i < BENCH_LIST_SIZE; i++)
+    {
+        if (i)
+        {
+            p += sprintf(p, ", ");
+        }
+        p = benchFlatJson(p, i);
+    }
+    sprintf(p, "]}");
+    return json;
+}
+
+
+static char *benchBuildScalars(void)
+{
+    char *json = malloc(BENCH_LIST_SIZE * 48 + 64);
+    char *p = json;
+
+    p += sprintf(p, "{\"ints\": [");
+    for (int i = 0; i < BENCH_LIST_SIZE; i++)
+    {
+        p += sprintf(p, "%s%d", i ? ", " : "", i * 37);
+    }
+    p += sprintf(p, "], \"doubles\": [");
+    for (int i = 0; i < BENCH_LIST_SIZE; i++)
+    {
+        p += sprintf(p, "%s%d.%d", i ? ", " : "", i, i % 10);
+    }
+    p += sprintf(p, "], \"strs\": [");
+    for (int i = 0; i < BENCH_LIST_SIZE; i++)
+    {
+        p += sprintf(p, "%s\"s%d\"", i ? ", " : "", i);
+    }
+    sprintf(p, "]}");
+    return json;
+}
+
+
+static double benchElapsed(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+
+/**
+ * @brief 测试反序列化
+ *
+ * @param bench 测试用例
+ * @param mode 解析方式 0 csonDecode 1 csonDecodeDirect 2 csonDecodeCompiled
+ * @param duration 测试时间
+ * @param result 测试结果
+ */
+static void benchDecode(BenchCase *bench, int mode, double duration, BenchResult *result)
+{
+    void *objs[BENCH_FREE_BATCH];
+    CsonCompiledModel *compiled = csonCompileModel(bench->model, bench->modelSize);
+    clock_t start;
+
+    memset(result, 0, sizeof(BenchResult));
+    while (result->seconds < duration)
+    {
+        benchAlloc.mallocCount = 0;
+        start = clock();
+        for (int i = 0; i < BENCH_FREE_BATCH; i++)
+        {
+            switch (mode)
+            {
+            case 1:
+                objs[i] = csonDecodeDirect(bench->json, bench->model, bench->modelSize);
+                break;
+            case 2:
+                objs[i] = csonDecodeCompiled(bench->json, compiled);
+                break;
+            default:
+                objs[i] = csonDecode(bench->json, bench->model, bench->modelSize);
+                break;
+            }
+        }
+        result->seconds += benchElapsed(start);
+        result->allocs += benchAlloc.mallocCount;
+        result->count += BENCH_FREE_BATCH;
+        for (int i = 0; i < BENCH_FREE_BATCH; i++)
+        {
+            csonFree(objs[i], bench->model, bench->modelSize);
+        }
+    }
+    result->bytes = result->count * bench->jsonLen;
+    csonFreeCompiledModel(compiled);
+}
+
+
+/**
+ * @brief 测试序列化
+ *
+ * @param bench 测试用例
+ * @param fmt 是否格式化输出
+ * @param duration 测试时间
+ * @param result 测试结果
+ */
+static void benchEncode(BenchCase *bench, int fmt, double duration, BenchResult *result)
+{
+    void *obj = csonDecode(bench->json, bench->model, bench->modelSize);
+    clock_t start;
+    char *json;
+
+    memset(result, 0, sizeof(BenchResult));
+    benchAlloc.mallocCount = 0;
+    start = clock();
+    while (result->seconds < duration)
+    {
+        for (int i = 0; i < BENCH_FREE_BATCH; i++)
+        {
+            json = fmt
+                ? csonEncode(obj, bench->model, bench->modelSize, bench->jsonLen, 1)
+                : csonEncodeUnformatted(obj, bench->model, bench->modelSize);
+            result->bytes += strlen(json);
+            csonFreeJson(json);
+        }
+        result->count += BENCH_FREE_BATCH;
+        result->seconds = benchElapsed(start);
+    }
+    result->allocs = benchAlloc.mallocCount;
+    csonFree(obj, bench->model, bench->modelSize);
+}
+
+
+/**
+ * @brief 测试对象释放
+ *
+ * @param bench 测试用例
+ * @param duration 测试时间
+ * @param result 测试结果
+ */
+static void benchFreeObject(BenchCase *bench, double duration, BenchResult *result)
+{
+    void *objs[BENCH_FREE_BATCH];
+    clock_t start;
+
+    memset(result, 0, sizeof(BenchResult));
+    while (result->seconds < duration)
+    {
+        for (int i = 0; i < BENCH_FREE_BATCH; i++)
+        {
+            objs[i] = csonDecode(bench->json, bench->model, bench->modelSize);
+        }
+        benchAlloc.freeCount = 0;
+        start = clock();
+        for (int i = 0; i < BENCH_FREE_BATCH; i++)
+        {
+            csonFree(objs[i], bench->model, bench->modelSize);
+        }
+        result->seconds += benchElapsed(start);
+        result->allocs += benchAlloc.freeCount;
+        result->count += BENCH_FREE_BATCH;
+    }
+    result->bytes = result->count * bench->jsonLen;
+}
+
+
+static void benchReport(const char *name, const char *op, BenchResult *result)
+{
+    double seconds = result->seconds > 0 ? result->seconds : 1e-9;
+
+    printf("%-10s %-20s %14.0f %12.2f %12.1f\r\n", name, op,
+        result->count / seconds,
+        result->bytes / seconds / (1024 * 1024),
+        (double)result->allocs / result->count);
+}
+
+
+int main(int argc, char *argv[])
+{
+    double duration = argc > 1 ? atof(argv[1]) : 0.5;
+    BenchResult result;
+    BenchCase benches[] =
+    {
+        {"flat", flatModel, sizeof(flatModel) / sizeof(CsonModel), benchBuildFlat(), 0},
+        {"nested", nestModel, sizeof(nestModel) / sizeof(CsonModel), benchBuildNest(), 0},
+        {"wide", wideModel, sizeof(wideModel) / sizeof(CsonModel), benchBuildWide(), 0},
+        {"records", recordsModel, sizeof(recordsModel) / sizeof(CsonModel), benchBuildRecords(), 0},
+        {"scalars", scalarsModel, sizeof(scalarsModel) / sizeof(CsonModel), benchBuildScalars(), 0},
+    };
+
+    csonInit(benchMalloc, benchFree);
+
+    printf("%-10s %-20s %14s %12s %12s\r\n",
+        "case", "operation", "msg/s", "MB/s", "alloc/msg");
+    for (size_t i = 0; i < sizeof(benches) / sizeof(BenchCase); i++)
+    {
+        BenchCase *bench = &benches[i];
+        bench->jsonLen = (int)strlen(bench->json);
+
+        benchDecode(bench, 0, duration, &result);
+        benchReport(bench->name, "csonDecode", &result);
+        benchDecode(bench, 1, duration, &result);
+        benchReport(bench->name, "csonDecodeDirect", &result);
+        benchDecode(bench, 2, duration, &result);
+        benchReport(bench->name, "csonDecodeCompiled", &result);
+        benchEncode(bench, 1, duration, &result);
+        benchReport(bench->name, "csonEncode", &result);
+        benchEncode(bench, 0, duration, &result);
+        benchReport(bench->name, "csonEncodeUnformatted", &result);
+        benchFreeObject(bench, duration, &result);
+        benchReport(bench->name, "csonFree", &result);
+        free(bench->json);
+    }
+    return 0;
+}
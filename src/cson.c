@@ -10,10 +10,19 @@
  */
 
 #include "cson.h"
+#include "cson_gen.h"
 #include "cJSON.h"
+#include "cson_scan.h"
+#include "cson_number.h"
+#include "cson_pool.h"
 #include "stddef.h"
 #include "string.h"
 #include "stdio.h"
+#include "ctype.h"
+#include "limits.h"
+#include "float.h"
+#include "math.h"
+#include "stdint.h"
 
 
 /**
@@ -44,7 +53,7 @@ CsonModel csonBasicListModel[] =
  * 
  */
 struct {
-    void *(*malloc)(int);
+    void *(*malloc)(size_t);
     void (*free)(void *);
 } cson;
 
@@ -57,7 +66,7 @@ struct {
  */
 void csonInit(void *malloc, void *free)
 {
-    cson.malloc = (void *(*)(int))malloc;
+    cson.malloc = (void *(*)(size_t))malloc;
     cson.free = (void (*)(void *))free;
     cJSON_InitHooks(&(cJSON_Hooks){(void *(*)(size_t))cson.malloc, cson.free});
 }
@@ -69,6 +78,135 @@ signed char csonIsBasicListModel(CsonModel *model)
 }
 
 
+/**
+ * @brief 获取数据模型描述的对象大小
+ *
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return int 对象大小
+ */
+static int csonModelObjSize(CsonModel *model, int modelSize)
+{
+    int objSize = 0;
+    for (short i = 0; i < modelSize; i++)
+    {
+        if (model[i].type == CSON_TYPE_OBJ)
+        {
+            objSize = model[i].param.objSize;
+        }
+    }
+    return objSize;
+}
+
+
+/**
+ * @brief 记录数组元素数量
+ *
+ * @param obj 对象
+ * @param field 数组成员数据模型
+ * @param count 写入的元素数量
+ */
+static void csonSetArrayCount(void *obj, CsonModel *field, int count)
+{
+    if (field->param.array.countOffset)
+    {
+        *(int *)((char *)obj + field->offset + field->param.array.countOffset) =
+            count < field->param.array.size ? count : field->param.array.size;
+    }
+}
+
+
+/**
+ * @brief 获取需要编码的数组元素数量
+ *
+ * @param obj 对象
+ * @param field 数组成员数据模型
+ * @return short 元素数量，不超过数组大小
+ */
+static short csonGetArrayCount(void *obj, CsonModel *field)
+{
+    int count;
+
+    if (!field->param.array.countOffset)
+    {
+        return field->param.array.size;
+    }
+    count = *(int *)((char *)obj + field->offset + field->param.array.countOffset);
+    return count < 0 ? 0 : (count < field->param.array.size ? count : field->param.array.size);
+}
+
+
+/**
+ * @brief 使用上下文分配内存
+ *
+ * @param ctx 上下文，为NULL或未设置分配函数时使用`csonInit`设置的函数
+ * @param size 内存大小
+ * @return void* 分配的内存
+ */
+void *csonCtxMalloc(CsonContext *ctx, size_t size)
+{
+    return ctx && ctx->malloc ? ctx->malloc(size) : cson.malloc(size);
+}
+
+
+/**
+ * @brief 使用上下文释放内存
+ *
+ * @param ctx 上下文，为NULL或未设置释放函数时使用`csonInit`设置的函数
+ * @param ptr 内存
+ */
+void csonCtxFree(CsonContext *ctx, void *ptr)
+{
+    if (ctx && ctx->free)
+    {
+        ctx->free(ptr);
+    }
+    else
+    {
+        cson.free(ptr);
+    }
+}
+
+
+/**
+ * @brief 分配CsonList节点
+ *
+ * @param ctx 上下文，为NULL或未设置分配函数时从节点池分配
+ * @return CsonList* 节点
+ */
+static CsonList *csonListNew(CsonContext *ctx)
+{
+    if (ctx && ctx->arena)
+    {
+        return csonArenaAlloc(ctx->arena, sizeof(CsonList));
+    }
+    if (ctx && ctx->malloc)
+    {
+        return ctx->malloc(sizeof(CsonList));
+    }
+    return csonPoolAlloc(CSON_POOL_LIST, sizeof(CsonList), cson.malloc, cson.free);
+}
+
+
+/**
+ * @brief 释放CsonList节点
+ *
+ * @param ctx 上下文，为NULL或未设置释放函数时释放到节点池
+ * @param node 节点
+ */
+static void csonListRelease(CsonContext *ctx, CsonList *node)
+{
+    if (ctx && ctx->free)
+    {
+        ctx->free(node);
+    }
+    else
+    {
+        csonPoolFree(CSON_POOL_LIST, node, cson.malloc, cson.free);
+    }
+}
+
+
 /**
  * @brief 解析JSON整型
  * 
@@ -105,6 +243,22 @@ double csonDecodeDouble(cJSON *json, char *key)
 }
 
 
+/**
+ * @brief 解析JSON长整型
+ *
+ * @param json JSON对象
+ * @param key key
+ * @return long 解析出的长整型数
+ * @note cJSON的valueint只有int宽度，长整型从valuedouble转换，可以精确表示到2^53
+ */
+long csonDecodeLong(cJSON *json, char *key)
+{
+    int64_t value = csonNumberToInt64(csonDecodeDouble(json, key));
+
+    return value > LONG_MAX ? LONG_MAX : (value < LONG_MIN ? LONG_MIN : (long)value);
+}
+
+
 /**
  * @brief 解析JSON字符串数据
  * 
@@ -116,7 +270,7 @@ char* csonDecodeString(cJSON *json, char *key)
 {
     char *p = NULL;
     char *str = NULL;
-    short strLen = 0;
+    size_t strLen = 0;
     cJSON *item = key ? cJSON_GetObjectItem(json, key) : json;
     if (item && item->type == cJSON_String)
     {
@@ -137,6 +291,24 @@ char* csonDecodeString(cJSON *json, char *key)
 }
 
 
+/**
+ * @brief 解析JSON字符串数据到字符串视图
+ *
+ * @param json JSON对象
+ * @param key key
+ * @param view 字符串视图
+ * @note cJSON树在解析结束后释放，视图指向单独分配的字符串副本
+ */
+void csonDecodeStringView(cJSON *json, char *key, CsonStringView *view)
+{
+    char *str = csonDecodeString(json, key);
+
+    view->str = str;
+    view->len = str ? strlen(str) : 0;
+    view->owned = str ? 1 : 0;
+}
+
+
 /**
  * @brief 解析JOSN布尔型数据
  * 
@@ -167,28 +339,97 @@ char csonDecodeBool(cJSON *json, char *key)
 void *csonDecodeList(cJSON *json, char *key, CsonModel *model, int modelSize)
 {
     CsonList *list = NULL;
+    CsonList **tail = &list;
+    CsonList *node;
     cJSON *array = cJSON_GetObjectItem(json, key);
+    cJSON *item;
+    int basic = csonIsBasicListModel(model);
+    int objSize = basic ? csonModelObjSize(model, modelSize) : 0;
 
     if (array && array->type == cJSON_Array)
     {
-        for (short i = 0; i < cJSON_GetArraySize(array); i++)
+        for (item = array->child; item; item = item->next)
         {
-            void *obj = csonDecodeObject(cJSON_GetArrayItem(array, i), model, modelSize);
-            if (csonIsBasicListModel(model))
+            void *obj = csonDecodeObject(item, model, modelSize);
+            node = csonListNew(NULL);
+            if (!node)
+            {
+                if (basic)
+                {
+                    cson.free(obj);
+                }
+                else
+                {
+                    csonFree(obj, model, modelSize);
+                }
+                break;
+            }
+            node->next = NULL;
+            node->obj = NULL;
+            if (basic)
             {
-                list = csonListAdd(list, (void *)(*((int *)obj)));
-                cson.free(obj);
+                if (obj)
+                {
+                    memcpy(&node->obj, obj,
+                        objSize < (int)sizeof(void *) ? objSize : (int)sizeof(void *));
+                    cson.free(obj);
+                }
             }
             else
             {
-                list = csonListAdd(list, obj);
+                node->obj = obj;
             }
+            *tail = node;
+            tail = &node->next;
         }
     }
     return list;
 }
 
 
+/**
+ * @brief 解析CsonVector数据
+ *
+ * @param json JSON对象
+ * @param key key
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ * @param vector 解析得到的CsonVector
+ * @note 按json数组长度一次分配全部元素，null元素保持为0
+ */
+void csonDecodeVector(cJSON *json, char *key, CsonModel *model, int modelSize, CsonVector *vector)
+{
+    cJSON *array = cJSON_GetObjectItem(json, key);
+    cJSON *item;
+    int objSize = csonModelObjSize(model, modelSize);
+    int count;
+    char *data;
+    void *obj;
+
+    memset(vector, 0, sizeof(CsonVector));
+    if (!array || array->type != cJSON_Array || (count = cJSON_GetArraySize(array)) <= 0)
+    {
+        return;
+    }
+    CSON_ASSERT(objSize <= 0 || (size_t)count <= SIZE_MAX / objSize, return);
+    data = cson.malloc((size_t)count * objSize);
+    CSON_ASSERT(data, return);
+    memset(data, 0, (size_t)count * objSize);
+    vector->data = data;
+    vector->len = count;
+    vector->cap = count;
+    for (item = array->child; item; item = item->next, data += objSize)
+    {
+        obj = csonDecodeObject(item, model, modelSize);
+        if (obj)
+        {
+            memcpy(data, obj, objSize);
+            cson.free(obj);
+        }
+    }
+}
+
+
 /**
  * @brief 解析数组
  * 
@@ -197,51 +438,54 @@ void *csonDecodeList(cJSON *json, char *key, CsonModel *model, int modelSize)
  * @param base 数组基址
  * @param elementType 数组元素类型
  * @param arraySize 数组大小
+ * @return short 写入的元素数量
  */
-void csonDecodeArray(cJSON *json, char *key, void * base, CsonType elementType, short arraySize)
+short csonDecodeArray(cJSON *json, char *key, void * base, CsonType elementType, short arraySize)
 {
     cJSON *array = cJSON_GetObjectItem(json, key);
     cJSON *item;
-    char *str;
-    short strLen;
+    short i = 0;
 
     if (array && array->type == cJSON_Array)
     {
-        for (short i = 0; i < cJSON_GetArraySize(array); i++)
+        item = array->child;
+        for (i = 0; item && i < arraySize; i++, item = item->next)
         {
-            item = cJSON_GetArrayItem(array, i);
             switch (elementType)
             {
             case CSON_TYPE_CHAR:
-                *(char *)((int)base + (i * sizeof(char))) = (char)item->valueint;
+                *(char *)((char *)base + (i * sizeof(char))) = (char)item->valueint;
                 break;
             case CSON_TYPE_SHORT:
-                *(short *)((int)base + (i * sizeof(short))) = (short)item->valueint;
+                *(short *)((char *)base + (i * sizeof(short))) = (short)item->valueint;
                 break;
             case CSON_TYPE_INT:
-                *(int *)((int)base + (i * sizeof(int))) = (int)item->valueint;
+                *(int *)((char *)base + (i * sizeof(int))) = (int)item->valueint;
                 break;
             case CSON_TYPE_LONG:
-                *(long *)((int)base + (i * sizeof(long))) = (long)item->valueint;
+                /* 与其他整型元素一致，true的valueint为1，而valuedouble为0 */
+                *(long *)((char *)base + (i * sizeof(long))) =
+                    item->type == cJSON_True ? 1 : csonDecodeLong(item, NULL);
                 break;
             case CSON_TYPE_FLOAT:
-                *(float *)((int)base + (i * sizeof(float))) = (float)item->valuedouble;
+                *(float *)((char *)base + (i * sizeof(float))) = (float)item->valuedouble;
                 break;
             case CSON_TYPE_DOUBLE:
-                *(double *)((int)base + (i * sizeof(double))) = (double)item->valuedouble;
+                *(double *)((char *)base + (i * sizeof(double))) = (double)item->valuedouble;
                 break;
             case CSON_TYPE_STRING:
-                strLen = strlen(item->valuestring);
-                str = cson.malloc(strLen + 1);
-                memcpy(str, item->valuestring, strLen);
-                *(str + strLen) = 0;
-                *(int *)((int)base + (i * sizeof(int))) = (int)str;
+                *(char **)((char *)base + (i * sizeof(char *))) = csonDecodeString(item, NULL);
+                break;
+            case CSON_TYPE_STRING_VIEW:
+                csonDecodeStringView(item, NULL,
+                    (CsonStringView *)((char *)base + (i * sizeof(CsonStringView))));
                 break;
             default:
                 break;
             }
         }
     }
+    return i;
 }
 
 
@@ -261,60 +505,63 @@ void *csonDecodeObject(cJSON *json, CsonModel *model, int modelSize)
         return NULL;
     }
 
-    short objSize = 0;
-    for (short i = 0; i < modelSize; i++)
-    {
-        if (model[i].type == CSON_TYPE_OBJ)
-        {
-            objSize = model[i].param.objSize;
-        }
-    }
+    int objSize = csonModelObjSize(model, modelSize);
     void *obj = cson.malloc(objSize);
     CSON_ASSERT(obj, return NULL);
+    memset(obj, 0, objSize);
 
     for (short i = 0; i < modelSize; i++)
     {
         switch (model[i].type)
         {
         case CSON_TYPE_CHAR:
-            *(char *)((int)obj + model[i].offset) = (char)csonDecodeNumber(json, model[i].key);
+            *(char *)((char *)obj + model[i].offset) = (char)csonDecodeNumber(json, model[i].key);
             break;
         case CSON_TYPE_SHORT:
-            *(short *)((int)obj + model[i].offset) = (short)csonDecodeNumber(json, model[i].key);
+            *(short *)((char *)obj + model[i].offset) = (short)csonDecodeNumber(json, model[i].key);
             break;
         case CSON_TYPE_INT:
-            *(int *)((int)obj + model[i].offset) = (int)csonDecodeNumber(json, model[i].key);
+            *(int *)((char *)obj + model[i].offset) = (int)csonDecodeNumber(json, model[i].key);
             break;
         case CSON_TYPE_LONG:
-            *(long *)((int)obj + model[i].offset) = (long)csonDecodeNumber(json, model[i].key);
+            *(long *)((char *)obj + model[i].offset) = csonDecodeLong(json, model[i].key);
             break;
         case CSON_TYPE_FLOAT:
-            *(float *)((int)obj + model[i].offset) = (float)csonDecodeDouble(json, model[i].key);
+            *(float *)((char *)obj + model[i].offset) = (float)csonDecodeDouble(json, model[i].key);
             break;
         case CSON_TYPE_DOUBLE:
-            *(double *)((int)obj + model[i].offset) = csonDecodeDouble(json, model[i].key);
+            *(double *)((char *)obj + model[i].offset) = csonDecodeDouble(json, model[i].key);
             break;
         case CSON_TYPE_BOOL:
-            *(char *)((int)obj + model[i].offset) = (char)csonDecodeBool(json, model[i].key);
+            *(char *)((char *)obj + model[i].offset) = (char)csonDecodeBool(json, model[i].key);
             break;
         case CSON_TYPE_STRING:
-            *(int *)((int)obj + model[i].offset) = (int)csonDecodeString(json, model[i].key);
+            *(char **)((char *)obj + model[i].offset) = csonDecodeString(json, model[i].key);
+            break;
+        case CSON_TYPE_STRING_VIEW:
+            csonDecodeStringView(json, model[i].key,
+                (CsonStringView *)((char *)obj + model[i].offset));
             break;
         case CSON_TYPE_LIST:
-            *(int *)((int)obj + model[i].offset) = (int)csonDecodeList(json,
+            *(CsonList **)((char *)obj + model[i].offset) = csonDecodeList(json,
             model[i].key, model[i].param.sub.model, model[i].param.sub.size);
             break;
+        case CSON_TYPE_VECTOR:
+            csonDecodeVector(json, model[i].key, model[i].param.sub.model,
+                model[i].param.sub.size, (CsonVector *)((char *)obj + model[i].offset));
+            break;
         case CSON_TYPE_STRUCT:
-            *(int *)((int)obj + model[i].offset) = (int)csonDecodeObject(
+            *(void **)((char *)obj + model[i].offset) = csonDecodeObject(
                 cJSON_GetObjectItem(json, model[i].key), 
                 model[i].param.sub.model, model[i].param.sub.size);
             break;
         case CSON_TYPE_ARRAY:
-            csonDecodeArray(json, model[i].key, (void *)((int)obj + model[i].offset), 
-                model[i].param.array.eleType, model[i].param.array.size);
+            csonSetArrayCount(obj, &model[i], csonDecodeArray(json, model[i].key,
+                (void *)((char *)obj + model[i].offset),
+                model[i].param.array.eleType, model[i].param.array.size));
             break;
         case CSON_TYPE_JSON:
-            *(int *)((int)obj + model[i].offset) = (int)cJSON_PrintUnformatted(
+            *(char **)((char *)obj + model[i].offset) = cJSON_PrintUnformatted(
                 cJSON_GetObjectItem(json, model[i].key));
             break;
         default:
@@ -344,263 +591,7470 @@ void *csonDecode(const char *jsonStr, CsonModel *model, int modelSize)
 }
 
 
+/**
+ * @brief CSON直接解析器
+ *
+ * @note 即`cson_gen.h`中生成的解析函数使用的`CsonReader`
+ */
+typedef struct cson_reader
+{
+    const char *pos;                    /**< 当前解析位置 */
+    const char *end;                    /**< 输入结束位置 */
+    const char *err;                    /**< 错误位置 */
+    CsonContext *ctx;                   /**< 解析上下文，为NULL时使用默认上下文 */
+    int ownViews;                       /**< 字符串视图总是复制，输入在解析后不再有效时使用 */
+    char update;                        /**< 就地更新已有对象，由`csonDecodeInto`设置 */
+    int updateFlags;                    /**< 就地更新标记，CSON_UPDATE_* */
+} CsonParser;
+
 
 /**
- * @brief 数字编码编码JSON
- * 
- * @param json json对象
- * @param key key
- * @param num 数值
+ * @brief CSON输出缓冲
+ *
+ * @note 即`cson_gen.h`中生成的输出函数使用的`CsonWriter`
  */
-void csonEncodeNumber(cJSON *json, char *key, double num)
+typedef struct cson_writer
 {
-    if (key)
+    char *buffer;                       /**< 缓冲区 */
+    int length;                         /**< 缓冲区大小 */
+    int offset;                         /**< 已写入长度 */
+    int fixed;                          /**< 固定大小缓冲，空间不足时只统计长度 */
+    CsonContext *ctx;                   /**< 内存分配上下文 */
+    CsonWriteFunc write;                /**< 输出函数，不为NULL时缓冲写满后交给输出函数并从头写入 */
+    void *param;                        /**< 输出函数参数 */
+} CsonBuffer;
+
+
+#define CSON_SEEN_BUFFER_SIZE       32  /**< 栈上成员解析标记缓冲大小(字节) */
+#define CSON_SKIP_DEPTH             512 /**< 快速跳过时允许的最大嵌套层数 */
+#define CSON_TO_LOWER(c)            ((c) >= 'A' && (c) <= 'Z' ? (c) + ('a' - 'A') : (c))  /**< 键值比较使用的小写转换，与C locale下的tolower一致 */
+
+/**
+ * @brief 预编译成员
+ *
+ */
+typedef struct
+{
+    CsonModel *model;                   /**< 成员数据模型 */
+    int index;                          /**< 成员在数据模型中的索引 */
+    int keyLen;                         /**< 键值长度 */
+    unsigned int hash;                  /**< 键值哈希 */
+    int next;                           /**< 下一个同名成员, -1表示没有 */
+    CsonCompiledModel *sub;             /**< 子结构体预编译模型 */
+} CsonCompiledField;
+
+
+/**
+ * @brief 预编译数据模型
+ *
+ */
+struct cson_compiled_model
+{
+    CsonModel *model;                   /**< 数据模型 */
+    int modelSize;                      /**< 数据模型数量 */
+    int objSize;                        /**< 对象大小 */
+    int fieldCount;                     /**< 成员数量 */
+    CsonCompiledField *fields;          /**< 成员, 与数据模型顺序一致 */
+    int *table;                         /**< 键值哈希表, 存放成员索引, -1表示空 */
+    unsigned int tableMask;             /**< 哈希表掩码 */
+    struct cson_compiled_model *next;   /**< 同一次编译生成的下一个模型 */
+};
+
+
+static int csonParserObject(CsonParser *parser, CsonModel *model, int modelSize,
+                            CsonCompiledModel *compiled, void **obj);
+static int csonParserFields(CsonParser *parser, void *obj, CsonModel *model, int modelSize,
+                            CsonCompiledModel *compiled);
+static int csonParserMembers(CsonParser *parser, void *obj, CsonModel *model, int modelSize,
+                             CsonCompiledModel *compiled);
+static int csonParserSkipValue(CsonParser *parser);
+static void csonFreeFields(CsonContext *ctx, void *obj, CsonModel *model, int modelSize);
+static void csonFreeObject(CsonContext *ctx, void *obj, CsonModel *model, int modelSize);
+static void csonFreeList(CsonContext *ctx, CsonList *list, CsonModel *model, int modelSize);
+static void csonFreeElements(CsonContext *ctx, char *data, size_t len,
+                             CsonModel *model, int modelSize);
+static void csonFreeVector(CsonContext *ctx, CsonVector *vector, CsonModel *model, int modelSize);
+static int csonReprintValue(CsonParser *parser, CsonBuffer *buffer, int depth, int fmt);
+
+
+/**
+ * @brief 获取基本数据类型大小
+ *
+ * @param type 数据类型
+ * @return int 数据大小
+ */
+static int csonTypeSize(CsonType type)
+{
+    switch (type)
     {
-        cJSON_AddNumberToObject(json, key, num);
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_BOOL:
+        return sizeof(char);
+    case CSON_TYPE_SHORT:
+        return sizeof(short);
+    case CSON_TYPE_INT:
+        return sizeof(int);
+    case CSON_TYPE_LONG:
+        return sizeof(long);
+    case CSON_TYPE_FLOAT:
+        return sizeof(float);
+    case CSON_TYPE_DOUBLE:
+        return sizeof(double);
+    case CSON_TYPE_STRING:
+        return sizeof(char *);
+    case CSON_TYPE_STRING_VIEW:
+        return sizeof(CsonStringView);
+    default:
+        return 0;
     }
-    else
+}
+
+
+/**
+ * @brief 写入数值到对象成员
+ *
+ * @param ptr 成员地址
+ * @param type 成员类型
+ * @param value 整型值
+ * @param dvalue 浮点值
+ * @note 整型成员直接使用解析出的64位整数，超出成员范围时取最接近的边界值，
+ *       char和short与cJSON一致，从int截断
+ */
+static void csonStoreNumber(void *ptr, CsonType type, int64_t value, double dvalue)
+{
+    int ivalue = value > INT_MAX ? INT_MAX : (value < INT_MIN ? INT_MIN : (int)value);
+
+    switch (type)
     {
-        json->type = cJSON_Number;
-        json->valuedouble = num;
-        json->valueint = (int)num;
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_BOOL:
+        *(char *)ptr = (char)ivalue;
+        break;
+    case CSON_TYPE_SHORT:
+        *(short *)ptr = (short)ivalue;
+        break;
+    case CSON_TYPE_INT:
+        *(int *)ptr = ivalue;
+        break;
+    case CSON_TYPE_LONG:
+        *(long *)ptr = value > LONG_MAX ? LONG_MAX : (value < LONG_MIN ? LONG_MIN : (long)value);
+        break;
+    case CSON_TYPE_FLOAT:
+        *(float *)ptr = (float)dvalue;
+        break;
+    case CSON_TYPE_DOUBLE:
+        *(double *)ptr = dvalue;
+        break;
+    default:
+        break;
     }
 }
 
 
 /**
- * @brief 字符串编码编码JSON
- * 
- * @param json json对象
- * @param key key
- * @param str 字符串
+ * @brief 跳过空白字符
+ *
+ * @param parser 解析器
  */
-void csonEncodeString(cJSON *json, char *key, char *str)
+static void csonParserSkip(CsonParser *parser)
 {
-    if (key)
+    parser->pos = csonScanSpace(parser->pos, parser->end);
+}
+
+
+/**
+ * @brief 获取当前字符
+ *
+ * @param parser 解析器
+ * @return char 当前字符，输入结束时为0
+ */
+static char csonParserPeek(CsonParser *parser)
+{
+    return parser->pos < parser->end ? *parser->pos : 0;
+}
+
+
+/**
+ * @brief 设置解析错误
+ *
+ * @param parser 解析器
+ * @return int -1
+ */
+static int csonParserError(CsonParser *parser)
+{
+    if (!parser->err)
     {
-        cJSON_AddStringToObject(json, key, str);
+        parser->err = parser->pos;
     }
-    else
+    return -1;
+}
+
+
+/**
+ * @brief 匹配字面量
+ *
+ * @param parser 解析器
+ * @param literal 字面量
+ * @param len 字面量长度
+ * @return int 是否匹配
+ */
+static int csonParserLiteral(CsonParser *parser, const char *literal, int len)
+{
+    if (parser->end - parser->pos >= len && memcmp(parser->pos, literal, len) == 0)
     {
-        json->type = cJSON_String;
-        json->valuestring = str;
+        parser->pos += len;
+        return 1;
     }
+    return 0;
 }
 
 
 /**
- * @brief CsonList编码成JSON对象
- * 
- * @param list CsonList对象
- * @param model 数据模型
- * @param modelSize 数据模型数量
- * @return cJSON* 编码得到的JOSN对象
+ * @brief 当前值是否为数字
+ *
+ * @param parser 解析器
+ * @return int 是否为数字
  */
-cJSON* csonEncodeList(CsonList *list, CsonModel *model, int modelSize)
+static int csonParserIsNumber(CsonParser *parser)
 {
-    cJSON *root = cJSON_CreateArray();
-    cJSON *item;
-    CsonList *p = list;
+    char c = csonParserPeek(parser);
+    return c == '-' || (c >= '0' && c <= '9');
+}
 
-    while (p)
+
+/**
+ * @brief 解析数字
+ *
+ * @param parser 解析器
+ * @param number 解析出的数字
+ * @note 解析规则与cJSON的parse_number一致
+ */
+static void csonParserNumber(CsonParser *parser, CsonNumber *number)
+{
+    parser->pos = csonNumberParse(parser->pos, parser->end, number);
+}
+
+
+/**
+ * @brief 扫描字符串
+ *
+ * @param parser 解析器
+ * @param str 字符串内容起始位置
+ * @param len 字符串内容原始长度
+ * @param escaped 字符串是否包含转义
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserString(CsonParser *parser, const char **str, int *len, int *escaped)
+{
+    const char *ptr;
+
+    if (csonParserPeek(parser) != '\"')
     {
-        if (p->obj)
+        return csonParserError(parser);
+    }
+    ptr = parser->pos + 1;
+    *str = ptr;
+    *escaped = 0;
+    while ((ptr = csonScanQuote(ptr, parser->end)) < parser->end && *ptr == '\\')
+    {
+        *escaped = 1;
+        ptr++;
+        if (ptr < parser->end)
         {
-            if (csonIsBasicListModel(model))
-            {
-                item = csonEncodeObject(&(p->obj), model, modelSize);
-            }
-            else
-            {
-                item = csonEncodeObject(p->obj, model, modelSize);
-            }
-            cJSON_AddItemToArray(root, item);
+            ptr++;
         }
-        p = p->next;
     }
-    return root;
+    *len = ptr - *str;
+    parser->pos = ptr < parser->end ? ptr + 1 : ptr;
+    return 0;
 }
 
 
 /**
- * @brief 数组编码成JSON对象
- * 
- * @param base 数组基址
- * @param elementType 数组元素类型
- * @param arraySize 数组大小
- * @return cJSON* 编码得到的JOSN对象
+ * @brief 解析4位十六进制数
+ *
+ * @param str 字符串
+ * @param end 输入结束位置
+ * @return unsigned 解析结果，非法时为0
  */
-cJSON* csonEncodeArray(void *base, CsonType elementType, short arraySize)
+static unsigned csonParseHex4(const char *str, const char *end)
 {
-    cJSON *root = cJSON_CreateArray();
-    cJSON *item;
+    unsigned h = 0;
 
-    for (short i = 0; i < arraySize; i++)
+    if (end - str < 4)
     {
-        switch (elementType)
+        return 0;
+    }
+    for (short i = 0; i < 4; i++)
+    {
+        h <<= 4;
+        if (str[i] >= '0' && str[i] <= '9')
+        {
+            h += str[i] - '0';
+        }
+        else if (str[i] >= 'A' && str[i] <= 'F')
+        {
+            h += 10 + str[i] - 'A';
+        }
+        else if (str[i] >= 'a' && str[i] <= 'f')
+        {
+            h += 10 + str[i] - 'a';
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    return h;
+}
+
+
+/**
+ * @brief 反转义一个转义序列
+ *
+ * @param src 指向反斜杠的指针，返回时指向转义序列之后
+ * @param end 字符串内容结束位置
+ * @param out 输出，至少4字节
+ * @return int 输出字节数
+ * @note 转义规则与cJSON的parse_string一致
+ */
+static int csonUnescapeChar(const char **src, const char *end, char *out)
+{
+    static const unsigned char firstByteMark[5] = {0x00, 0x00, 0xC0, 0xE0, 0xF0};
+    const char *ptr = *src + 1;
+    unsigned uc, uc2;
+    int len = 0;
+
+    if (ptr >= end)
+    {
+        *src = ptr;
+        return 0;
+    }
+    switch (*ptr)
+    {
+    case 'b': out[len++] = '\b'; break;
+    case 'f': out[len++] = '\f'; break;
+    case 'n': out[len++] = '\n'; break;
+    case 'r': out[len++] = '\r'; break;
+    case 't': out[len++] = '\t'; break;
+    case 'u':
+        uc = csonParseHex4(ptr + 1, end);
+        ptr += 4;
+        if ((uc >= 0xDC00 && uc <= 0xDFFF) || uc == 0)
         {
-        case CSON_TYPE_CHAR:
-            item = cJSON_CreateNumber(*(char *)((int)base + (i * sizeof(char))));
             break;
-        case CSON_TYPE_SHORT:
-            item = cJSON_CreateNumber(*(short *)((int)base + (i * sizeof(short))));
+        }
+        if (uc >= 0xD800 && uc <= 0xDBFF)
+        {
+            if (end - ptr < 3 || ptr[1] != '\\' || ptr[2] != 'u')
+            {
+                break;
+            }
+            uc2 = csonParseHex4(ptr + 3, end);
+            ptr += 6;
+            if (uc2 < 0xDC00 || uc2 > 0xDFFF)
+            {
+                break;
+            }
+            uc = 0x10000 + (((uc & 0x3FF) << 10) | (uc2 & 0x3FF));
+        }
+        len = 4;
+        if (uc < 0x80)
+        {
+            len = 1;
+        }
+        else if (uc < 0x800)
+        {
+            len = 2;
+        }
+        else if (uc < 0x10000)
+        {
+            len = 3;
+        }
+        for (short i = len - 1; i > 0; i--)
+        {
+            out[i] = (char)((uc | 0x80) & 0xBF);
+            uc >>= 6;
+        }
+        out[0] = (char)(uc | firstByteMark[len]);
+        break;
+    default:
+        out[len++] = *ptr;
+        break;
+    }
+    *src = ptr + 1 < end ? ptr + 1 : end;
+    return len;
+}
+
+
+/**
+ * @brief 反转义字符串
+ *
+ * @param src 字符串原始内容
+ * @param len 原始内容长度
+ * @param dest 输出缓冲，长度不小于原始内容长度
+ * @return int 反转义后的长度
+ */
+static int csonUnescape(const char *src, int len, char *dest)
+{
+    const char *end = src + len;
+    const char *run;
+    char *out = dest;
+
+    while (src < end)
+    {
+        if (*src != '\\')
+        {
+            run = csonScanQuote(src, end);
+            memcpy(out, src, run - src);
+            out += run - src;
+            src = run;
+        }
+        else
+        {
+            out += csonUnescapeChar(&src, end, out);
+        }
+    }
+    return out - dest;
+}
+
+
+/**
+ * @brief 比较键值
+ *
+ * @param str 键值原始内容
+ * @param len 原始内容长度
+ * @param escaped 是否包含转义
+ * @param key 模型键值
+ * @return int 是否相等
+ * @note 与cJSON_GetObjectItem一致，不区分大小写
+ */
+static int csonKeyEqual(const char *str, int len, int escaped, const char *key)
+{
+    const char *end = str + len;
+    char buffer[4];
+    int n;
+
+    while (str < end)
+    {
+        if (escaped && *str == '\\')
+        {
+            n = csonUnescapeChar(&str, end, buffer);
+            for (short i = 0; i < n; i++)
+            {
+                if (!*key || CSON_TO_LOWER((unsigned char)buffer[i]) != CSON_TO_LOWER((unsigned char)*key))
+                {
+                    return 0;
+                }
+                key++;
+            }
+        }
+        else
+        {
+            if (!*key || CSON_TO_LOWER((unsigned char)*str) != CSON_TO_LOWER((unsigned char)*key))
+            {
+                return 0;
+            }
+            str++;
+            key++;
+        }
+    }
+    return *key == 0;
+}
+
+
+/**
+ * @brief 区分大小写比较键值
+ *
+ * @param str 键值原始内容
+ * @param len 原始内容长度
+ * @param escaped 是否包含转义
+ * @param key 模型键值
+ * @param keyLen 模型键值长度，未知时为-1
+ * @return int 是否相等
+ * @note 键值长度已知且不包含转义时先比较长度，再使用memcmp比较
+ */
+static int csonKeyEqualExact(const char *str, int len, int escaped, const char *key, int keyLen)
+{
+    const char *end = str + len;
+    char buffer[4];
+    int n;
+
+    if (!escaped && keyLen >= 0)
+    {
+        return len == keyLen && memcmp(str, key, len) == 0;
+    }
+    while (str < end)
+    {
+        if (escaped && *str == '\\')
+        {
+            n = csonUnescapeChar(&str, end, buffer);
+            for (short i = 0; i < n; i++)
+            {
+                if (!*key || buffer[i] != *key)
+                {
+                    return 0;
+                }
+                key++;
+            }
+        }
+        else
+        {
+            if (!*key || *str != *key)
+            {
+                return 0;
+            }
+            str++;
+            key++;
+        }
+    }
+    return *key == 0;
+}
+
+
+/**
+ * @brief 按解析选项比较键值
+ *
+ * @param ctx 解析上下文，可为NULL
+ * @param str 键值原始内容
+ * @param len 原始内容长度
+ * @param escaped 是否包含转义
+ * @param key 模型键值
+ * @param keyLen 模型键值长度，未知时为-1
+ * @return int 是否相等
+ */
+static int csonKeyMatch(CsonContext *ctx, const char *str, int len, int escaped,
+                        const char *key, int keyLen)
+{
+    if (ctx && (ctx->options & CSON_OPTION_CASE_SENSITIVE))
+    {
+        return csonKeyEqualExact(str, len, escaped, key, keyLen);
+    }
+    return csonKeyEqual(str, len, escaped, key);
+}
+
+
+/**
+ * @brief 为解析结果分配内存
+ *
+ * @param parser 解析器
+ * @param size 内存大小
+ * @return void* 分配的内存
+ */
+static void *csonParserMalloc(CsonParser *parser, size_t size)
+{
+    return parser->ctx && parser->ctx->arena
+        ? csonArenaAlloc(parser->ctx->arena, size) : csonCtxMalloc(parser->ctx, size);
+}
+
+
+/**
+ * @brief 解析字符串并复制
+ *
+ * @param parser 解析器
+ * @param str 解析出的字符串
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserNewString(CsonParser *parser, char **str)
+{
+    const char *src;
+    int len, escaped;
+    const char *start = parser->pos;
+
+    if (csonParserString(parser, &src, &len, &escaped) != 0)
+    {
+        return -1;
+    }
+    *str = csonParserMalloc(parser, len + 1);
+    if (!*str)
+    {
+        parser->pos = start;
+        return csonParserError(parser);
+    }
+    if (escaped)
+    {
+        len = csonUnescape(src, len, *str);
+    }
+    else
+    {
+        memcpy(*str, src, len);
+    }
+    (*str)[len] = 0;
+    return 0;
+}
+
+
+/**
+ * @brief 解析字符串视图
+ *
+ * @param parser 解析器
+ * @param view 字符串视图
+ * @return int 0 成功 -1 失败
+ * @note 不包含转义字符时直接指向输入，否则分配内存保存反转义结果，
+ *       设置了`ownViews`时总是分配内存
+ */
+static int csonParserStringView(CsonParser *parser, CsonStringView *view)
+{
+    const char *src;
+    char *str;
+    int len, escaped;
+    const char *start = parser->pos;
+
+    if (csonParserString(parser, &src, &len, &escaped) != 0)
+    {
+        return -1;
+    }
+    if (!escaped && !parser->ownViews)
+    {
+        view->str = src;
+        view->len = len;
+        return 0;
+    }
+    str = csonParserMalloc(parser, len + 1);
+    if (!str)
+    {
+        parser->pos = start;
+        return csonParserError(parser);
+    }
+    if (escaped)
+    {
+        len = csonUnescape(src, len, str);
+    }
+    else
+    {
+        memcpy(str, src, len);
+    }
+    str[len] = 0;
+    view->str = str;
+    view->len = len;
+    view->owned = 1;
+    return 0;
+}
+
+
+/**
+ * @brief 跳过数组
+ *
+ * @param parser 解析器
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserSkipArray(CsonParser *parser)
+{
+    parser->pos++;
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) == ']')
+    {
+        parser->pos++;
+        return 0;
+    }
+    while (1)
+    {
+        csonParserSkip(parser);
+        if (csonParserSkipValue(parser) != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) == ',')
+        {
+            parser->pos++;
+        }
+        else if (csonParserPeek(parser) == ']')
+        {
+            parser->pos++;
+            return 0;
+        }
+        else
+        {
+            return csonParserError(parser);
+        }
+    }
+}
+
+
+/**
+ * @brief 跳过对象
+ *
+ * @param parser 解析器
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserSkipObject(CsonParser *parser)
+{
+    const char *str;
+    int len, escaped;
+
+    parser->pos++;
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) == '}')
+    {
+        parser->pos++;
+        return 0;
+    }
+    while (1)
+    {
+        csonParserSkip(parser);
+        if (csonParserString(parser, &str, &len, &escaped) != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) != ':')
+        {
+            return csonParserError(parser);
+        }
+        parser->pos++;
+        csonParserSkip(parser);
+        if (csonParserSkipValue(parser) != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) == ',')
+        {
+            parser->pos++;
+        }
+        else if (csonParserPeek(parser) == '}')
+        {
+            parser->pos++;
+            return 0;
+        }
+        else
+        {
+            return csonParserError(parser);
+        }
+    }
+}
+
+
+/**
+ * @brief 跳过一个JSON值
+ *
+ * @param parser 解析器
+ * @return int 0 成功 -1 失败
+ * @note 仅校验语法，不分配内存
+ */
+static int csonParserSkipValue(CsonParser *parser)
+{
+    const char *str;
+    int len, escaped;
+
+    if (csonParserLiteral(parser, "null", 4)
+        || csonParserLiteral(parser, "false", 5)
+        || csonParserLiteral(parser, "true", 4))
+    {
+        return 0;
+    }
+    switch (csonParserPeek(parser))
+    {
+    case '\"':
+        return csonParserString(parser, &str, &len, &escaped);
+    case '[':
+        return csonParserSkipArray(parser);
+    case '{':
+        return csonParserSkipObject(parser);
+    default:
+        if (csonParserIsNumber(parser))
+        {
+            parser->pos = csonNumberSkip(parser->pos, parser->end);
+            return 0;
+        }
+        return csonParserError(parser);
+    }
+}
+
+
+/**
+ * @brief 跳过对象成员的键值和冒号
+ *
+ * @param parser 解析器
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserSkipKey(CsonParser *parser)
+{
+    const char *str;
+    int len, escaped;
+
+    if (csonParserString(parser, &str, &len, &escaped) != 0)
+    {
+        return -1;
+    }
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) != ':')
+    {
+        return csonParserError(parser);
+    }
+    parser->pos++;
+    csonParserSkip(parser);
+    return 0;
+}
+
+
+/**
+ * @brief 快速跳过一个JSON值
+ *
+ * @param parser 解析器
+ * @return int 0 成功 -1 失败
+ * @note 用于跳过数据模型中不存在的成员值，语法检查与`csonParserSkipValue`一致，
+ *       但不转换数字，也不递归，用位栈记录每一层是数组还是对象，
+ *       嵌套不超过`CSON_SKIP_DEPTH`层
+ */
+static int csonParserSkipFast(CsonParser *parser)
+{
+    const char *str;
+    int len, escaped;
+    unsigned char array[CSON_SKIP_DEPTH / 8];
+    int depth = 0;
+    int isArray;
+    char c;
+
+    while (1)
+    {
+        c = csonParserPeek(parser);
+        if (c == '[' || c == '{')
+        {
+            if (depth == CSON_SKIP_DEPTH)
+            {
+                return csonParserError(parser);
+            }
+            parser->pos++;
+            csonParserSkip(parser);
+            if (c == '[')
+            {
+                array[depth >> 3] |= 1 << (depth & 7);
+            }
+            else
+            {
+                array[depth >> 3] &= ~(1 << (depth & 7));
+            }
+            depth++;
+            if (csonParserPeek(parser) != (c == '[' ? ']' : '}'))
+            {
+                if (c == '{' && csonParserSkipKey(parser) != 0)
+                {
+                    return -1;
+                }
+                continue;
+            }
+            parser->pos++;
+            depth--;
+        }
+        else if (c == '\"')
+        {
+            if (csonParserString(parser, &str, &len, &escaped) != 0)
+            {
+                return -1;
+            }
+        }
+        else if (csonParserIsNumber(parser))
+        {
+            parser->pos = csonNumberSkip(parser->pos, parser->end);
+        }
+        else if (!csonParserLiteral(parser, "null", 4)
+                 && !csonParserLiteral(parser, "false", 5)
+                 && !csonParserLiteral(parser, "true", 4))
+        {
+            return csonParserError(parser);
+        }
+
+        /* 当前值结束，处理分隔符以及所在数组和对象的结束 */
+        while (depth > 0)
+        {
+            isArray = (array[(depth - 1) >> 3] >> ((depth - 1) & 7)) & 1;
+            csonParserSkip(parser);
+            c = csonParserPeek(parser);
+            if (c == ',')
+            {
+                parser->pos++;
+                csonParserSkip(parser);
+                if (!isArray && csonParserSkipKey(parser) != 0)
+                {
+                    return -1;
+                }
+                break;
+            }
+            if (c != (isArray ? ']' : '}'))
+            {
+                return csonParserError(parser);
+            }
+            parser->pos++;
+            depth--;
+        }
+        if (depth == 0)
+        {
+            return 0;
+        }
+    }
+}
+
+
+/**
+ * @brief 将缓冲中的内容交给输出函数
+ *
+ * @param buffer 缓冲
+ * @return int 0 成功 -1 失败
+ * @note 输出失败后缓冲被置为NULL，之后的写入都会失败
+ */
+static int csonBufferFlush(CsonBuffer *buffer)
+{
+    if (buffer->offset > 0 && buffer->write(buffer->param, buffer->buffer, buffer->offset) != 0)
+    {
+        buffer->buffer = NULL;
+        return -1;
+    }
+    buffer->offset = 0;
+    return 0;
+}
+
+
+/**
+ * @brief 确保缓冲区空间
+ *
+ * @param buffer 缓冲
+ * @param needed 需要的空间
+ * @return char* 写入位置，失败返回NULL
+ * @note 固定大小缓冲空间不足时返回NULL，由调用者只增加写入长度，
+ *       使用输出函数的缓冲先输出已有内容，单次写入超过缓冲大小时返回NULL
+ */
+static char *csonBufferEnsure(CsonBuffer *buffer, int needed)
+{
+    char *newBuffer;
+    int newSize;
+
+    if (!buffer->buffer)
+    {
+        return NULL;
+    }
+    needed += buffer->offset + 1;
+    if (needed <= buffer->length)
+    {
+        return buffer->buffer + buffer->offset;
+    }
+    if (buffer->fixed)
+    {
+        return NULL;
+    }
+    if (buffer->write)
+    {
+        needed -= buffer->offset;
+        if (csonBufferFlush(buffer) != 0 || needed > buffer->length)
+        {
+            return NULL;
+        }
+        return buffer->buffer;
+    }
+    newSize = buffer->length > 0 ? buffer->length : 64;
+    while (newSize < needed)
+    {
+        newSize <<= 1;
+    }
+    newBuffer = csonCtxMalloc(buffer->ctx, newSize);
+    if (!newBuffer)
+    {
+        csonCtxFree(buffer->ctx, buffer->buffer);
+        buffer->buffer = NULL;
+        buffer->length = 0;
+        return NULL;
+    }
+    memcpy(newBuffer, buffer->buffer, buffer->offset);
+    csonCtxFree(buffer->ctx, buffer->buffer);
+    buffer->buffer = newBuffer;
+    buffer->length = newSize;
+    return newBuffer + buffer->offset;
+}
+
+
+/**
+ * @brief 处理缓冲区空间不足
+ *
+ * @param buffer 缓冲
+ * @param len 未能写入的长度
+ * @return int 0 固定大小缓冲，继续统计长度 -1 失败
+ */
+static int csonBufferOverflow(CsonBuffer *buffer, int len)
+{
+    if (!buffer->fixed)
+    {
+        return -1;
+    }
+    buffer->offset += len;
+    return 0;
+}
+
+
+/**
+ * @brief 写入缓冲
+ *
+ * @param buffer 缓冲
+ * @param data 数据
+ * @param len 数据长度
+ * @return int 0 成功 -1 失败
+ */
+static int csonBufferWrite(CsonBuffer *buffer, const char *data, int len)
+{
+    char *out = csonBufferEnsure(buffer, len);
+    if (!out && buffer->write && buffer->buffer)
+    {
+        if (buffer->write(buffer->param, data, len) != 0)
+        {
+            buffer->buffer = NULL;
+            return -1;
+        }
+        return 0;
+    }
+    if (!out)
+    {
+        return csonBufferOverflow(buffer, len);
+    }
+    memcpy(out, data, len);
+    buffer->offset += len;
+    out[len] = 0;
+    return 0;
+}
+
+
+/**
+ * @brief 写入重复字符
+ *
+ * @param buffer 缓冲
+ * @param c 字符
+ * @param count 数量
+ * @return int 0 成功 -1 失败
+ */
+static int csonBufferFill(CsonBuffer *buffer, char c, int count)
+{
+    char *out;
+    int n;
+
+    for (; count > 0; count -= n)
+    {
+        n = buffer->write && count >= buffer->length ? buffer->length - 1 : count;
+        out = csonBufferEnsure(buffer, n);
+        if (!out)
+        {
+            return csonBufferOverflow(buffer, count);
+        }
+        memset(out, c, n);
+        buffer->offset += n;
+        out[n] = 0;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 输出数字
+ *
+ * @param buffer 缓冲
+ * @param d 数字
+ * @return int 0 成功 -1 失败
+ * @note 输出格式与cJSON的print_number一致
+ */
+static int csonPrintNumber(CsonBuffer *buffer, double d)
+{
+    char str[CSON_NUMBER_BUFFER_SIZE];
+
+    return csonBufferWrite(buffer, str, csonNumberPrint(str, d));
+}
+
+
+/**
+ * @brief 输出单精度浮点数
+ *
+ * @param buffer 缓冲
+ * @param f 数字
+ * @return int 0 成功 -1 失败
+ */
+static int csonPrintFloat(CsonBuffer *buffer, float f)
+{
+    char str[CSON_NUMBER_BUFFER_SIZE];
+
+    return csonBufferWrite(buffer, str, csonNumberPrintFloat(str, f));
+}
+
+
+/**
+ * @brief 输出整数
+ *
+ * @param buffer 缓冲
+ * @param value 数字
+ * @return int 0 成功 -1 失败
+ * @note 直接按整数输出，不经过double转换
+ */
+static int csonPrintInteger(CsonBuffer *buffer, int64_t value)
+{
+    char str[CSON_NUMBER_BUFFER_SIZE];
+
+    return csonBufferWrite(buffer, str, csonNumberPrintInt(str, value));
+}
+
+
+/**
+ * @brief 输出转义后的字符串内容
+ *
+ * @param buffer 缓冲
+ * @param str 字符串
+ * @param len 字符串长度
+ * @return int 0 成功 -1 失败
+ * @note 转义规则与cJSON的print_string_ptr一致，
+ *       使用输出函数时超过缓冲大小的字符串分段输出，每个字节转义后最多6个字节
+ */
+static int csonPrintEscaped(CsonBuffer *buffer, const char *str, int len)
+{
+    int size = len;
+    int step;
+    char *out;
+    unsigned char c;
+
+    for (int i = 0; i < len; i++)
+    {
+        c = (unsigned char)str[i];
+        if (c == '\"' || c == '\\' || c == '\b' || c == '\f'
+            || c == '\n' || c == '\r' || c == '\t')
+        {
+            size += 1;
+        }
+        else if (c < 32)
+        {
+            size += 5;
+        }
+    }
+    if (buffer->write && size >= buffer->length)
+    {
+        step = (buffer->length - 1) / 6;
+        for (int i = 0; i < len; i += step)
+        {
+            if (csonPrintEscaped(buffer, str + i, len - i < step ? len - i : step) != 0)
+            {
+                return -1;
+            }
+        }
+        return 0;
+    }
+    out = csonBufferEnsure(buffer, size);
+    if (!out)
+    {
+        return csonBufferOverflow(buffer, size);
+    }
+    if (size == len)
+    {
+        memcpy(out, str, len);
+    }
+    else
+    {
+        for (int i = 0; i < len; i++)
+        {
+            c = (unsigned char)str[i];
+            if (c > 31 && c != '\"' && c != '\\')
+            {
+                *out++ = c;
+                continue;
+            }
+            *out++ = '\\';
+            switch (c)
+            {
+            case '\\': *out++ = '\\'; break;
+            case '\"': *out++ = '\"'; break;
+            case '\b': *out++ = 'b'; break;
+            case '\f': *out++ = 'f'; break;
+            case '\n': *out++ = 'n'; break;
+            case '\r': *out++ = 'r'; break;
+            case '\t': *out++ = 't'; break;
+            default: sprintf(out, "u%04x", c); out += 5; break;
+            }
+        }
+    }
+    buffer->offset += size;
+    buffer->buffer[buffer->offset] = 0;
+    return 0;
+}
+
+
+/**
+ * @brief 输出字符串
+ *
+ * @param buffer 缓冲
+ * @param str 字符串
+ * @param len 字符串长度
+ * @return int 0 成功 -1 失败
+ */
+static int csonPrintString(CsonBuffer *buffer, const char *str, int len)
+{
+    if (csonBufferWrite(buffer, "\"", 1) != 0
+        || csonPrintEscaped(buffer, str, len) != 0
+        || csonBufferWrite(buffer, "\"", 1) != 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 重新输出字符串原始内容
+ *
+ * @param buffer 缓冲
+ * @param str 字符串原始内容
+ * @param len 原始内容长度
+ * @param escaped 是否包含转义
+ * @return int 0 成功 -1 失败
+ * @note 等价于先反转义再按cJSON规则转义输出，不分配内存
+ */
+static int csonReprintString(CsonBuffer *buffer, const char *str, int len, int escaped)
+{
+    const char *end = str + len;
+    const char *run;
+    char tmp[4];
+
+    if (!escaped)
+    {
+        return csonPrintString(buffer, str, len);
+    }
+    if (csonBufferWrite(buffer, "\"", 1) != 0)
+    {
+        return -1;
+    }
+    while (str < end)
+    {
+        run = str;
+        str = csonScanQuote(str, end);
+        if (csonPrintEscaped(buffer, run, str - run) != 0)
+        {
+            return -1;
+        }
+        if (str < end
+            && csonPrintEscaped(buffer, tmp, csonUnescapeChar(&str, end, tmp)) != 0)
+        {
+            return -1;
+        }
+    }
+    return csonBufferWrite(buffer, "\"", 1);
+}
+
+
+/**
+ * @brief 重新输出数组
+ *
+ * @param parser 解析器
+ * @param buffer 缓冲
+ * @param depth 深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+static int csonReprintArray(CsonParser *parser, CsonBuffer *buffer, int depth, int fmt)
+{
+    parser->pos++;
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) == ']')
+    {
+        parser->pos++;
+        return csonBufferWrite(buffer, "[]", 2);
+    }
+    if (csonBufferWrite(buffer, "[", 1) != 0)
+    {
+        return -1;
+    }
+    while (1)
+    {
+        csonParserSkip(parser);
+        if (csonReprintValue(parser, buffer, depth + 1, fmt) != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) == ',')
+        {
+            parser->pos++;
+            if (csonBufferWrite(buffer, ", ", fmt ? 2 : 1) != 0)
+            {
+                return -1;
+            }
+        }
+        else if (csonParserPeek(parser) == ']')
+        {
+            parser->pos++;
+            return csonBufferWrite(buffer, "]", 1);
+        }
+        else
+        {
+            return csonParserError(parser);
+        }
+    }
+}
+
+
+/**
+ * @brief 重新输出对象
+ *
+ * @param parser 解析器
+ * @param buffer 缓冲
+ * @param depth 深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+static int csonReprintObject(CsonParser *parser, CsonBuffer *buffer, int depth, int fmt)
+{
+    const char *str;
+    int len, escaped;
+
+    parser->pos++;
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) == '}')
+    {
+        parser->pos++;
+        if (csonBufferWrite(buffer, "{\n", fmt ? 2 : 1) != 0
+            || (fmt && csonBufferFill(buffer, '\t', depth - 1) != 0))
+        {
+            return -1;
+        }
+        return csonBufferWrite(buffer, "}", 1);
+    }
+    if (csonBufferWrite(buffer, "{\n", fmt ? 2 : 1) != 0)
+    {
+        return -1;
+    }
+    while (1)
+    {
+        csonParserSkip(parser);
+        if (csonParserString(parser, &str, &len, &escaped) != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) != ':')
+        {
+            return csonParserError(parser);
+        }
+        parser->pos++;
+        csonParserSkip(parser);
+        if ((fmt && csonBufferFill(buffer, '\t', depth + 1) != 0)
+            || csonReprintString(buffer, str, len, escaped) != 0
+            || csonBufferWrite(buffer, ":\t", fmt ? 2 : 1) != 0
+            || csonReprintValue(parser, buffer, depth + 1, fmt) != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) == ',')
+        {
+            parser->pos++;
+            if (csonBufferWrite(buffer, ",\n", fmt ? 2 : 1) != 0)
+            {
+                return -1;
+            }
+        }
+        else if (csonParserPeek(parser) == '}')
+        {
+            parser->pos++;
+            if ((fmt && csonBufferWrite(buffer, "\n", 1) != 0)
+                || (fmt && csonBufferFill(buffer, '\t', depth) != 0))
+            {
+                return -1;
+            }
+            return csonBufferWrite(buffer, "}", 1);
+        }
+        else
+        {
+            return csonParserError(parser);
+        }
+    }
+}
+
+
+/**
+ * @brief 解析并按cJSON的输出规则重新输出一个JSON值
+ *
+ * @param parser 解析器
+ * @param buffer 缓冲
+ * @param depth 深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+static int csonReprintValue(CsonParser *parser, CsonBuffer *buffer, int depth, int fmt)
+{
+    const char *str;
+    int len, escaped;
+    CsonNumber number;
+
+    if (csonParserLiteral(parser, "null", 4))
+    {
+        return csonBufferWrite(buffer, "null", 4);
+    }
+    if (csonParserLiteral(parser, "false", 5))
+    {
+        return csonBufferWrite(buffer, "false", 5);
+    }
+    if (csonParserLiteral(parser, "true", 4))
+    {
+        return csonBufferWrite(buffer, "true", 4);
+    }
+    switch (csonParserPeek(parser))
+    {
+    case '\"':
+        if (csonParserString(parser, &str, &len, &escaped) != 0)
+        {
+            return -1;
+        }
+        return csonReprintString(buffer, str, len, escaped);
+    case '[':
+        return csonReprintArray(parser, buffer, depth, fmt);
+    case '{':
+        return csonReprintObject(parser, buffer, depth, fmt);
+    default:
+        if (csonParserIsNumber(parser))
+        {
+            csonParserNumber(parser, &number);
+            return number.isInteger ? csonPrintInteger(buffer, number.integer)
+                                    : csonPrintNumber(buffer, number.value);
+        }
+        return csonParserError(parser);
+    }
+}
+
+
+/**
+ * @brief 将输出缓冲作为解析结果
+ *
+ * @param parser 解析器
+ * @param buffer 输出缓冲
+ * @param json 解析结果
+ * @return int 0 成功 -1 失败
+ * @note 使用内存池时复制到内存池中并释放缓冲
+ */
+static int csonParserTakeBuffer(CsonParser *parser, CsonBuffer *buffer, char **json)
+{
+    if (parser->ctx && parser->ctx->arena)
+    {
+        *json = csonArenaAlloc(parser->ctx->arena, buffer->offset + 1);
+        if (*json)
+        {
+            memcpy(*json, buffer->buffer, buffer->offset + 1);
+        }
+        csonCtxFree(buffer->ctx, buffer->buffer);
+        return *json ? 0 : csonParserError(parser);
+    }
+    *json = buffer->buffer;
+    return 0;
+}
+
+
+/**
+ * @brief 复制json文本并去除字符串外的空白字符
+ *
+ * @param src json文本
+ * @param len 文本长度
+ * @param dest 输出，空间不小于`len`
+ * @return int 输出长度
+ */
+static int csonMinify(const char *src, int len, char *dest)
+{
+    char *out = dest;
+    int string = 0;
+
+    for (int i = 0; i < len; i++)
+    {
+        if (string)
+        {
+            if (src[i] == '\\' && i + 1 < len)
+            {
+                *out++ = src[i++];
+            }
+            else if (src[i] == '\"')
+            {
+                string = 0;
+            }
+        }
+        else if (src[i] == ' ' || src[i] == '\t' || src[i] == '\n' || src[i] == '\r')
+        {
+            continue;
+        }
+        else if (src[i] == '\"')
+        {
+            string = 1;
+        }
+        *out++ = src[i];
+    }
+    return out - dest;
+}
+
+
+/**
+ * @brief 复制子json的原始文本
+ *
+ * @param parser 解析器
+ * @param json 复制的json字符串
+ * @return int 0 成功 -1 失败
+ * @note 只跳过一次值，不重新输出，设置了`CSON_OPTION_MINIFY_JSON`时去除空白字符
+ */
+static int csonParserRawJson(CsonParser *parser, char **json)
+{
+    const char *start = parser->pos;
+    int len;
+
+    if (csonParserSkipValue(parser) != 0)
+    {
+        return -1;
+    }
+    len = parser->pos - start;
+    *json = csonParserMalloc(parser, len + 1);
+    if (!*json)
+    {
+        parser->pos = start;
+        return csonParserError(parser);
+    }
+    if (parser->ctx->options & CSON_OPTION_MINIFY_JSON)
+    {
+        len = csonMinify(start, len, *json);
+    }
+    else
+    {
+        memcpy(*json, start, len);
+    }
+    (*json)[len] = 0;
+    return 0;
+}
+
+
+/**
+ * @brief 解析子json
+ *
+ * @param parser 解析器
+ * @param json 解析出的json字符串
+ * @return int 0 成功 -1 失败
+ * @note 上下文设置了`CSON_OPTION_RAW_JSON`时直接复制原始文本
+ */
+static int csonParserJson(CsonParser *parser, char **json)
+{
+    CsonBuffer buffer = {0};
+
+    if (parser->ctx && (parser->ctx->options & CSON_OPTION_RAW_JSON))
+    {
+        return csonParserRawJson(parser, json);
+    }
+    buffer.ctx = parser->ctx;
+    buffer.buffer = csonCtxMalloc(buffer.ctx, 64);
+    if (!buffer.buffer)
+    {
+        return csonParserError(parser);
+    }
+    buffer.length = 64;
+    if (csonReprintValue(parser, &buffer, 0, 0) != 0)
+    {
+        if (buffer.buffer)
+        {
+            csonCtxFree(buffer.ctx, buffer.buffer);
+        }
+        return csonParserError(parser);
+    }
+    return csonParserTakeBuffer(parser, &buffer, json);
+}
+
+
+/**
+ * @brief 解析基本类型值
+ *
+ * @param parser 解析器
+ * @param ptr 写入地址
+ * @param type 数据类型
+ * @param element 是否为数组元素
+ * @return int 0 成功 -1 失败
+ * @note 与cJSON一致，数组元素中的true作为整型1解析
+ */
+static int csonParserBasic(CsonParser *parser, void *ptr, CsonType type, int element)
+{
+    CsonNumber number;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_SHORT:
+    case CSON_TYPE_INT:
+    case CSON_TYPE_LONG:
+    case CSON_TYPE_FLOAT:
+    case CSON_TYPE_DOUBLE:
+        if (csonParserIsNumber(parser))
+        {
+            csonParserNumber(parser, &number);
+            csonStoreNumber(ptr, type,
+                number.isInteger ? number.integer : csonNumberToInt64(number.value),
+                number.value);
+            return 0;
+        }
+        if (element && csonParserLiteral(parser, "true", 4))
+        {
+            csonStoreNumber(ptr, type, 1, 0);
+            return 0;
+        }
+        csonStoreNumber(ptr, type, 0, 0);
+        return csonParserSkipValue(parser);
+    case CSON_TYPE_BOOL:
+        if (csonParserLiteral(parser, "true", 4))
+        {
+            *(char *)ptr = 1;
+            return 0;
+        }
+        *(char *)ptr = 0;
+        return csonParserSkipValue(parser);
+    case CSON_TYPE_STRING:
+        *(char **)ptr = NULL;
+        if (csonParserPeek(parser) == '\"')
+        {
+            return csonParserNewString(parser, (char **)ptr);
+        }
+        return csonParserSkipValue(parser);
+    case CSON_TYPE_STRING_VIEW:
+        memset(ptr, 0, sizeof(CsonStringView));
+        if (csonParserPeek(parser) == '\"')
+        {
+            return csonParserStringView(parser, (CsonStringView *)ptr);
+        }
+        return csonParserSkipValue(parser);
+    default:
+        return csonParserSkipValue(parser);
+    }
+}
+
+
+/**
+ * @brief 解析CsonList
+ *
+ * @param parser 解析器
+ * @param model CsonList成员数据模型
+ * @param modelSize CsonList成员模型数量
+ * @param compiled CsonList成员预编译模型, 可为NULL
+ * @param list 链表
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserList(CsonParser *parser, CsonModel *model, int modelSize,
+                          CsonCompiledModel *compiled, CsonList **list)
+{
+    CsonList **tail = list;
+    CsonList *node;
+    union {
+        char c;
+        short s;
+        int i;
+        long l;
+        float f;
+        double d;
+        void *p;
+    } value;
+    int basic = csonIsBasicListModel(model);
+    int objSize = compiled ? compiled->objSize : csonModelObjSize(model, modelSize);
+
+    parser->pos++;
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) == ']')
+    {
+        parser->pos++;
+        return 0;
+    }
+    while (1)
+    {
+        csonParserSkip(parser);
+        node = csonListNew(parser->ctx);
+        if (!node)
+        {
+            return csonParserError(parser);
+        }
+        node->next = NULL;
+        node->obj = NULL;
+        *tail = node;
+        tail = &node->next;
+        if (basic)
+        {
+            memset(&value, 0, sizeof(value));
+            if (csonParserBasic(parser, &value, model[1].type, 0) != 0)
+            {
+                return -1;
+            }
+            memcpy(&node->obj, &value,
+                objSize < (int)sizeof(void *) ? objSize : (int)sizeof(void *));
+        }
+        else if (csonParserObject(parser, model, modelSize, compiled, &node->obj) != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) == ',')
+        {
+            parser->pos++;
+        }
+        else if (csonParserPeek(parser) == ']')
+        {
+            parser->pos++;
+            return 0;
+        }
+        else
+        {
+            return csonParserError(parser);
+        }
+    }
+}
+
+
+/**
+ * @brief 统计json数组元素或对象成员数量
+ *
+ * @param parser 解析器，位于'['或'{'，统计后位置不变
+ * @param count 元素或成员数量
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserCount(CsonParser *parser, size_t *count)
+{
+    CsonParser scan = *parser;
+    char close = csonParserPeek(parser) == '{' ? '}' : ']';
+    const char *str;
+    int len, escaped;
+
+    *count = 0;
+    scan.pos++;
+    csonParserSkip(&scan);
+    if (csonParserPeek(&scan) == close)
+    {
+        return 0;
+    }
+    while (1)
+    {
+        csonParserSkip(&scan);
+        if (close == '}')
+        {
+            if (csonParserString(&scan, &str, &len, &escaped) != 0)
+            {
+                break;
+            }
+            csonParserSkip(&scan);
+            if (csonParserPeek(&scan) != ':')
+            {
+                csonParserError(&scan);
+                break;
+            }
+            scan.pos++;
+            csonParserSkip(&scan);
+        }
+        if (csonParserSkipFast(&scan) != 0)
+        {
+            break;
+        }
+        (*count)++;
+        csonParserSkip(&scan);
+        if (csonParserPeek(&scan) == ',')
+        {
+            scan.pos++;
+        }
+        else if (csonParserPeek(&scan) == close)
+        {
+            return 0;
+        }
+        else
+        {
+            csonParserError(&scan);
+            break;
+        }
+    }
+    parser->err = scan.err;
+    return -1;
+}
+
+
+/**
+ * @brief 解析CsonVector
+ *
+ * @param parser 解析器
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ * @param compiled 元素预编译模型, 可为NULL
+ * @param vector CsonVector
+ * @return int 0 成功 -1 失败
+ * @note 先扫描一次得到元素数量，所有元素一次分配，
+ *       元素的解析规则与CsonList一致，null元素保持为0
+ */
+static int csonParserVector(CsonParser *parser, CsonModel *model, int modelSize,
+                            CsonCompiledModel *compiled, CsonVector *vector)
+{
+    int basic = csonIsBasicListModel(model);
+    int objSize = compiled ? compiled->objSize : csonModelObjSize(model, modelSize);
+    size_t count;
+    char *data;
+    int ret;
+
+    if (csonParserCount(parser, &count) != 0)
+    {
+        return -1;
+    }
+    parser->pos++;
+    if (count == 0)
+    {
+        csonParserSkip(parser);
+        parser->pos++;
+        return 0;
+    }
+    if (objSize > 0 && count > SIZE_MAX / objSize)
+    {
+        return csonParserError(parser);
+    }
+    data = csonParserMalloc(parser, count * objSize);
+    if (!data)
+    {
+        return csonParserError(parser);
+    }
+    memset(data, 0, count * objSize);
+    vector->data = data;
+    vector->len = count;
+    vector->cap = count;
+    for (size_t i = 0; i < count; i++, data += objSize)
+    {
+        csonParserSkip(parser);
+        if (basic)
+        {
+            ret = csonParserBasic(parser, data, model[1].type, 0);
+        }
+        else if (csonParserLiteral(parser, "null", 4))
+        {
+            ret = 0;
+        }
+        else
+        {
+            ret = csonParserFields(parser, data, model, modelSize, compiled);
+        }
+        if (ret != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) != (i + 1 < count ? ',' : ']'))
+        {
+            return csonParserError(parser);
+        }
+        parser->pos++;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 解析数组
+ *
+ * @param parser 解析器
+ * @param base 数组基址
+ * @param elementType 数组元素类型
+ * @param arraySize 数组大小
+ * @param count 写入的元素数量
+ * @return int 0 成功 -1 失败
+ * @note 超出数组大小的元素会被忽略
+ */
+static int csonParserArray(CsonParser *parser, void *base, CsonType elementType, short arraySize,
+                           short *count)
+{
+    int size = csonTypeSize(elementType);
+    int ret;
+
+    *count = 0;
+    parser->pos++;
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) == ']')
+    {
+        parser->pos++;
+        return 0;
+    }
+    for (size_t i = 0; ; i++)
+    {
+        csonParserSkip(parser);
+        if (i < (size_t)arraySize && size > 0)
+        {
+            ret = csonParserBasic(parser, (char *)base + i * size, elementType, 1);
+            *count = i + 1;
+        }
+        else
+        {
+            ret = csonParserSkipFast(parser);
+        }
+        if (ret != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) == ',')
+        {
+            parser->pos++;
+        }
+        else if (csonParserPeek(parser) == ']')
+        {
+            parser->pos++;
+            return 0;
+        }
+        else
+        {
+            return csonParserError(parser);
+        }
+    }
+}
+
+
+/**
+ * @brief 解析对象成员
+ *
+ * @param parser 解析器
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @param sub 子结构体预编译模型, 可为NULL
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserField(CsonParser *parser, void *obj, CsonModel *field, CsonCompiledModel *sub)
+{
+    void *ptr = (char *)obj + field->offset;
+    short count;
+    int ret;
+
+    switch (field->type)
+    {
+    case CSON_TYPE_LIST:
+        *(CsonList **)ptr = NULL;
+        if (csonParserPeek(parser) == '[')
+        {
+            return csonParserList(parser, field->param.sub.model,
+                field->param.sub.size, sub, (CsonList **)ptr);
+        }
+        return csonParserSkipValue(parser);
+    case CSON_TYPE_VECTOR:
+        memset(ptr, 0, sizeof(CsonVector));
+        if (csonParserPeek(parser) == '[')
+        {
+            return csonParserVector(parser, field->param.sub.model,
+                field->param.sub.size, sub, (CsonVector *)ptr);
+        }
+        return csonParserSkipValue(parser);
+    case CSON_TYPE_STRUCT:
+        return csonParserObject(parser, field->param.sub.model,
+            field->param.sub.size, sub, (void **)ptr);
+    case CSON_TYPE_ARRAY:
+        count = 0;
+        ret = csonParserPeek(parser) == '['
+            ? csonParserArray(parser, ptr, field->param.array.eleType, field->param.array.size, &count)
+            : csonParserSkipValue(parser);
+        csonSetArrayCount(obj, field, count);
+        return ret;
+    case CSON_TYPE_JSON:
+        return csonParserJson(parser, (char **)ptr);
+    default:
+        return csonParserBasic(parser, ptr, field->type, 0);
+    }
+}
+
+
+/**
+ * @brief 计算键值哈希
+ *
+ * @param str 键值原始内容
+ * @param len 原始内容长度
+ * @param escaped 是否包含转义
+ * @param keyLen 反转义后的键值长度
+ * @return unsigned int 哈希值
+ * @note 哈希不区分大小写
+ */
+static unsigned int csonKeyHash(const char *str, int len, int escaped, int *keyLen)
+{
+    const char *end = str + len;
+    unsigned int hash = 2166136261u;
+    char buffer[4];
+    int n;
+
+    *keyLen = 0;
+    while (str < end)
+    {
+        if (escaped && *str == '\\')
+        {
+            n = csonUnescapeChar(&str, end, buffer);
+            for (short i = 0; i < n; i++)
+            {
+                hash = (hash ^ CSON_TO_LOWER((unsigned char)buffer[i])) * 16777619u;
+            }
+            *keyLen += n;
+        }
+        else
+        {
+            hash = (hash ^ CSON_TO_LOWER((unsigned char)*str)) * 16777619u;
+            str++;
+            (*keyLen)++;
+        }
+    }
+    return hash;
+}
+
+
+/**
+ * @brief 在预编译模型中查找成员
+ *
+ * @param compiled 预编译模型
+ * @param ctx 解析上下文，可为NULL
+ * @param str 键值原始内容
+ * @param len 原始内容长度
+ * @param escaped 是否包含转义
+ * @return int 第一个匹配成员的索引, -1表示没有
+ * @note 区分大小写时，在不区分大小写的同名成员链中查找第一个完全匹配的成员，
+ *       链中后续的成员需要调用者使用`csonCompiledMatch`逐个判断
+ */
+static int csonCompiledFind(CsonCompiledModel *compiled, CsonContext *ctx,
+                            const char *str, int len, int escaped)
+{
+    CsonCompiledField *field;
+    int keyLen;
+    unsigned int hash = csonKeyHash(str, len, escaped, &keyLen);
+    unsigned int pos = hash & compiled->tableMask;
+
+    while (compiled->table[pos] >= 0)
+    {
+        field = &compiled->fields[compiled->table[pos]];
+        if (field->hash == hash && field->keyLen == keyLen)
+        {
+            if (!ctx || !(ctx->options & CSON_OPTION_CASE_SENSITIVE))
+            {
+                if (csonKeyEqual(str, len, escaped, field->model->key))
+                {
+                    return compiled->table[pos];
+                }
+            }
+            else
+            {
+                for (int i = compiled->table[pos]; i >= 0; i = compiled->fields[i].next)
+                {
+                    if (csonKeyEqualExact(str, len, escaped, compiled->fields[i].model->key, keyLen))
+                    {
+                        return i;
+                    }
+                }
+            }
+        }
+        pos = (pos + 1) & compiled->tableMask;
+    }
+    return -1;
+}
+
+
+/**
+ * @brief 判断同名成员链中的成员是否匹配键值
+ *
+ * @param field 预编译成员，由`csonCompiledFind`查找到的成员或者其后续同名成员
+ * @param ctx 解析上下文，可为NULL
+ * @param str 键值原始内容
+ * @param len 原始内容长度
+ * @param escaped 是否包含转义
+ * @return int 是否匹配
+ * @note 不区分大小写时链中的成员都匹配
+ */
+static int csonCompiledMatch(CsonCompiledField *field, CsonContext *ctx,
+                             const char *str, int len, int escaped)
+{
+    return !ctx || !(ctx->options & CSON_OPTION_CASE_SENSITIVE)
+        || csonKeyEqualExact(str, len, escaped, field->model->key, field->keyLen);
+}
+
+
+/**
+ * @brief 就地更新字符串
+ *
+ * @param parser 解析器
+ * @param str 字符串
+ * @return int 0 成功 -1 失败
+ * @note 原字符串空间足够时直接写入原字符串
+ */
+static int csonUpdateString(CsonParser *parser, char **str)
+{
+    const char *start = parser->pos;
+    const char *src;
+    int len, escaped;
+
+    if (*str && csonParserPeek(parser) == '\"')
+    {
+        if (csonParserString(parser, &src, &len, &escaped) != 0)
+        {
+            return -1;
+        }
+        if ((size_t)len <= strlen(*str))
+        {
+            len = escaped ? csonUnescape(src, len, *str) : (memcpy(*str, src, len), len);
+            (*str)[len] = 0;
+            return 0;
+        }
+        parser->pos = start;
+    }
+    if (*str)
+    {
+        csonCtxFree(parser->ctx, *str);
+    }
+    return csonParserBasic(parser, str, CSON_TYPE_STRING, 0);
+}
+
+
+/**
+ * @brief 就地更新CsonList
+ *
+ * @param parser 解析器，位于'['
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ * @param list 链表
+ * @return int 0 成功 -1 失败
+ * @note 按顺序复用已有的节点和元素对象，多出的节点被释放
+ */
+static int csonUpdateList(CsonParser *parser, CsonModel *model, int modelSize, CsonList **list)
+{
+    CsonList *node;
+    union
+    {
+        char c;
+        short s;
+        int i;
+        long l;
+        float f;
+        double d;
+        void *p;
+    } value;
+    int basic = csonIsBasicListModel(model);
+    int objSize = csonModelObjSize(model, modelSize);
+    int ret;
+
+    parser->pos++;
+    csonParserSkip(parser);
+    while (csonParserPeek(parser) != ']')
+    {
+        csonParserSkip(parser);
+        node = *list;
+        if (!node)
+        {
+            node = csonListNew(parser->ctx);
+            if (!node)
+            {
+                return csonParserError(parser);
+            }
+            node->next = NULL;
+            node->obj = NULL;
+            *list = node;
+        }
+        list = &node->next;
+        if (basic && model[1].type == CSON_TYPE_STRING)
+        {
+            ret = csonUpdateString(parser, (char **)&node->obj);
+        }
+        else if (basic)
+        {
+            memset(&value, 0, sizeof(value));
+            ret = csonParserBasic(parser, &value, model[1].type, 0);
+            node->obj = NULL;
+            memcpy(&node->obj, &value,
+                objSize < (int)sizeof(void *) ? objSize : (int)sizeof(void *));
+        }
+        else if (node->obj && csonParserPeek(parser) != 'n')
+        {
+            csonFreeFields(parser->ctx, node->obj, model, modelSize);
+            memset(node->obj, 0, objSize);
+            ret = csonParserFields(parser, node->obj, model, modelSize, NULL);
+        }
+        else
+        {
+            csonFreeObject(parser->ctx, node->obj, model, modelSize);
+            ret = csonParserObject(parser, model, modelSize, NULL, &node->obj);
+        }
+        if (ret != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) == ',')
+        {
+            parser->pos++;
+            csonParserSkip(parser);
+            if (csonParserPeek(parser) == ']')
+            {
+                return csonParserError(parser);
+            }
+        }
+        else if (csonParserPeek(parser) != ']')
+        {
+            return csonParserError(parser);
+        }
+    }
+    parser->pos++;
+    csonFreeList(parser->ctx, *list, model, modelSize);
+    *list = NULL;
+    return 0;
+}
+
+
+/**
+ * @brief 就地更新CsonVector
+ *
+ * @param parser 解析器，位于'['
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ * @param vector CsonVector
+ * @return int 0 成功 -1 失败
+ * @note 元素数量不超过已有容量时复用原有空间，字符串元素复用原字符串
+ */
+static int csonUpdateVector(CsonParser *parser, CsonModel *model, int modelSize,
+                            CsonVector *vector)
+{
+    int basic = csonIsBasicListModel(model);
+    int objSize = csonModelObjSize(model, modelSize);
+    size_t count;
+    char *data;
+    int ret;
+
+    if (csonParserCount(parser, &count) != 0)
+    {
+        return -1;
+    }
+    if (!vector->data || count > vector->cap)
+    {
+        csonFreeVector(parser->ctx, vector, model, modelSize);
+        memset(vector, 0, sizeof(CsonVector));
+        return csonParserVector(parser, model, modelSize, NULL, vector);
+    }
+    if (count < vector->len)
+    {
+        csonFreeElements(parser->ctx, (char *)vector->data + count * objSize,
+            vector->len - count, model, modelSize);
+    }
+    parser->pos++;
+    data = vector->data;
+    for (size_t i = 0; i < count; i++, data += objSize)
+    {
+        csonParserSkip(parser);
+        if (i >= vector->len)
+        {
+            memset(data, 0, objSize);
+        }
+        if (basic && model[1].type == CSON_TYPE_STRING)
+        {
+            ret = csonUpdateString(parser, (char **)data);
+        }
+        else if (basic)
+        {
+            ret = csonParserBasic(parser, data, model[1].type, 0);
+        }
+        else
+        {
+            if (i < vector->len)
+            {
+                csonFreeFields(parser->ctx, data, model, modelSize);
+                memset(data, 0, objSize);
+            }
+            ret = csonParserLiteral(parser, "null", 4)
+                ? 0 : csonParserFields(parser, data, model, modelSize, NULL);
+        }
+        if (ret != 0)
+        {
+            return -1;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) != (i + 1 < count ? ',' : ']'))
+        {
+            return csonParserError(parser);
+        }
+        parser->pos++;
+    }
+    if (count == 0)
+    {
+        csonParserSkip(parser);
+        parser->pos++;
+    }
+    vector->len = count;
+    return 0;
+}
+
+
+/**
+ * @brief 就地更新对象成员
+ *
+ * @param parser 解析器
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @return int 0 成功 -1 失败
+ * @note 已存在的子结构体只更新json中存在的成员，字符串、链表和vector尽量复用原有空间，
+ *       其他成员释放后重新解析
+ */
+static int csonUpdateField(CsonParser *parser, void *obj, CsonModel *field)
+{
+    void *ptr = (char *)obj + field->offset;
+
+    if ((parser->updateFlags & CSON_UPDATE_IGNORE_NULL) && csonParserLiteral(parser, "null", 4))
+    {
+        return 0;
+    }
+    switch (field->type)
+    {
+    case CSON_TYPE_STRING:
+        return csonUpdateString(parser, (char **)ptr);
+    case CSON_TYPE_STRUCT:
+        if (*(void **)ptr && csonParserPeek(parser) == '{'
+            && !(parser->updateFlags & CSON_UPDATE_REPLACE_STRUCT))
+        {
+            return csonParserMembers(parser, *(void **)ptr,
+                field->param.sub.model, field->param.sub.size, NULL);
+        }
+        break;
+    case CSON_TYPE_LIST:
+        if (csonParserPeek(parser) == '[')
+        {
+            return csonUpdateList(parser, field->param.sub.model, field->param.sub.size,
+                (CsonList **)ptr);
+        }
+        break;
+    case CSON_TYPE_VECTOR:
+        if (csonParserPeek(parser) == '[')
+        {
+            return csonUpdateVector(parser, field->param.sub.model, field->param.sub.size,
+                (CsonVector *)ptr);
+        }
+        break;
+    case CSON_TYPE_STRING_VIEW:
+    case CSON_TYPE_JSON:
+    case CSON_TYPE_ARRAY:
+        break;
+    default:
+        return csonParserField(parser, obj, field, NULL);
+    }
+    csonFreeFields(parser->ctx, obj, field, 1);
+    if (field->type == CSON_TYPE_ARRAY)
+    {
+        memset(ptr, 0, csonTypeSize(field->param.array.eleType) * field->param.array.size);
+    }
+    else if (field->type == CSON_TYPE_JSON)
+    {
+        *(char **)ptr = NULL;
+    }
+    return csonParserField(parser, obj, field, NULL);
+}
+
+
+/**
+ * @brief 解析一个对象成员的值
+ *
+ * @param parser 解析器
+ * @param obj 对象
+ * @param value 值的起始位置
+ * @param field 成员数据模型
+ * @param sub 子结构体预编译模型
+ * @param index 成员索引
+ * @param seen 成员解析标记
+ * @param matched 是否已有成员解析了该值
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserMemberValue(CsonParser *parser, void *obj, const char *value,
+                                 CsonModel *field, CsonCompiledModel *sub,
+                                 int index, unsigned char *seen, int *matched)
+{
+    if (seen[index >> 3] & (1 << (index & 7)))
+    {
+        return 0;
+    }
+    parser->pos = value;
+    if ((parser->update ? csonUpdateField(parser, obj, field)
+        : csonParserField(parser, obj, field, sub)) != 0)
+    {
+        return -1;
+    }
+    seen[index >> 3] |= 1 << (index & 7);
+    *matched = 1;
+    return 0;
+}
+
+
+/**
+ * @brief 解析对象的所有成员
+ *
+ * @param parser 解析器
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param compiled 预编译模型, 可为NULL
+ * @return int 0 成功 -1 失败
+ * @note 与cJSON_GetObjectItem一致，同名键值只取第一个
+ */
+static int csonParserMembers(CsonParser *parser, void *obj, CsonModel *model, int modelSize,
+                             CsonCompiledModel *compiled)
+{
+    unsigned char seenBuffer[CSON_SEEN_BUFFER_SIZE];
+    unsigned char *seen = seenBuffer;
+    CsonCompiledField *field;
+    const char *str;
+    const char *value;
+    int len, escaped, matched;
+    int ret = -1;
+
+    if (modelSize > CSON_SEEN_BUFFER_SIZE * 8)
+    {
+        seen = csonCtxMalloc(parser->ctx, (modelSize + 7) / 8);
+        if (!seen)
+        {
+            return csonParserError(parser);
+        }
+    }
+    memset(seen, 0, (modelSize + 7) / 8);
+
+    parser->pos++;
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) == '}')
+    {
+        parser->pos++;
+        ret = 0;
+        goto exit;
+    }
+    while (1)
+    {
+        csonParserSkip(parser);
+        if (csonParserString(parser, &str, &len, &escaped) != 0)
+        {
+            goto exit;
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) != ':')
+        {
+            csonParserError(parser);
+            goto exit;
+        }
+        parser->pos++;
+        csonParserSkip(parser);
+        value = parser->pos;
+        matched = 0;
+        if (compiled)
+        {
+            for (int i = csonCompiledFind(compiled, parser->ctx, str, len, escaped); i >= 0; i = field->next)
+            {
+                field = &compiled->fields[i];
+                if (csonCompiledMatch(field, parser->ctx, str, len, escaped)
+                    && csonParserMemberValue(parser, obj, value, field->model, field->sub,
+                    field->index, seen, &matched) != 0)
+                {
+                    goto exit;
+                }
+            }
+        }
+        else
+        {
+            for (int i = 0; i < modelSize; i++)
+            {
+                if (model[i].type == CSON_TYPE_OBJ || !model[i].key
+                    || !csonKeyMatch(parser->ctx, str, len, escaped, model[i].key, -1))
+                {
+                    continue;
+                }
+                if (csonParserMemberValue(parser, obj, value, &model[i], NULL,
+                    i, seen, &matched) != 0)
+                {
+                    goto exit;
+                }
+            }
+        }
+        if (!matched)
+        {
+            parser->pos = value;
+            if (csonParserSkipFast(parser) != 0)
+            {
+                goto exit;
+            }
+        }
+        csonParserSkip(parser);
+        if (csonParserPeek(parser) == ',')
+        {
+            parser->pos++;
+        }
+        else if (csonParserPeek(parser) == '}')
+        {
+            parser->pos++;
+            ret = 0;
+            goto exit;
+        }
+        else
+        {
+            csonParserError(parser);
+            goto exit;
+        }
+    }
+
+exit:
+    if (seen != seenBuffer)
+    {
+        csonCtxFree(parser->ctx, seen);
+    }
+    return ret;
+}
+
+
+/**
+ * @brief 解析对象成员到已分配的对象
+ *
+ * @param parser 解析器
+ * @param obj 对象，需要预先清零
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param compiled 预编译模型, 可为NULL
+ * @return int 0 成功 -1 失败
+ * @note json不是对象时，与cJSON一致，只有没有键值的成员解析该值本身
+ */
+static int csonParserFields(CsonParser *parser, void *obj, CsonModel *model, int modelSize,
+                            CsonCompiledModel *compiled)
+{
+    const char *start = parser->pos;
+    int ret = 0;
+
+    if (csonParserPeek(parser) == '{')
+    {
+        return csonParserMembers(parser, obj, model, modelSize, compiled);
+    }
+    for (int i = 0; i < modelSize && ret == 0; i++)
+    {
+        if (model[i].type != CSON_TYPE_OBJ && !model[i].key)
+        {
+            parser->pos = start;
+            ret = csonParserField(parser, obj, &model[i], NULL);
+        }
+    }
+    if (ret == 0)
+    {
+        parser->pos = start;
+        ret = csonParserSkipValue(parser);
+    }
+    return ret;
+}
+
+
+/**
+ * @brief 解析对象
+ *
+ * @param parser 解析器
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param compiled 预编译模型, 可为NULL
+ * @param obj 解析得到的对象，json为null时为NULL
+ * @return int 0 成功 -1 失败
+ */
+static int csonParserObject(CsonParser *parser, CsonModel *model, int modelSize,
+                            CsonCompiledModel *compiled, void **obj)
+{
+    int objSize;
+    int ret;
+
+    *obj = NULL;
+    if (csonParserLiteral(parser, "null", 4))
+    {
+        return 0;
+    }
+    objSize = compiled ? compiled->objSize : csonModelObjSize(model, modelSize);
+    *obj = csonParserMalloc(parser, objSize);
+    if (!*obj)
+    {
+        return csonParserError(parser);
+    }
+    memset(*obj, 0, objSize);
+
+    ret = csonParserFields(parser, *obj, model, modelSize, compiled);
+    if (ret != 0)
+    {
+        if (!parser->ctx || !parser->ctx->arena)
+        {
+            csonFreeObject(parser->ctx, *obj, model, modelSize);
+        }
+        *obj = NULL;
+    }
+    return ret;
+}
+
+
+/**
+ * @brief 直接解析JSON字符串
+ *
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ * @note 解析结果与`csonDecode`一致，但不会生成cJSON树，
+ *       输入文本被直接解析并写入目标结构体
+ */
+void *csonDecodeDirect(const char *jsonStr, CsonModel *model, int modelSize)
+{
+    return csonDecodeCtx(NULL, jsonStr, model, modelSize);
+}
+
+
+/**
+ * @brief 预编译数据模型
+ *
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param root 本次编译的根模型
+ * @return CsonCompiledModel* 预编译模型
+ * @note 同一次编译中相同的子模型只会编译一次，支持递归引用的模型
+ */
+static CsonCompiledModel *csonCompileModelInner(CsonModel *model, int modelSize,
+                                                CsonCompiledModel **root)
+{
+    CsonCompiledModel *compiled, **tail;
+    CsonCompiledField *field, *head;
+    int count = 0;
+    unsigned int tableSize = 1;
+    unsigned int pos;
+
+    for (tail = root; *tail; tail = &(*tail)->next)
+    {
+        if ((*tail)->model == model && (*tail)->modelSize == modelSize)
+        {
+            return *tail;
+        }
+    }
+    for (int i = 0; i < modelSize; i++)
+    {
+        if (model[i].type != CSON_TYPE_OBJ)
+        {
+            count++;
+        }
+    }
+    while (tableSize < (unsigned int)count * 2)
+    {
+        tableSize <<= 1;
+    }
+    compiled = cson.malloc(sizeof(CsonCompiledModel)
+        + count * sizeof(CsonCompiledField) + tableSize * sizeof(int));
+    if (!compiled)
+    {
+        return NULL;
+    }
+    compiled->model = model;
+    compiled->modelSize = modelSize;
+    compiled->objSize = csonModelObjSize(model, modelSize);
+    compiled->fieldCount = count;
+    compiled->fields = (CsonCompiledField *)(compiled + 1);
+    compiled->table = (int *)(compiled->fields + count);
+    compiled->tableMask = tableSize - 1;
+    compiled->next = NULL;
+    *tail = compiled;
+    memset(compiled->table, 0xFF, tableSize * sizeof(int));
+
+    count = 0;
+    for (int i = 0; i < modelSize; i++)
+    {
+        if (model[i].type == CSON_TYPE_OBJ)
+        {
+            continue;
+        }
+        field = &compiled->fields[count];
+        field->model = &model[i];
+        field->index = i;
+        field->keyLen = 0;
+        field->hash = 0;
+        field->next = -1;
+        field->sub = NULL;
+        if (model[i].key)
+        {
+            field->hash = csonKeyHash(model[i].key, strlen(model[i].key), 0, &field->keyLen);
+            for (head = compiled->fields; head < field; head++)
+            {
+                if (head->model->key && head->hash == field->hash
+                    && csonKeyEqual(head->model->key, head->keyLen, 0, model[i].key))
+                {
+                    break;
+                }
+            }
+            if (head < field)
+            {
+                while (head->next >= 0)
+                {
+                    head = &compiled->fields[head->next];
+                }
+                head->next = count;
+            }
+            else
+            {
+                for (pos = field->hash & compiled->tableMask;
+                     compiled->table[pos] >= 0;
+                     pos = (pos + 1) & compiled->tableMask);
+                compiled->table[pos] = count;
+            }
+        }
+        if (model[i].type == CSON_TYPE_STRUCT || model[i].type == CSON_TYPE_LIST
+            || model[i].type == CSON_TYPE_VECTOR)
+        {
+            field->sub = csonCompileModelInner(model[i].param.sub.model,
+                model[i].param.sub.size, root);
+            if (!field->sub)
+            {
+                return NULL;
+            }
+        }
+        count++;
+    }
+    return compiled;
+}
+
+
+/**
+ * @brief 预编译数据模型
+ *
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return CsonCompiledModel* 预编译模型
+ */
+CsonCompiledModel *csonCompileModel(CsonModel *model, int modelSize)
+{
+    CsonCompiledModel *root = NULL;
+
+    if (!csonCompileModelInner(model, modelSize, &root))
+    {
+        csonFreeCompiledModel(root);
+        CSON_ASSERT(0, return NULL);
+    }
+    return root;
+}
+
+
+/**
+ * @brief 释放预编译数据模型
+ *
+ * @param compiled 预编译模型
+ */
+void csonFreeCompiledModel(CsonCompiledModel *compiled)
+{
+    CsonCompiledModel *next;
+
+    while (compiled)
+    {
+        next = compiled->next;
+        cson.free(compiled);
+        compiled = next;
+    }
+}
+
+
+/**
+ * @brief 使用预编译模型直接解析JSON字符串
+ *
+ * @param jsonStr json字符串
+ * @param compiled 预编译模型
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeCompiled(const char *jsonStr, CsonCompiledModel *compiled)
+{
+    return csonDecodeCompiledCtx(NULL, jsonStr, compiled);
+}
+
+
+/**
+ * @brief 初始化内存池
+ *
+ * @param arena 内存池
+ * @param buffer 内存池使用的内存块
+ * @param size 内存块大小
+ */
+void csonArenaInit(CsonArena *arena, void *buffer, size_t size)
+{
+    CSON_ASSERT(arena, return);
+    arena->buffer = buffer;
+    arena->size = buffer ? size : 0;
+    arena->offset = 0;
+}
+
+
+/**
+ * @brief 从内存池分配内存
+ *
+ * @param arena 内存池
+ * @param size 内存大小
+ * @return void* 分配的内存，内存池空间不足时返回NULL
+ */
+void *csonArenaAlloc(CsonArena *arena, size_t size)
+{
+    uintptr_t base = (uintptr_t)arena->buffer;
+    size_t offset = ((base + arena->offset + CSON_ARENA_ALIGN - 1)
+        & ~(uintptr_t)(CSON_ARENA_ALIGN - 1)) - base;
+
+    if (offset > arena->size || size > arena->size - offset)
+    {
+        return NULL;
+    }
+    arena->offset = offset + size;
+    return arena->buffer + offset;
+}
+
+
+/**
+ * @brief 重置内存池
+ *
+ * @param arena 内存池
+ * @note 重置后，之前从内存池中解析得到的所有对象都将失效
+ */
+void csonArenaReset(CsonArena *arena)
+{
+    CSON_ASSERT(arena, return);
+    arena->offset = 0;
+}
+
+
+/**
+ * @brief 在内存池中直接解析JSON字符串
+ *
+ * @param arena 内存池
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeInArena(CsonArena *arena, const char *jsonStr, CsonModel *model, int modelSize)
+{
+    CsonContext ctx = {0};
+
+    CSON_ASSERT(arena, return NULL);
+    ctx.arena = arena;
+    return csonDecodeCtx(&ctx, jsonStr, model, modelSize);
+}
+
+
+/**
+ * @brief 使用上下文直接解析JSON字符串
+ *
+ * @param ctx 解析上下文
+ * @param jsonStr json字符串
+ * @param len json字符串长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param compiled 预编译模型，可为NULL
+ * @param read 生成的解析函数，可为NULL
+ * @return void* 解析得到的对象
+ */
+static void *csonDecodeWith(CsonContext *ctx, const char *jsonStr, size_t len,
+                            CsonModel *model, int modelSize, CsonCompiledModel *compiled,
+                            CsonReadFunc read)
+{
+    CsonParser parser;
+    CsonArena *arena = ctx ? ctx->arena : NULL;
+    size_t offset = arena ? arena->offset : 0;
+    void *obj;
+    int ret;
+
+    parser.pos = jsonStr;
+    parser.end = jsonStr + len;
+    parser.err = NULL;
+    parser.ctx = ctx;
+    parser.ownViews = 0;
+    parser.update = 0;
+    parser.updateFlags = 0;
+    csonParserSkip(&parser);
+    ret = read ? read(&parser, &obj)
+        : csonParserObject(&parser, model, modelSize, compiled, &obj);
+    if (ret == 0 && ctx && (ctx->options & CSON_OPTION_REQUIRE_END))
+    {
+        csonParserSkip(&parser);
+        if (parser.pos < parser.end)
+        {
+            ret = csonParserError(&parser);
+            if (!arena)
+            {
+                csonFreeObject(ctx, obj, model, modelSize);
+            }
+        }
+    }
+    if (ret != 0 && arena)
+    {
+        arena->offset = offset;
+    }
+    if (ctx)
+    {
+        ctx->error = ret == 0 ? NULL : parser.err;
+    }
+    CSON_ASSERT(ret == 0, return NULL);
+    return obj;
+}
+
+
+/**
+ * @brief 使用上下文直接解析JSON字符串
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeCtx(CsonContext *ctx, const char *jsonStr, CsonModel *model, int modelSize)
+{
+    CSON_ASSERT(jsonStr && model, return NULL);
+    return csonDecodeWith(ctx, jsonStr, strlen(jsonStr), model, modelSize, NULL, NULL);
+}
+
+
+/**
+ * @brief 使用上下文和预编译模型直接解析JSON字符串
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param jsonStr json字符串
+ * @param compiled 预编译模型
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeCompiledCtx(CsonContext *ctx, const char *jsonStr, CsonCompiledModel *compiled)
+{
+    CSON_ASSERT(jsonStr && compiled, return NULL);
+    return csonDecodeWith(ctx, jsonStr, strlen(jsonStr),
+        compiled->model, compiled->modelSize, compiled, NULL);
+}
+
+
+/**
+ * @brief 使用上下文和预编译模型解析指定长度的JSON字符串
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param json json字符串，不需要以'\0'结尾
+ * @param len json字符串长度
+ * @param compiled 预编译模型
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeCompiledLen(CsonContext *ctx, const char *json, size_t len,
+                            CsonCompiledModel *compiled)
+{
+    CSON_ASSERT(json && compiled, return NULL);
+    return csonDecodeWith(ctx, json, len, compiled->model, compiled->modelSize, compiled, NULL);
+}
+
+
+/**
+ * @brief 解析JSON字符串并就地更新已有对象
+ *
+ * @param obj 已有对象
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param flags 更新标记，CSON_UPDATE_*
+ * @return int 0 成功 -1 失败
+ * @note 只更新json中存在的成员，json为null时对象不变，
+ *       对象通常比输入存在更久，字符串视图总是复制，
+ *       解析失败时已解析的成员保持更新后的值，对象仍可以使用`csonFree`释放
+ */
+int csonDecodeInto(void *obj, const char *jsonStr, CsonModel *model, int modelSize, int flags)
+{
+    return csonDecodeIntoCtx(NULL, obj, jsonStr, model, modelSize, flags);
+}
+
+
+/**
+ * @brief 使用上下文解析JSON字符串并就地更新已有对象
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param obj 已有对象
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param flags 更新标记，CSON_UPDATE_*
+ * @return int 0 成功 -1 失败
+ * @note 被替换的成员使用上下文的释放函数释放，上下文不能设置内存池
+ */
+int csonDecodeIntoCtx(CsonContext *ctx, void *obj, const char *jsonStr,
+                      CsonModel *model, int modelSize, int flags)
+{
+    CsonParser parser = {0};
+    int ret = 0;
+
+    CSON_ASSERT(obj && jsonStr && model, return -1);
+    CSON_ASSERT(!ctx || !ctx->arena, return -1);
+    parser.pos = jsonStr;
+    parser.end = jsonStr + strlen(jsonStr);
+    parser.ctx = ctx;
+    parser.ownViews = 1;
+    parser.update = 1;
+    parser.updateFlags = flags;
+    csonParserSkip(&parser);
+    if (!csonParserLiteral(&parser, "null", 4))
+    {
+        ret = csonParserPeek(&parser) == '{'
+            ? csonParserMembers(&parser, obj, model, modelSize, NULL)
+            : csonParserError(&parser);
+    }
+    if (ret == 0 && ctx && (ctx->options & CSON_OPTION_REQUIRE_END))
+    {
+        csonParserSkip(&parser);
+        if (parser.pos < parser.end)
+        {
+            ret = csonParserError(&parser);
+        }
+    }
+    if (ctx)
+    {
+        ctx->error = ret == 0 ? NULL : parser.err;
+    }
+    CSON_ASSERT(ret == 0, return -1);
+    return 0;
+}
+
+
+#define CSON_VALIDATE_DEPTH         512 /**< 校验时允许的最大嵌套层数 */
+
+/**
+ * @brief 校验器
+ *
+ */
+typedef struct
+{
+    CsonParser parser;                  /**< 解析器 */
+    const char *json;                   /**< 输入起始位置 */
+    int depth;                          /**< 当前嵌套层数 */
+    CsonValidateError *error;           /**< 校验错误 */
+} CsonValidator;
+
+
+static int csonValidateObject(CsonValidator *validator, CsonModel *model, int modelSize,
+                              const char *key);
+
+
+/**
+ * @brief 记录校验错误
+ *
+ * @param validator 校验器
+ * @param code 错误类型
+ * @param pos 出错位置
+ * @param key 出错成员的键值
+ * @return int -1
+ * @note 只记录第一个错误
+ */
+static int csonValidateFail(CsonValidator *validator, int code, const char *pos, const char *key)
+{
+    if (validator->error->code == CSON_VALIDATE_OK)
+    {
+        validator->error->code = code;
+        validator->error->offset = pos - validator->json;
+        validator->error->key = key;
+    }
+    return -1;
+}
+
+
+/**
+ * @brief 校验字符串
+ *
+ * @param validator 校验器，位于字符串开始的'"'
+ * @param key 所在成员的键值
+ * @return int 0 成功 -1 失败
+ * @note 字符串必须结束，不能包含控制字符，转义必须合法
+ */
+static int csonValidateString(CsonValidator *validator, const char *key)
+{
+    CsonParser *parser = &validator->parser;
+    const char *p = parser->pos + 1;
+
+    while (p < parser->end)
+    {
+        if (*p == '\"')
+        {
+            parser->pos = p + 1;
+            return 0;
+        }
+        if ((unsigned char)*p < 0x20)
+        {
+            break;
+        }
+        if (*p == '\\')
+        {
+            /* strchr会匹配结束符，需要先排除 */
+            if (++p >= parser->end || *p == '\0' || !strchr("\"\\/bfnrtu", *p))
+            {
+                break;
+            }
+            if (*p == 'u')
+            {
+                if (parser->end - p <= 4 || !isxdigit((unsigned char)p[1])
+                    || !isxdigit((unsigned char)p[2]) || !isxdigit((unsigned char)p[3])
+                    || !isxdigit((unsigned char)p[4]))
+                {
+                    break;
+                }
+                p += 4;
+            }
+        }
+        p++;
+    }
+    return csonValidateFail(validator, CSON_VALIDATE_SYNTAX, p < parser->end ? p : parser->end, key);
+}
+
+
+/**
+ * @brief 校验数字
+ *
+ * @param validator 校验器
+ * @param key 所在成员的键值
+ * @return int 0 成功 -1 失败
+ * @note 按照json语法严格校验
+ */
+static int csonValidateNumber(CsonValidator *validator, const char *key)
+{
+    CsonParser *parser = &validator->parser;
+    const char *p = parser->pos;
+    const char *end = parser->end;
+    const char *digits;
+
+    if (p < end && *p == '-')
+    {
+        p++;
+    }
+    if (p < end && *p == '0')
+    {
+        p++;
+    }
+    else if (p < end && *p >= '1' && *p <= '9')
+    {
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            p++;
+        }
+    }
+    else
+    {
+        return csonValidateFail(validator, CSON_VALIDATE_SYNTAX, p, key);
+    }
+    if (p < end && *p == '.')
+    {
+        for (digits = ++p; p < end && *p >= '0' && *p <= '9'; p++);
+        if (p == digits)
+        {
+            return csonValidateFail(validator, CSON_VALIDATE_SYNTAX, p, key);
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        if (p < end && (*p == '+' || *p == '-'))
+        {
+            p++;
+        }
+        for (digits = p; p < end && *p >= '0' && *p <= '9'; p++);
+        if (p == digits)
+        {
+            return csonValidateFail(validator, CSON_VALIDATE_SYNTAX, p, key);
+        }
+    }
+    parser->pos = p;
+    return 0;
+}
+
+
+/**
+ * @brief 进入对象或数组
+ *
+ * @param validator 校验器
+ * @param key 所在成员的键值
+ * @return int 0 成功 -1 嵌套层数超过`CSON_VALIDATE_DEPTH`
+ */
+static int csonValidateEnter(CsonValidator *validator, const char *key)
+{
+    if (++validator->depth > CSON_VALIDATE_DEPTH)
+    {
+        return csonValidateFail(validator, CSON_VALIDATE_SYNTAX, validator->parser.pos, key);
+    }
+    validator->parser.pos++;
+    csonParserSkip(&validator->parser);
+    return 0;
+}
+
+
+/**
+ * @brief 校验对象或数组的分隔符
+ *
+ * @param validator 校验器
+ * @param close 结束符
+ * @param key 所在成员的键值
+ * @return int 1 继续 0 结束 -1 失败
+ */
+static int csonValidateNext(CsonValidator *validator, char close, const char *key)
+{
+    CsonParser *parser = &validator->parser;
+
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) == ',')
+    {
+        parser->pos++;
+        csonParserSkip(parser);
+        return 1;
+    }
+    if (csonParserPeek(parser) == close)
+    {
+        parser->pos++;
+        validator->depth--;
+        return 0;
+    }
+    return csonValidateFail(validator, CSON_VALIDATE_SYNTAX, parser->pos, key);
+}
+
+
+/**
+ * @brief 校验对象成员的键值和':'
+ *
+ * @param validator 校验器
+ * @param str 成员键值的原始内容
+ * @param len 原始内容长度
+ * @param key 所在成员的键值
+ * @return int 0 成功 -1 失败
+ */
+static int csonValidateKey(CsonValidator *validator, const char **str, int *len, const char *key)
+{
+    CsonParser *parser = &validator->parser;
+
+    if (csonParserPeek(parser) != '\"')
+    {
+        return csonValidateFail(validator, CSON_VALIDATE_SYNTAX, parser->pos, key);
+    }
+    *str = parser->pos + 1;
+    if (csonValidateString(validator, key) != 0)
+    {
+        return -1;
+    }
+    *len = parser->pos - 1 - *str;
+    csonParserSkip(parser);
+    if (csonParserPeek(parser) != ':')
+    {
+        return csonValidateFail(validator, CSON_VALIDATE_SYNTAX, parser->pos, key);
+    }
+    parser->pos++;
+    csonParserSkip(parser);
+    return 0;
+}
+
+
+/**
+ * @brief 校验任意json值
+ *
+ * @param validator 校验器
+ * @param key 所在成员的键值
+ * @return int 0 成功 -1 失败
+ */
+static int csonValidateSkip(CsonValidator *validator, const char *key)
+{
+    CsonParser *parser = &validator->parser;
+    char c = csonParserPeek(parser);
+    const char *str;
+    int len, ret;
+
+    switch (c)
+    {
+    case '\"':
+        return csonValidateString(validator, key);
+    case '[':
+    case '{':
+        if (csonValidateEnter(validator, key) != 0)
+        {
+            return -1;
+        }
+        if (csonParserPeek(parser) == (c == '[' ? ']' : '}'))
+        {
+            parser->pos++;
+            validator->depth--;
+            return 0;
+        }
+        do
+        {
+            if ((c == '{' && csonValidateKey(validator, &str, &len, key) != 0)
+                || csonValidateSkip(validator, key) != 0)
+            {
+                return -1;
+            }
+        } while ((ret = csonValidateNext(validator, c == '[' ? ']' : '}', key)) > 0);
+        return ret;
+    default:
+        if (csonParserLiteral(parser, "true", 4) || csonParserLiteral(parser, "false", 5)
+            || csonParserLiteral(parser, "null", 4))
+        {
+            return 0;
+        }
+        return csonValidateNumber(validator, key);
+    }
+}
+
+
+/**
+ * @brief 校验基本类型值
+ *
+ * @param validator 校验器
+ * @param type 数据类型
+ * @param key 所在成员的键值
+ * @return int 0 成功 -1 失败
+ * @note 数字类型需要数字，布尔类型需要true或false，字符串类型需要字符串或null
+ */
+static int csonValidateBasic(CsonValidator *validator, CsonType type, const char *key)
+{
+    CsonParser *parser = &validator->parser;
+    const char *start = parser->pos;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_SHORT:
+    case CSON_TYPE_INT:
+    case CSON_TYPE_LONG:
+    case CSON_TYPE_FLOAT:
+    case CSON_TYPE_DOUBLE:
+        if (csonParserIsNumber(parser))
+        {
+            return csonValidateNumber(validator, key);
+        }
+        break;
+    case CSON_TYPE_BOOL:
+        if (csonParserLiteral(parser, "true", 4) || csonParserLiteral(parser, "false", 5))
+        {
+            return 0;
+        }
+        break;
+    case CSON_TYPE_STRING:
+    case CSON_TYPE_STRING_VIEW:
+        if (csonParserPeek(parser) == '\"')
+        {
+            return csonValidateString(validator, key);
+        }
+        if (csonParserLiteral(parser, "null", 4))
+        {
+            return 0;
+        }
+        break;
+    default:
+        return csonValidateSkip(validator, key);
+    }
+    if (csonValidateSkip(validator, key) != 0)
+    {
+        return -1;
+    }
+    return csonValidateFail(validator, CSON_VALIDATE_TYPE, start, key);
+}
+
+
+/**
+ * @brief 校验数组
+ *
+ * @param validator 校验器，位于'['
+ * @param model 元素数据模型，为NULL时元素为`elementType`类型
+ * @param modelSize 元素数据模型数量
+ * @param elementType 元素类型
+ * @param size 最大元素数量，小于0时不限制
+ * @param key 所在成员的键值
+ * @return int 0 成功 -1 失败
+ */
+static int csonValidateArray(CsonValidator *validator, CsonModel *model, int modelSize,
+                             CsonType elementType, int size, const char *key)
+{
+    CsonParser *parser = &validator->parser;
+    const char *start;
+    int count = 0;
+    int ret;
+
+    if (csonValidateEnter(validator, key) != 0)
+    {
+        return -1;
+    }
+    if (csonParserPeek(parser) == ']')
+    {
+        parser->pos++;
+        validator->depth--;
+        return 0;
+    }
+    do
+    {
+        start = parser->pos;
+        if (size >= 0 && count++ >= size)
+        {
+            return csonValidateFail(validator, CSON_VALIDATE_BOUNDS, parser->pos, key);
+        }
+        if (!model || csonIsBasicListModel(model))
+        {
+            ret = csonValidateBasic(validator, model ? model[1].type : elementType, key);
+        }
+        else if (csonParserPeek(parser) == '{')
+        {
+            ret = csonValidateObject(validator, model, modelSize, key);
+        }
+        else if (csonParserLiteral(parser, "null", 4))
+        {
+            ret = 0;
+        }
+        else
+        {
+            ret = csonValidateSkip(validator, key) != 0
+                ? -1 : csonValidateFail(validator, CSON_VALIDATE_TYPE, start, key);
+        }
+        if (ret != 0)
+        {
+            return -1;
+        }
+    } while ((ret = csonValidateNext(validator, ']', key)) > 0);
+    return ret;
+}
+
+
+/**
+ * @brief 校验对象成员的值
+ *
+ * @param validator 校验器
+ * @param field 成员数据模型
+ * @return int 0 成功 -1 失败
+ * @note 结构体、链表、CsonVector和数组成员可以为null
+ */
+static int csonValidateField(CsonValidator *validator, CsonModel *field)
+{
+    CsonParser *parser = &validator->parser;
+    const char *start = parser->pos;
+    char c = csonParserPeek(parser);
+
+    switch (field->type)
+    {
+    case CSON_TYPE_STRUCT:
+    case CSON_TYPE_LIST:
+    case CSON_TYPE_VECTOR:
+    case CSON_TYPE_ARRAY:
+        if (csonParserLiteral(parser, "null", 4))
+        {
+            return 0;
+        }
+        if (field->type == CSON_TYPE_STRUCT && c == '{')
+        {
+            return csonValidateObject(validator, field->param.sub.model,
+                field->param.sub.size, field->key);
+        }
+        if (field->type == CSON_TYPE_ARRAY && c == '[')
+        {
+            return csonValidateArray(validator, NULL, 0, field->param.array.eleType,
+                field->param.array.size, field->key);
+        }
+        if (field->type != CSON_TYPE_STRUCT && c == '[')
+        {
+            return csonValidateArray(validator, field->param.sub.model,
+                field->param.sub.size, CSON_TYPE_OBJ, -1, field->key);
+        }
+        if (csonValidateSkip(validator, field->key) != 0)
+        {
+            return -1;
+        }
+        return csonValidateFail(validator, CSON_VALIDATE_TYPE, start, field->key);
+    case CSON_TYPE_JSON:
+        return csonValidateSkip(validator, field->key);
+    default:
+        return csonValidateBasic(validator, field->type, field->key);
+    }
+}
+
+
+/**
+ * @brief 查找对象中是否存在键值
+ *
+ * @param validator 校验器
+ * @param object 对象开始的'{'，对象已经通过语法校验
+ * @param key 键值
+ * @return int 是否存在
+ */
+static int csonValidateHasKey(CsonValidator *validator, const char *object, const char *key)
+{
+    CsonParser scan = validator->parser;
+    const char *str;
+    int len, escaped;
+
+    scan.pos = object + 1;
+    while (1)
+    {
+        csonParserSkip(&scan);
+        if (csonParserPeek(&scan) != '\"')
+        {
+            return 0;
+        }
+        csonParserString(&scan, &str, &len, &escaped);
+        if (csonKeyEqual(str, len, escaped, key))
+        {
+            return 1;
+        }
+        csonParserSkip(&scan);
+        scan.pos++;
+        csonParserSkip(&scan);
+        csonParserSkipValue(&scan);
+        csonParserSkip(&scan);
+        if (csonParserPeek(&scan) != ',')
+        {
+            return 0;
+        }
+        scan.pos++;
+    }
+}
+
+
+/**
+ * @brief 校验对象
+ *
+ * @param validator 校验器，位于'{'
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param key 所在成员的键值
+ * @return int 0 成功 -1 失败
+ * @note 数据模型中有键值的成员都必须存在，键值匹配规则与解析一致，
+ *       同名键值只校验第一个，json中多余的成员只校验语法
+ */
+static int csonValidateObject(CsonValidator *validator, CsonModel *model, int modelSize,
+                              const char *key)
+{
+    unsigned char seen[CSON_SEEN_BUFFER_SIZE] = {0};
+    CsonParser *parser = &validator->parser;
+    const char *object = parser->pos;
+    const char *str;
+    const char *value;
+    int len, matched, ret;
+
+    if (csonValidateEnter(validator, key) != 0)
+    {
+        return -1;
+    }
+    if (csonParserPeek(parser) == '}')
+    {
+        parser->pos++;
+        validator->depth--;
+        ret = 0;
+    }
+    else
+    {
+        do
+        {
+            if (csonValidateKey(validator, &str, &len, key) != 0)
+            {
+                return -1;
+            }
+            value = parser->pos;
+            matched = 0;
+            for (int i = 0; i < modelSize; i++)
+            {
+                if (model[i].type == CSON_TYPE_OBJ || !model[i].key
+                    || (i < CSON_SEEN_BUFFER_SIZE * 8 && (seen[i >> 3] & (1 << (i & 7))))
+                    || !csonKeyEqual(str, len, memchr(str, '\\', len) != NULL, model[i].key))
+                {
+                    continue;
+                }
+                parser->pos = value;
+                if (csonValidateField(validator, &model[i]) != 0)
+                {
+                    return -1;
+                }
+                if (i < CSON_SEEN_BUFFER_SIZE * 8)
+                {
+                    seen[i >> 3] |= 1 << (i & 7);
+                }
+                matched = 1;
+            }
+            if (!matched && csonValidateSkip(validator, key) != 0)
+            {
+                return -1;
+            }
+        } while ((ret = csonValidateNext(validator, '}', key)) > 0);
+    }
+    if (ret != 0)
+    {
+        return -1;
+    }
+    for (int i = 0; i < modelSize; i++)
+    {
+        if (model[i].type == CSON_TYPE_OBJ || !model[i].key)
+        {
+            continue;
+        }
+        if (i < CSON_SEEN_BUFFER_SIZE * 8 ? !(seen[i >> 3] & (1 << (i & 7)))
+            : !csonValidateHasKey(validator, object, model[i].key))
+        {
+            return csonValidateFail(validator, CSON_VALIDATE_MISSING, parser->pos - 1,
+                model[i].key);
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 校验json是否符合数据模型
+ *
+ * @param json json字符串，不需要以'\0'结尾
+ * @param len json字符串长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param error 校验错误，可为NULL
+ * @return int 0 校验通过 -1 校验失败
+ * @note 只扫描一次输入，不分配内存
+ */
+int csonValidate(const char *json, size_t len, CsonModel *model, int modelSize,
+                 CsonValidateError *error)
+{
+    CsonValidateError local;
+    CsonValidator validator = {0};
+    const char *start;
+
+    CSON_ASSERT(json && model, return -1);
+    validator.parser.pos = json;
+    validator.parser.end = json + len;
+    validator.json = json;
+    validator.error = error ? error : &local;
+    memset(validator.error, 0, sizeof(CsonValidateError));
+    csonParserSkip(&validator.parser);
+    start = validator.parser.pos;
+    if (csonParserPeek(&validator.parser) != '{')
+    {
+        if (csonValidateSkip(&validator, NULL) == 0)
+        {
+            csonValidateFail(&validator, CSON_VALIDATE_TYPE, start, NULL);
+        }
+        return -1;
+    }
+    if (csonValidateObject(&validator, model, modelSize, NULL) != 0)
+    {
+        return -1;
+    }
+    csonParserSkip(&validator.parser);
+    if (validator.parser.pos < validator.parser.end)
+    {
+        return csonValidateFail(&validator, CSON_VALIDATE_SYNTAX, validator.parser.pos, NULL);
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 开始解析对象
+ *
+ * @param reader 读取器
+ * @param obj 分配的对象，json为null时为NULL
+ * @param objSize 对象大小
+ * @return int 1 json为对象，需要继续解析成员 0 解析完成 -1 失败
+ */
+int csonReadBegin(CsonReader *reader, void **obj, int objSize)
+{
+    *obj = NULL;
+    if (csonParserLiteral(reader, "null", 4))
+    {
+        return 0;
+    }
+    *obj = csonParserMalloc(reader, objSize);
+    if (!*obj)
+    {
+        return csonParserError(reader);
+    }
+    memset(*obj, 0, objSize);
+    if (csonParserPeek(reader) == '{')
+    {
+        reader->pos++;
+        return 1;
+    }
+    if (csonParserSkipValue(reader) != 0)
+    {
+        if (!reader->ctx || !reader->ctx->arena)
+        {
+            csonCtxFree(reader->ctx, *obj);
+        }
+        *obj = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 读取对象成员的键值
+ *
+ * @param reader 读取器
+ * @param str 键值原始内容
+ * @param len 键值原始内容长度
+ * @param escaped 键值是否包含转义
+ * @param first 是否为对象的第一个成员
+ * @return int 1 读取到键值，已跳过冒号 0 对象结束 -1 失败
+ */
+int csonReadKey(CsonReader *reader, const char **str, int *len, int *escaped, int first)
+{
+    csonParserSkip(reader);
+    if (csonParserPeek(reader) == '}')
+    {
+        reader->pos++;
+        return 0;
+    }
+    if (!first)
+    {
+        if (csonParserPeek(reader) != ',')
+        {
+            return csonParserError(reader);
+        }
+        reader->pos++;
+        csonParserSkip(reader);
+    }
+    if (csonParserString(reader, str, len, escaped) != 0)
+    {
+        return -1;
+    }
+    csonParserSkip(reader);
+    if (csonParserPeek(reader) != ':')
+    {
+        return csonParserError(reader);
+    }
+    reader->pos++;
+    csonParserSkip(reader);
+    return 1;
+}
+
+
+/**
+ * @brief 比较键值
+ *
+ * @param str 键值原始内容
+ * @param len 键值原始内容长度
+ * @param escaped 键值是否包含转义
+ * @param key 模型键值
+ * @return int 是否相等
+ */
+int csonReadKeyEqual(const char *str, int len, int escaped, const char *key)
+{
+    return csonKeyEqual(str, len, escaped, key);
+}
+
+
+/**
+ * @brief 按读取器的解析选项比较键值
+ *
+ * @param reader 读取器
+ * @param str 键值原始内容
+ * @param len 键值原始内容长度
+ * @param escaped 键值是否包含转义
+ * @param key 模型键值
+ * @param keyLen 模型键值长度
+ * @return int 是否相等
+ */
+int csonReadKeyMatch(CsonReader *reader, const char *str, int len, int escaped,
+                     const char *key, int keyLen)
+{
+    return csonKeyMatch(reader->ctx, str, len, escaped, key, keyLen);
+}
+
+
+/**
+ * @brief 读取基本类型值
+ *
+ * @param reader 读取器
+ * @param ptr 写入地址
+ * @param type 数据类型
+ * @return int 0 成功 -1 失败
+ */
+int csonReadValue(CsonReader *reader, void *ptr, CsonType type)
+{
+    return csonParserBasic(reader, ptr, type, 0);
+}
+
+
+/**
+ * @brief 按成员数据模型读取成员
+ *
+ * @param reader 读取器
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @return int 0 成功 -1 失败
+ */
+int csonReadField(CsonReader *reader, void *obj, CsonModel *field)
+{
+    return csonParserField(reader, obj, field, NULL);
+}
+
+
+/**
+ * @brief 跳过一个值
+ *
+ * @param reader 读取器
+ * @return int 0 成功 -1 失败
+ */
+int csonReadSkip(CsonReader *reader)
+{
+    return csonParserSkipFast(reader);
+}
+
+
+/**
+ * @brief 释放解析失败的对象
+ *
+ * @param reader 读取器
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ */
+void csonReadFree(CsonReader *reader, void *obj, CsonModel *model, int modelSize)
+{
+    if (!reader->ctx || !reader->ctx->arena)
+    {
+        csonFreeObject(reader->ctx, obj, model, modelSize);
+    }
+}
+
+
+/**
+ * @brief 使用生成的解析函数解析json字符串
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param jsonStr json字符串
+ * @param read 生成的解析函数
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeGenerated(CsonContext *ctx, const char *jsonStr, CsonReadFunc read,
+                          CsonModel *model, int modelSize)
+{
+    CSON_ASSERT(jsonStr && read, return NULL);
+    return csonDecodeWith(ctx, jsonStr, strlen(jsonStr), model, modelSize, NULL, read);
+}
+
+
+/**
+ * @brief 增量解析器容器类型
+ *
+ */
+typedef enum
+{
+    CSON_FRAME_SKIP = 0,                /**< 不需要解析的容器，只检查语法 */
+    CSON_FRAME_OBJECT,                  /**< 结构体 */
+    CSON_FRAME_LIST,                    /**< CsonList */
+    CSON_FRAME_ARRAY,                   /**< 数组 */
+} CsonFrameType;
+
+
+/**
+ * @brief 增量解析器容器状态
+ *
+ */
+typedef enum
+{
+    CSON_FRAME_FIRST = 0,               /**< 等待第一个成员或结束符 */
+    CSON_FRAME_KEY,                     /**< 等待键值 */
+    CSON_FRAME_COLON,                   /**< 等待冒号 */
+    CSON_FRAME_VALUE,                   /**< 等待值 */
+    CSON_FRAME_NEXT,                    /**< 等待逗号或结束符 */
+} CsonFrameState;
+
+
+/**
+ * @brief 增量解析器当前扫描的值
+ *
+ */
+typedef enum
+{
+    CSON_TOKEN_NONE = 0,                /**< 不在值内部 */
+    CSON_TOKEN_STRING,                  /**< 字符串 */
+    CSON_TOKEN_BARE,                    /**< 数字或字面量 */
+    CSON_TOKEN_RAW,                     /**< 需要整体解析的容器 */
+} CsonTokenType;
+
+
+/**
+ * @brief 增量解析器容器
+ *
+ */
+typedef struct
+{
+    char type;                          /**< 容器类型，CsonFrameType */
+    char state;                         /**< 容器状态，CsonFrameState */
+    char object;                        /**< 是否为json对象，否则为json数组 */
+    char basic;                         /**< CsonList是否为基础数据类型链表 */
+    void *obj;                          /**< 结构体或数组基址 */
+    CsonModel *model;                   /**< 数据模型 */
+    int modelSize;                      /**< 数据模型数量 */
+    CsonCompiledModel *compiled;        /**< 预编译模型，可为NULL */
+    CsonList **tail;                    /**< 链表尾 */
+    int objSize;                        /**< 结构体或链表元素大小 */
+    CsonType eleType;                   /**< 数组元素类型 */
+    short arraySize;                    /**< 数组大小 */
+    size_t index;                       /**< 下一个数组元素索引 */
+    int *count;                         /**< 记录数组元素数量的成员，可为NULL */
+    unsigned char *seen;                /**< 成员解析标记，为NULL时使用seenBuffer */
+    unsigned char seenBuffer[8];        /**< 成员解析标记 */
+} CsonDecoderFrame;
+
+
+/**
+ * @brief 增量解析器键值匹配到的成员
+ *
+ */
+typedef struct
+{
+    CsonModel *field;                   /**< 成员数据模型 */
+    CsonCompiledModel *sub;             /**< 子结构体预编译模型 */
+    int index;                          /**< 成员索引 */
+} CsonDecoderMatch;
+
+
+/**
+ * @brief 增量解析器
+ *
+ * @note 对象、链表和数组逐层入栈，在输入分段时不需要保留已输入的内容；
+ *       标量值以及无法逐层解析的值会被完整截取，未跨越分段时直接在分段中解析，
+ *       否则复制到缓冲中，然后交给直接解析器解析
+ */
+struct cson_decoder
+{
+    CsonContext *ctx;                   /**< 解析上下文 */
+    CsonModel *model;                   /**< 数据模型 */
+    int modelSize;                      /**< 数据模型数量 */
+    CsonCompiledModel *compiled;        /**< 预编译模型，可为NULL */
+    void *obj;                          /**< 解析结果 */
+    size_t arenaOffset;                 /**< 创建时的内存池偏移，解析失败时回滚 */
+    size_t offset;                      /**< 已处理字节数，解析失败后为失败位置 */
+    int failed;                         /**< 是否解析失败 */
+    int done;                           /**< 根节点是否解析完成 */
+    CsonDecoderFrame *frames;           /**< 容器栈 */
+    size_t depth;                       /**< 容器栈深度 */
+    size_t frameCap;                    /**< 容器栈容量 */
+    CsonDecoderMatch *matches;          /**< 当前键值匹配到的成员 */
+    size_t matchCount;                  /**< 匹配到的成员数量 */
+    size_t matchCap;                    /**< 匹配成员容量 */
+    char token;                         /**< 当前扫描的值，CsonTokenType */
+    char key;                           /**< 当前扫描的字符串是否为键值 */
+    char escape;                        /**< 上一个字符是否为转义符 */
+    char inString;                      /**< 容器扫描中是否处于字符串内 */
+    size_t rawDepth;                    /**< 容器扫描的嵌套深度 */
+    size_t tokenOffset;                 /**< 当前值的起始偏移 */
+    char *buffer;                       /**< 跨越分段的值的缓冲 */
+    size_t bufferLen;                   /**< 缓冲已使用长度 */
+    size_t bufferCap;                   /**< 缓冲容量 */
+};
+
+
+/**
+ * @brief 创建增量解析器
+ *
+ * @param ctx 解析上下文
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param compiled 预编译模型，可为NULL
+ * @return CsonDecoder* 增量解析器
+ */
+static CsonDecoder *csonDecoderNew(CsonContext *ctx, CsonModel *model, int modelSize,
+                                   CsonCompiledModel *compiled)
+{
+    CsonDecoder *decoder = csonCtxMalloc(ctx, sizeof(CsonDecoder));
+
+    CSON_ASSERT(decoder, return NULL);
+    memset(decoder, 0, sizeof(CsonDecoder));
+    decoder->ctx = ctx;
+    decoder->model = model;
+    decoder->modelSize = modelSize;
+    decoder->compiled = compiled;
+    decoder->arenaOffset = ctx && ctx->arena ? ctx->arena->offset : 0;
+    return decoder;
+}
+
+
+/**
+ * @brief 创建增量解析器
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return CsonDecoder* 增量解析器
+ */
+CsonDecoder *csonDecoderCreate(CsonContext *ctx, CsonModel *model, int modelSize)
+{
+    CSON_ASSERT(model, return NULL);
+    return csonDecoderNew(ctx, model, modelSize, NULL);
+}
+
+
+/**
+ * @brief 使用预编译模型创建增量解析器
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param compiled 预编译模型
+ * @return CsonDecoder* 增量解析器
+ */
+CsonDecoder *csonDecoderCreateCompiled(CsonContext *ctx, CsonCompiledModel *compiled)
+{
+    CSON_ASSERT(compiled, return NULL);
+    return csonDecoderNew(ctx, compiled->model, compiled->modelSize, compiled);
+}
+
+
+/**
+ * @brief 扩展增量解析器内部数组
+ *
+ * @param decoder 增量解析器
+ * @param data 数组
+ * @param cap 数组容量
+ * @param need 需要的元素数量
+ * @param size 元素大小
+ * @return int 0 成功 -1 失败
+ * @note 内部数组总是使用上下文的分配函数，不从内存池分配
+ */
+static int csonDecoderReserve(CsonDecoder *decoder, void **data, size_t *cap,
+                              size_t need, size_t size)
+{
+    size_t n = *cap ? *cap : 16;
+    void *p;
+
+    if (need <= *cap)
+    {
+        return 0;
+    }
+    while (n < need && n <= SIZE_MAX / 2)
+    {
+        n <<= 1;
+    }
+    if (n < need || n > SIZE_MAX / size)
+    {
+        return -1;
+    }
+    p = csonCtxMalloc(decoder->ctx, n * size);
+    if (!p)
+    {
+        return -1;
+    }
+    if (*data)
+    {
+        memcpy(p, *data, *cap * size);
+        csonCtxFree(decoder->ctx, *data);
+    }
+    *data = p;
+    *cap = n;
+    return 0;
+}
+
+
+/**
+ * @brief 设置解析失败
+ *
+ * @param decoder 增量解析器
+ * @param offset 失败位置
+ * @return int -1
+ */
+static int csonDecoderError(CsonDecoder *decoder, size_t offset)
+{
+    if (!decoder->failed)
+    {
+        decoder->failed = 1;
+        decoder->offset = offset;
+    }
+    return -1;
+}
+
+
+/**
+ * @brief 为解析结果分配内存
+ *
+ * @param decoder 增量解析器
+ * @param size 内存大小
+ * @return void* 分配的内存
+ */
+static void *csonDecoderMalloc(CsonDecoder *decoder, size_t size)
+{
+    CsonParser parser = {.ctx = decoder->ctx, .ownViews = 1};
+    return csonParserMalloc(&parser, size);
+}
+
+
+/**
+ * @brief 获取当前容器
+ *
+ * @param decoder 增量解析器
+ * @return CsonDecoderFrame* 当前容器，根节点时为NULL
+ */
+static CsonDecoderFrame *csonDecoderTop(CsonDecoder *decoder)
+{
+    return decoder->depth ? &decoder->frames[decoder->depth - 1] : NULL;
+}
+
+
+/**
+ * @brief 标记成员已解析
+ *
+ * @param frame 容器
+ * @param index 成员索引
+ */
+static void csonDecoderSeen(CsonDecoderFrame *frame, int index)
+{
+    unsigned char *seen = frame->seen ? frame->seen : frame->seenBuffer;
+    seen[index >> 3] |= 1 << (index & 7);
+}
+
+
+/**
+ * @brief 容器入栈
+ *
+ * @param decoder 增量解析器
+ * @param type 容器类型
+ * @param object 是否为json对象
+ * @return CsonDecoderFrame* 入栈的容器，失败时为NULL
+ * @note 入栈可能移动容器栈，之前获取的容器指针将失效
+ */
+static CsonDecoderFrame *csonDecoderPush(CsonDecoder *decoder, CsonFrameType type, int object)
+{
+    CsonDecoderFrame *frame;
+
+    if (csonDecoderReserve(decoder, (void **)&decoder->frames, &decoder->frameCap,
+        decoder->depth + 1, sizeof(CsonDecoderFrame)) != 0)
+    {
+        return NULL;
+    }
+    frame = &decoder->frames[decoder->depth++];
+    memset(frame, 0, sizeof(CsonDecoderFrame));
+    frame->type = type;
+    frame->state = CSON_FRAME_FIRST;
+    frame->object = object;
+    return frame;
+}
+
+
+/**
+ * @brief 结构体容器入栈
+ *
+ * @param decoder 增量解析器
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param compiled 预编译模型，可为NULL
+ * @param obj 保存结构体指针的位置
+ * @return int 0 成功 -1 失败
+ */
+static int csonDecoderPushObject(CsonDecoder *decoder, CsonModel *model, int modelSize,
+                                 CsonCompiledModel *compiled, void **obj)
+{
+    CsonDecoderFrame *frame;
+    int objSize = compiled ? compiled->objSize : csonModelObjSize(model, modelSize);
+    int seenSize = (modelSize + 7) / 8;
+
+    *obj = csonDecoderMalloc(decoder, objSize);
+    if (!*obj)
+    {
+        return -1;
+    }
+    memset(*obj, 0, objSize);
+    frame = csonDecoderPush(decoder, CSON_FRAME_OBJECT, 1);
+    if (!frame)
+    {
+        return -1;
+    }
+    frame->obj = *obj;
+    frame->model = model;
+    frame->modelSize = modelSize;
+    frame->compiled = compiled;
+    frame->objSize = objSize;
+    if (seenSize > (int)sizeof(frame->seenBuffer))
+    {
+        frame->seen = csonCtxMalloc(decoder->ctx, seenSize);
+        if (!frame->seen)
+        {
+            decoder->depth--;
+            return -1;
+        }
+        memset(frame->seen, 0, seenSize);
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 容器出栈
+ *
+ * @param decoder 增量解析器
+ */
+static void csonDecoderPop(CsonDecoder *decoder)
+{
+    CsonDecoderFrame *frame = &decoder->frames[--decoder->depth];
+
+    if (frame->seen)
+    {
+        csonCtxFree(decoder->ctx, frame->seen);
+    }
+    if (frame->count)
+    {
+        *frame->count = frame->index < (size_t)frame->arraySize ? (int)frame->index : frame->arraySize;
+    }
+    frame = csonDecoderTop(decoder);
+    if (frame)
+    {
+        frame->state = CSON_FRAME_NEXT;
+    }
+    else
+    {
+        decoder->done = 1;
+    }
+}
+
+
+/**
+ * @brief 新建链表节点
+ *
+ * @param decoder 增量解析器
+ * @param frame 链表容器
+ * @return CsonList* 链表节点
+ */
+static CsonList *csonDecoderListNode(CsonDecoder *decoder, CsonDecoderFrame *frame)
+{
+    CsonList *node = csonListNew(decoder->ctx);
+
+    if (node)
+    {
+        node->next = NULL;
+        node->obj = NULL;
+        *frame->tail = node;
+        frame->tail = &node->next;
+    }
+    return node;
+}
+
+
+/**
+ * @brief 记录键值匹配到的成员
+ *
+ * @param decoder 增量解析器
+ * @param frame 当前容器
+ * @param field 成员数据模型
+ * @param sub 子结构体预编译模型
+ * @param index 成员索引
+ * @return int 0 成功 -1 失败
+ * @note 与`csonParserMemberValue`一致，已经解析过的成员被忽略
+ */
+static int csonDecoderMatchField(CsonDecoder *decoder, CsonDecoderFrame *frame,
+                                 CsonModel *field, CsonCompiledModel *sub, int index)
+{
+    unsigned char *seen = frame->seen ? frame->seen : frame->seenBuffer;
+    CsonDecoderMatch *match;
+
+    if (seen[index >> 3] & (1 << (index & 7)))
+    {
+        return 0;
+    }
+    if (csonDecoderReserve(decoder, (void **)&decoder->matches, &decoder->matchCap,
+        decoder->matchCount + 1, sizeof(CsonDecoderMatch)) != 0)
+    {
+        return -1;
+    }
+    match = &decoder->matches[decoder->matchCount++];
+    match->field = field;
+    match->sub = sub;
+    match->index = index;
+    return 0;
+}
+
+
+/**
+ * @brief 匹配键值对应的成员
+ *
+ * @param decoder 增量解析器
+ * @param frame 当前容器
+ * @param span 键值json
+ * @param len 键值json长度
+ * @return int 0 成功 -1 失败
+ */
+static int csonDecoderKey(CsonDecoder *decoder, CsonDecoderFrame *frame,
+                          const char *span, size_t len)
+{
+    CsonParser parser = {.pos = span, .end = span + len, .ctx = decoder->ctx, .ownViews = 1};
+    CsonCompiledField *field;
+    CsonModel *model = frame->model;
+    const char *str;
+    int strLen, escaped;
+    int ret = 0;
+
+    decoder->matchCount = 0;
+    if (csonParserString(&parser, &str, &strLen, &escaped) != 0 || parser.pos != parser.end)
+    {
+        return csonDecoderError(decoder, decoder->tokenOffset
+            + ((parser.err ? parser.err : parser.pos) - span));
+    }
+    if (frame->type != CSON_FRAME_OBJECT)
+    {
+        return 0;
+    }
+    if (frame->compiled)
+    {
+        for (int i = csonCompiledFind(frame->compiled, decoder->ctx, str, strLen, escaped);
+             i >= 0 && ret == 0; i = field->next)
+        {
+            field = &frame->compiled->fields[i];
+            if (csonCompiledMatch(field, decoder->ctx, str, strLen, escaped))
+            {
+                ret = csonDecoderMatchField(decoder, frame, field->model, field->sub, field->index);
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < frame->modelSize && ret == 0; i++)
+        {
+            if (model[i].type != CSON_TYPE_OBJ && model[i].key
+                && csonKeyMatch(decoder->ctx, str, strLen, escaped, model[i].key, -1))
+            {
+                ret = csonDecoderMatchField(decoder, frame, &model[i], NULL, i);
+            }
+        }
+    }
+    return ret == 0 ? 0 : csonDecoderError(decoder, decoder->tokenOffset);
+}
+
+
+/**
+ * @brief 链表容器入栈
+ *
+ * @param decoder 增量解析器
+ * @param model CsonList成员数据模型
+ * @param modelSize CsonList成员模型数量
+ * @param compiled CsonList成员预编译模型, 可为NULL
+ * @param list 链表
+ * @return int 0 成功 -1 失败
+ */
+static int csonDecoderPushList(CsonDecoder *decoder, CsonModel *model, int modelSize,
+                               CsonCompiledModel *compiled, CsonList **list)
+{
+    CsonDecoderFrame *frame = csonDecoderPush(decoder, CSON_FRAME_LIST, 0);
+
+    if (!frame)
+    {
+        return -1;
+    }
+    frame->model = model;
+    frame->modelSize = modelSize;
+    frame->compiled = compiled;
+    frame->tail = list;
+    frame->basic = csonIsBasicListModel(model);
+    frame->objSize = compiled ? compiled->objSize : csonModelObjSize(model, modelSize);
+    return 0;
+}
+
+
+/**
+ * @brief 开始解析容器值
+ *
+ * @param decoder 增量解析器
+ * @param c 容器起始字符
+ * @return int 1 容器已入栈 0 需要截取整个值解析 -1 失败
+ * @note 容器对应的成员为基本数据类型或不需要解析时，与直接解析器一致写入0，
+ *       然后作为不需要解析的容器入栈
+ */
+static int csonDecoderContainer(CsonDecoder *decoder, char c)
+{
+    CsonDecoderFrame *frame = csonDecoderTop(decoder);
+    CsonDecoderMatch *match;
+    CsonModel *field;
+    CsonList *node;
+    void *ptr;
+    int *count;
+    int size;
+
+    if (!frame)
+    {
+        if (c != '{')
+        {
+            return 0;
+        }
+        return csonDecoderPushObject(decoder, decoder->model, decoder->modelSize,
+            decoder->compiled, &decoder->obj) == 0 ? 1 : -1;
+    }
+    switch (frame->type)
+    {
+    case CSON_FRAME_OBJECT:
+        if (decoder->matchCount == 0)
+        {
+            break;
+        }
+        if (decoder->matchCount > 1)
+        {
+            return 0;
+        }
+        match = &decoder->matches[0];
+        field = match->field;
+        ptr = (char *)frame->obj + field->offset;
+        if (field->type == CSON_TYPE_STRUCT && c == '{')
+        {
+            csonDecoderSeen(frame, match->index);
+            return csonDecoderPushObject(decoder, field->param.sub.model,
+                field->param.sub.size, match->sub, (void **)ptr) == 0 ? 1 : -1;
+        }
+        if (field->type == CSON_TYPE_STRUCT || field->type == CSON_TYPE_JSON
+            || field->type == CSON_TYPE_VECTOR)
+        {
+            return 0;
+        }
+        csonDecoderSeen(frame, match->index);
+        if (field->type == CSON_TYPE_LIST)
+        {
+            *(CsonList **)ptr = NULL;
+            if (c == '[')
+            {
+                return csonDecoderPushList(decoder, field->param.sub.model,
+                    field->param.sub.size, match->sub, (CsonList **)ptr) == 0 ? 1 : -1;
+            }
+        }
+        else if (field->type == CSON_TYPE_ARRAY)
+        {
+            csonSetArrayCount(frame->obj, field, 0);
+            if (c == '[')
+            {
+                count = field->param.array.countOffset
+                    ? (int *)((char *)frame->obj + field->offset + field->param.array.countOffset) : NULL;
+                frame = csonDecoderPush(decoder, CSON_FRAME_ARRAY, 0);
+                if (!frame)
+                {
+                    return -1;
+                }
+                frame->obj = ptr;
+                frame->eleType = field->param.array.eleType;
+                frame->arraySize = field->param.array.size;
+                frame->count = count;
+                return 1;
+            }
+        }
+        else
+        {
+            memset(ptr, 0, csonTypeSize(field->type));
+        }
+        break;
+    case CSON_FRAME_LIST:
+        if (!frame->basic && c != '{')
+        {
+            return 0;
+        }
+        node = csonDecoderListNode(decoder, frame);
+        if (!node)
+        {
+            return -1;
+        }
+        if (!frame->basic)
+        {
+            return csonDecoderPushObject(decoder, frame->model, frame->modelSize,
+                frame->compiled, &node->obj) == 0 ? 1 : -1;
+        }
+        break;
+    case CSON_FRAME_ARRAY:
+        size = csonTypeSize(frame->eleType);
+        if (frame->index < (size_t)frame->arraySize && size > 0)
+        {
+            memset((char *)frame->obj + frame->index * size, 0, size);
+        }
+        frame->index++;
+        break;
+    default:
+        break;
+    }
+    return csonDecoderPush(decoder, CSON_FRAME_SKIP, c == '{') ? 1 : -1;
+}
+
+
+/**
+ * @brief 解析一个完整的值
+ *
+ * @param decoder 增量解析器
+ * @param span 值的json
+ * @param len 值的json长度
+ * @return int 0 成功 -1 失败
+ * @note 值交给直接解析器解析，字符串视图总是复制，解析后不再引用输入
+ */
+static int csonDecoderValue(CsonDecoder *decoder, const char *span, size_t len)
+{
+    CsonParser parser = {.pos = span, .end = span + len, .ctx = decoder->ctx, .ownViews = 1};
+    CsonDecoderFrame *frame = csonDecoderTop(decoder);
+    CsonList *node;
+    union {
+        char c;
+        short s;
+        int i;
+        long l;
+        float f;
+        double d;
+        void *p;
+    } value;
+    int size;
+    int ret = 0;
+
+    if (!frame)
+    {
+        ret = csonParserObject(&parser, decoder->model, decoder->modelSize,
+            decoder->compiled, &decoder->obj);
+    }
+    else if (frame->type == CSON_FRAME_OBJECT && decoder->matchCount)
+    {
+        for (size_t i = 0; i < decoder->matchCount && ret == 0; i++)
+        {
+            parser.pos = span;
+            ret = csonParserField(&parser, frame->obj,
+                decoder->matches[i].field, decoder->matches[i].sub);
+            if (ret == 0 && parser.pos != parser.end)
+            {
+                ret = csonParserError(&parser);
+            }
+            if (ret == 0)
+            {
+                csonDecoderSeen(frame, decoder->matches[i].index);
+            }
+        }
+    }
+    else if (frame->type == CSON_FRAME_LIST)
+    {
+        node = csonDecoderListNode(decoder, frame);
+        if (!node)
+        {
+            ret = csonParserError(&parser);
+        }
+        else if (frame->basic)
+        {
+            memset(&value, 0, sizeof(value));
+            ret = csonParserBasic(&parser, &value, frame->model[1].type, 0);
+            memcpy(&node->obj, &value,
+                frame->objSize < (int)sizeof(void *) ? frame->objSize : (int)sizeof(void *));
+        }
+        else
+        {
+            ret = csonParserObject(&parser, frame->model, frame->modelSize,
+                frame->compiled, &node->obj);
+        }
+    }
+    else if (frame->type == CSON_FRAME_ARRAY
+        && frame->index < (size_t)frame->arraySize && (size = csonTypeSize(frame->eleType)) > 0)
+    {
+        ret = csonParserBasic(&parser, (char *)frame->obj + frame->index * size,
+            frame->eleType, 1);
+    }
+    else
+    {
+        ret = csonParserSkipValue(&parser);
+    }
+    if (ret == 0 && parser.pos != parser.end)
+    {
+        ret = csonParserError(&parser);
+    }
+    if (ret != 0)
+    {
+        return csonDecoderError(decoder, decoder->tokenOffset
+            + ((parser.err ? parser.err : parser.pos) - span));
+    }
+    if (!frame)
+    {
+        decoder->done = 1;
+        return 0;
+    }
+    if (frame->type == CSON_FRAME_ARRAY)
+    {
+        frame->index++;
+    }
+    frame->state = CSON_FRAME_NEXT;
+    return 0;
+}
+
+
+/**
+ * @brief 是否为数字或字面量的结束字符
+ *
+ * @param c 字符
+ * @return int 是否为结束字符
+ */
+static int csonDecoderDelimiter(char c)
+{
+    switch (c)
+    {
+    case ',':
+    case ':':
+    case '[':
+    case ']':
+    case '{':
+    case '}':
+    case '\"':
+        return 1;
+    default:
+        return (unsigned char)(c - 1) < 32;
+    }
+}
+
+
+/**
+ * @brief 扫描当前值
+ *
+ * @param decoder 增量解析器
+ * @param pos 扫描位置，扫描后更新
+ * @param end 分段结束位置
+ * @return int 1 值已结束 0 需要更多输入
+ */
+static int csonDecoderScan(CsonDecoder *decoder, const char **pos, const char *end)
+{
+    const char *p = *pos;
+    char c;
+    int complete = 0;
+
+    switch (decoder->token)
+    {
+    case CSON_TOKEN_STRING:
+        while (p < end)
+        {
+            if (decoder->escape)
+            {
+                decoder->escape = 0;
+                p++;
+                continue;
+            }
+            p = csonScanQuote(p, end);
+            if (p == end)
+            {
+                break;
+            }
+            if (*p++ == '\\')
+            {
+                decoder->escape = 1;
+                continue;
+            }
+            complete = 1;
+            break;
+        }
+        break;
+    case CSON_TOKEN_BARE:
+        while (p < end && !csonDecoderDelimiter(*p))
+        {
+            p++;
+        }
+        complete = p < end;
+        break;
+    case CSON_TOKEN_RAW:
+        while (p < end && !complete)
+        {
+            if (decoder->escape)
+            {
+                decoder->escape = 0;
+                p++;
+            }
+            else if (decoder->inString)
+            {
+                p = csonScanQuote(p, end);
+                if (p < end)
+                {
+                    decoder->escape = *p == '\\';
+                    decoder->inString = decoder->escape;
+                    p++;
+                }
+            }
+            else
+            {
+                c = *p++;
+                if (c == '\"')
+                {
+                    decoder->inString = 1;
+                }
+                else if (c == '{' || c == '[')
+                {
+                    decoder->rawDepth++;
+                }
+                else if ((c == '}' || c == ']') && --decoder->rawDepth == 0)
+                {
+                    complete = 1;
+                }
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    *pos = p;
+    return complete;
+}
+
+
+/**
+ * @brief 处理扫描完成的值
+ *
+ * @param decoder 增量解析器
+ * @param span 值的json
+ * @param len 值的json长度
+ * @return int 0 成功 -1 失败
+ */
+static int csonDecoderToken(CsonDecoder *decoder, const char *span, size_t len)
+{
+    CsonDecoderFrame *frame = csonDecoderTop(decoder);
+    int ret;
+
+    decoder->token = CSON_TOKEN_NONE;
+    if (decoder->key)
+    {
+        ret = csonDecoderKey(decoder, frame, span, len);
+        frame->state = CSON_FRAME_COLON;
+    }
+    else
+    {
+        ret = csonDecoderValue(decoder, span, len);
+    }
+    decoder->bufferLen = 0;
+    return ret;
+}
+
+
+/**
+ * @brief 开始扫描值
+ *
+ * @param decoder 增量解析器
+ * @param token 值类型
+ * @param key 是否为键值
+ * @param offset 值的起始偏移
+ */
+static void csonDecoderStart(CsonDecoder *decoder, CsonTokenType token, int key, size_t offset)
+{
+    decoder->token = token;
+    decoder->key = key;
+    decoder->escape = 0;
+    decoder->inString = 0;
+    decoder->rawDepth = 0;
+    decoder->tokenOffset = offset;
+}
+
+
+/**
+ * @brief 输入一段json
+ *
+ * @param decoder 增量解析器
+ * @param chunk json分段
+ * @param len 分段长度
+ * @return int 0 成功 -1 解析失败
+ */
+int csonDecoderFeed(CsonDecoder *decoder, const char *chunk, size_t len)
+{
+    const char *p = chunk;
+    const char *start = chunk;
+    const char *end = chunk + len;
+    size_t base;
+    CsonDecoderFrame *frame;
+    int ret;
+    char c;
+
+    CSON_ASSERT(decoder && (chunk || !len), return -1);
+    if (decoder->failed)
+    {
+        return -1;
+    }
+    base = decoder->offset;
+    while (1)
+    {
+        if (decoder->token != CSON_TOKEN_NONE)
+        {
+            if (!csonDecoderScan(decoder, &p, end))
+            {
+                if (csonDecoderReserve(decoder, (void **)&decoder->buffer, &decoder->bufferCap,
+                    decoder->bufferLen + (end - start), 1) != 0)
+                {
+                    return csonDecoderError(decoder, base + (start - chunk));
+                }
+                memcpy(decoder->buffer + decoder->bufferLen, start, end - start);
+                decoder->bufferLen += end - start;
+                break;
+            }
+            if (decoder->bufferLen)
+            {
+                if (csonDecoderReserve(decoder, (void **)&decoder->buffer, &decoder->bufferCap,
+                    decoder->bufferLen + (p - start), 1) != 0)
+                {
+                    return csonDecoderError(decoder, base + (start - chunk));
+                }
+                memcpy(decoder->buffer + decoder->bufferLen, start, p - start);
+                ret = csonDecoderToken(decoder, decoder->buffer, decoder->bufferLen + (p - start));
+            }
+            else
+            {
+                ret = csonDecoderToken(decoder, start, p - start);
+            }
+            if (ret != 0)
+            {
+                return -1;
+            }
+        }
+
+        p = csonScanSpace(p, end);
+        if (p == end)
+        {
+            break;
+        }
+        start = p;
+        c = *p;
+        frame = csonDecoderTop(decoder);
+        if (!frame && decoder->done)
+        {
+            if (decoder->ctx && (decoder->ctx->options & CSON_OPTION_REQUIRE_END))
+            {
+                return csonDecoderError(decoder, base + (p - chunk));
+            }
+            break;
+        }
+        if (frame && frame->state != CSON_FRAME_VALUE
+            && (frame->state != CSON_FRAME_FIRST || frame->object))
+        {
+            if (frame->state == CSON_FRAME_NEXT && c == ',')
+            {
+                frame->state = frame->object ? CSON_FRAME_KEY : CSON_FRAME_VALUE;
+            }
+            else if ((frame->state == CSON_FRAME_NEXT || frame->state == CSON_FRAME_FIRST)
+                && c == (frame->object ? '}' : ']'))
+            {
+                csonDecoderPop(decoder);
+            }
+            else if (frame->state == CSON_FRAME_COLON && c == ':')
+            {
+                frame->state = CSON_FRAME_VALUE;
+            }
+            else if ((frame->state == CSON_FRAME_FIRST || frame->state == CSON_FRAME_KEY)
+                && c == '\"')
+            {
+                csonDecoderStart(decoder, CSON_TOKEN_STRING, 1, base + (p - chunk));
+            }
+            else
+            {
+                return csonDecoderError(decoder, base + (p - chunk));
+            }
+            p++;
+            continue;
+        }
+        if (frame && frame->state == CSON_FRAME_FIRST && c == ']')
+        {
+            csonDecoderPop(decoder);
+            p++;
+            continue;
+        }
+        if (c == '{' || c == '[')
+        {
+            ret = csonDecoderContainer(decoder, c);
+            if (ret < 0)
+            {
+                return csonDecoderError(decoder, base + (p - chunk));
+            }
+            if (ret > 0)
+            {
+                p++;
+                continue;
+            }
+            csonDecoderStart(decoder, CSON_TOKEN_RAW, 0, base + (p - chunk));
+        }
+        else if (c == '\"')
+        {
+            csonDecoderStart(decoder, CSON_TOKEN_STRING, 0, base + (p - chunk));
+            p++;
+        }
+        else
+        {
+            csonDecoderStart(decoder, CSON_TOKEN_BARE, 0, base + (p - chunk));
+        }
+    }
+    decoder->offset = base + len;
+    return 0;
+}
+
+
+/**
+ * @brief 结束输入，获取解析结果
+ *
+ * @param decoder 增量解析器，调用后被释放
+ * @return void* 解析得到的对象
+ */
+void *csonDecoderFinish(CsonDecoder *decoder)
+{
+    void *obj;
+    int failed;
+
+    CSON_ASSERT(decoder, return NULL);
+    if (!decoder->failed && decoder->token == CSON_TOKEN_BARE)
+    {
+        csonDecoderToken(decoder, decoder->buffer, decoder->bufferLen);
+    }
+    if (!decoder->done)
+    {
+        csonDecoderError(decoder, decoder->offset);
+    }
+    failed = decoder->failed;
+    obj = decoder->obj;
+    if (!failed)
+    {
+        decoder->obj = NULL;
+        if (decoder->ctx && decoder->ctx->arena)
+        {
+            decoder->arenaOffset = decoder->ctx->arena->offset;
+        }
+    }
+    csonDecoderFree(decoder);
+    CSON_ASSERT(!failed, return NULL);
+    return obj;
+}
+
+
+/**
+ * @brief 放弃解析并释放增量解析器
+ *
+ * @param decoder 增量解析器
+ */
+void csonDecoderFree(CsonDecoder *decoder)
+{
+    CsonContext *ctx;
+
+    if (!decoder)
+    {
+        return;
+    }
+    ctx = decoder->ctx;
+    if (ctx && ctx->arena)
+    {
+        ctx->arena->offset = decoder->arenaOffset;
+    }
+    else
+    {
+        csonFreeObject(ctx, decoder->obj, decoder->model, decoder->modelSize);
+    }
+    while (decoder->depth)
+    {
+        if (decoder->frames[--decoder->depth].seen)
+        {
+            csonCtxFree(ctx, decoder->frames[decoder->depth].seen);
+        }
+    }
+    if (decoder->frames)
+    {
+        csonCtxFree(ctx, decoder->frames);
+    }
+    if (decoder->matches)
+    {
+        csonCtxFree(ctx, decoder->matches);
+    }
+    if (decoder->buffer)
+    {
+        csonCtxFree(ctx, decoder->buffer);
+    }
+    csonCtxFree(ctx, decoder);
+}
+
+
+/**
+ * @brief 获取增量解析器已处理的字节数
+ *
+ * @param decoder 增量解析器
+ * @return size_t 已处理的字节数
+ */
+size_t csonDecoderOffset(CsonDecoder *decoder)
+{
+    CSON_ASSERT(decoder, return 0);
+    return decoder->offset;
+}
+
+
+
+/**
+ * @brief 单精度浮点数转换为编码使用的双精度浮点数
+ *
+ * @param value 单精度浮点数
+ * @return double 与float最短十进制表示对应的双精度浮点数
+ * @note 使cJSON输出的数字与直接输出float时一致，而不是输出float扩展后的全部位数
+ */
+static double csonFloatToDouble(float value)
+{
+    char str[CSON_NUMBER_BUFFER_SIZE];
+    CsonNumber number;
+
+    if (value != value || value - value != 0)
+    {
+        return value;
+    }
+    csonNumberPrintFloat(str, value);
+    csonNumberParse(str, NULL, &number);
+    return number.value;
+}
+
+
+/**
+ * @brief 数字编码编码JSON
+ * 
+ * @param json json对象
+ * @param key key
+ * @param num 数值
+ */
+void csonEncodeNumber(cJSON *json, char *key, double num)
+{
+    if (key)
+    {
+        cJSON_AddNumberToObject(json, key, num);
+    }
+    else
+    {
+        json->type = cJSON_Number;
+        json->valuedouble = num;
+        json->valueint = csonNumberToInt(num);
+    }
+}
+
+
+/**
+ * @brief 字符串编码编码JSON
+ * 
+ * @param json json对象
+ * @param key key
+ * @param str 字符串
+ */
+void csonEncodeString(cJSON *json, char *key, char *str)
+{
+    if (key)
+    {
+        cJSON_AddStringToObject(json, key, str);
+    }
+    else
+    {
+        json->type = cJSON_String;
+        json->valuestring = csonNewString(str);
+    }
+}
+
+
+/**
+ * @brief 字符串视图创建JSON字符串
+ *
+ * @param view 字符串视图
+ * @return cJSON* JSON字符串
+ */
+static cJSON *csonCreateStringView(CsonStringView *view)
+{
+    cJSON *item = cJSON_CreateString("");
+    char *str;
+
+    if (item && view->str && view->len > 0)
+    {
+        str = cson.malloc(view->len + 1);
+        if (str)
+        {
+            memcpy(str, view->str, view->len);
+            str[view->len] = 0;
+            cson.free(item->valuestring);
+            item->valuestring = str;
+        }
+    }
+    return item;
+}
+
+
+/**
+ * @brief CsonList编码成JSON对象
+ * 
+ * @param list CsonList对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return cJSON* 编码得到的JOSN对象
+ */
+cJSON* csonEncodeList(CsonList *list, CsonModel *model, int modelSize)
+{
+    cJSON *root = cJSON_CreateArray();
+    cJSON *item;
+    CsonList *p = list;
+
+    while (p)
+    {
+        if (p->obj)
+        {
+            if (csonIsBasicListModel(model))
+            {
+                item = csonEncodeObject(&(p->obj), model, modelSize);
+            }
+            else
+            {
+                item = csonEncodeObject(p->obj, model, modelSize);
+            }
+            cJSON_AddItemToArray(root, item);
+        }
+        p = p->next;
+    }
+    return root;
+}
+
+
+/**
+ * @brief CsonVector编码成JSON对象
+ *
+ * @param vector CsonVector对象
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ * @return cJSON* 编码得到的JOSN对象
+ * @note 与直接编码一致，所有元素都会输出，为NULL的字符串输出为空字符串
+ */
+cJSON* csonEncodeVector(CsonVector *vector, CsonModel *model, int modelSize)
+{
+    cJSON *root = cJSON_CreateArray();
+    int objSize = csonModelObjSize(model, modelSize);
+    char *ptr = vector->data;
+
+    for (size_t i = 0; ptr && i < vector->len; i++, ptr += objSize)
+    {
+        if (csonIsBasicListModel(model) && model[1].type == CSON_TYPE_STRING)
+        {
+            cJSON_AddItemToArray(root, cJSON_CreateString(*(char **)ptr ? *(char **)ptr : ""));
+        }
+        else
+        {
+            cJSON_AddItemToArray(root, csonEncodeObject(ptr, model, modelSize));
+        }
+    }
+    return root;
+}
+
+
+/**
+ * @brief 数组编码成JSON对象
+ * 
+ * @param base 数组基址
+ * @param elementType 数组元素类型
+ * @param arraySize 数组大小
+ * @return cJSON* 编码得到的JOSN对象
+ */
+cJSON* csonEncodeArray(void *base, CsonType elementType, short arraySize)
+{
+    cJSON *root = cJSON_CreateArray();
+    cJSON *item;
+
+    for (short i = 0; i < arraySize; i++)
+    {
+        switch (elementType)
+        {
+        case CSON_TYPE_CHAR:
+            item = cJSON_CreateNumber(*(char *)((char *)base + (i * sizeof(char))));
+            break;
+        case CSON_TYPE_SHORT:
+            item = cJSON_CreateNumber(*(short *)((char *)base + (i * sizeof(short))));
+            break;
+        case CSON_TYPE_INT:
+            item = cJSON_CreateNumber(*(int *)((char *)base + (i * sizeof(int))));
+            break;
+        case CSON_TYPE_LONG:
+            item = cJSON_CreateNumber(*(long *)((char *)base + (i * sizeof(long))));
+            break;
+        case CSON_TYPE_FLOAT:
+            item = cJSON_CreateNumber(csonFloatToDouble(*(float *)((char *)base + (i * sizeof(float)))));
+            break;
+        case CSON_TYPE_DOUBLE:
+            item = cJSON_CreateNumber(*(double *)((char *)base + (i * sizeof(double))));
+            break;
+        case CSON_TYPE_STRING:
+            item = cJSON_CreateString(*(char **)((char *)base + (i * sizeof(char *))));
+            break;
+        case CSON_TYPE_STRING_VIEW:
+            item = csonCreateStringView((CsonStringView *)((char *)base + (i * sizeof(CsonStringView))));
+            break;
+        default:
+            break;
+        }
+        cJSON_AddItemToArray(root, item);
+    }
+    return root;
+}
+
+
+/**
+ * @brief 编码JSON对象
+ * 
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return cJSON* 编码得到的json对象
+ */
+cJSON* csonEncodeObject(void *obj, CsonModel *model, int modelSize)
+{
+    if (!obj) {
+        return cJSON_CreateNull();
+    }
+    cJSON *root = cJSON_CreateObject();
+
+    for (short i = 0; i < modelSize; i++)
+    {
+        switch (model[i].type)
+        {
+        case CSON_TYPE_CHAR:
+            csonEncodeNumber(root, model[i].key, *(char *)((char *)obj + model[i].offset));
+            break;
+        case CSON_TYPE_SHORT:
+            csonEncodeNumber(root, model[i].key, *(short *)((char *)obj + model[i].offset));
+            break;
+        case CSON_TYPE_INT:
+            csonEncodeNumber(root, model[i].key, *(int *)((char *)obj + model[i].offset));
+            break;
+        case CSON_TYPE_LONG:
+            csonEncodeNumber(root, model[i].key, *(long *)((char *)obj + model[i].offset));
+            break;
+        case CSON_TYPE_FLOAT:
+            csonEncodeNumber(root, model[i].key, csonFloatToDouble(*(float *)((char *)obj + model[i].offset)));
+            break;
+        case CSON_TYPE_DOUBLE:
+            csonEncodeNumber(root, model[i].key, *(double *)((char *)obj + model[i].offset));
+            break;
+        case CSON_TYPE_BOOL:
+            cJSON_AddBoolToObject(root, model[i].key, *(char *)((char *)obj + model[i].offset));
+            break;
+        case CSON_TYPE_STRING:
+            if (*(char **)((char *)obj + model[i].offset))
+            {
+                csonEncodeString(root, model[i].key, *(char **)((char *)obj + model[i].offset));
+            }
+            break;
+        case CSON_TYPE_STRING_VIEW:
+            if (((CsonStringView *)((char *)obj + model[i].offset))->str)
+            {
+                cJSON_AddItemToObject(root, model[i].key, csonCreateStringView(
+                    (CsonStringView *)((char *)obj + model[i].offset)));
+            }
+            break;
+        case CSON_TYPE_LIST:
+            if (*(CsonList **)((char *)obj + model[i].offset))
+            {
+                cJSON_AddItemToObject(root, model[i].key, 
+                    csonEncodeList(*(CsonList **)((char *)obj + model[i].offset),
+                        model[i].param.sub.model, model[i].param.sub.size));
+            }
+            break;
+        case CSON_TYPE_VECTOR:
+            if (((CsonVector *)((char *)obj + model[i].offset))->data)
+            {
+                cJSON_AddItemToObject(root, model[i].key,
+                    csonEncodeVector((CsonVector *)((char *)obj + model[i].offset),
+                        model[i].param.sub.model, model[i].param.sub.size));
+            }
+            break;
+        case CSON_TYPE_STRUCT:
+            if (*(void **)((char *)obj + model[i].offset))
+            {
+                cJSON_AddItemToObject(root, model[i].key, csonEncodeObject(
+                    *(void **)((char *)obj + model[i].offset),
+                    model[i].param.sub.model, model[i].param.sub.size));
+            }
+            break;
+        case CSON_TYPE_ARRAY:
+            cJSON_AddItemToObject(root, model[i].key, csonEncodeArray(
+                (void *)((char *)obj + model[i].offset),
+                model[i].param.array.eleType, csonGetArrayCount(obj, &model[i])));
+            break;
+        case CSON_TYPE_JSON:
+            if (*(char **)((char *)obj + model[i].offset))
+            {
+                cJSON_AddItemToObject(root, model[i].key, 
+                    cJSON_Parse(*(char **)((char *)obj + model[i].offset)));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return root;
+}
+
+
+#define CSON_ENCODE_BUFFER_SIZE     256 /**< 默认编码缓冲大小 */
+#define CSON_STREAM_BUFFER_SIZE     256 /**< 流式编码缓冲大小，至少需要容纳一个数字 */
+
+static int csonPrintObject(CsonBuffer *buffer, void *obj, CsonModel *model, int modelSize,
+                           int depth, int fmt);
+
+
+/**
+ * @brief 输出基本类型值
+ *
+ * @param buffer 缓冲
+ * @param ptr 数据地址
+ * @param type 数据类型
+ * @return int 0 成功 -1 失败
+ */
+static int csonPrintBasic(CsonBuffer *buffer, void *ptr, CsonType type)
+{
+    char *str;
+    CsonStringView *view;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+        return csonPrintInteger(buffer, *(char *)ptr);
+    case CSON_TYPE_SHORT:
+        return csonPrintInteger(buffer, *(short *)ptr);
+    case CSON_TYPE_INT:
+        return csonPrintInteger(buffer, *(int *)ptr);
+    case CSON_TYPE_LONG:
+        return csonPrintInteger(buffer, *(long *)ptr);
+    case CSON_TYPE_FLOAT:
+        return csonPrintFloat(buffer, *(float *)ptr);
+    case CSON_TYPE_DOUBLE:
+        return csonPrintNumber(buffer, *(double *)ptr);
+    case CSON_TYPE_BOOL:
+        return *(char *)ptr ? csonBufferWrite(buffer, "true", 4)
+                            : csonBufferWrite(buffer, "false", 5);
+    case CSON_TYPE_STRING:
+        str = *(char **)ptr;
+        return csonPrintString(buffer, str ? str : "", str ? strlen(str) : 0);
+    case CSON_TYPE_STRING_VIEW:
+        view = (CsonStringView *)ptr;
+        return csonPrintString(buffer, view->str ? view->str : "", view->str ? view->len : 0);
+    default:
+        return 0;
+    }
+}
+
+
+/**
+ * @brief 输出CsonList
+ *
+ * @param buffer 缓冲
+ * @param list 链表
+ * @param model 链表成员数据模型
+ * @param modelSize 链表成员数据模型数量
+ * @param depth 深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+static int csonPrintList(CsonBuffer *buffer, CsonList *list, CsonModel *model, int modelSize,
+                         int depth, int fmt)
+{
+    int basic = csonIsBasicListModel(model);
+    int count = 0;
+    int ret;
+
+    if (csonBufferWrite(buffer, "[", 1) != 0)
+    {
+        return -1;
+    }
+    for (CsonList *p = list; p; p = p->next)
+    {
+        if (!p->obj)
+        {
+            continue;
+        }
+        if (count++ > 0 && csonBufferWrite(buffer, ", ", fmt ? 2 : 1) != 0)
+        {
+            return -1;
+        }
+        if (basic)
+        {
+            ret = csonPrintBasic(buffer, &(p->obj), model[1].type);
+        }
+        else
+        {
+            ret = csonPrintObject(buffer, p->obj, model, modelSize, depth + 1, fmt);
+        }
+        if (ret != 0)
+        {
+            return -1;
+        }
+    }
+    return csonBufferWrite(buffer, "]", 1);
+}
+
+
+/**
+ * @brief 输出CsonVector
+ *
+ * @param buffer 缓冲
+ * @param vector CsonVector
+ * @param model 元素数据模型
+ * @param modelSize 元素数据模型数量
+ * @param depth 深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+static int csonPrintVector(CsonBuffer *buffer, CsonVector *vector, CsonModel *model,
+                           int modelSize, int depth, int fmt)
+{
+    int basic = csonIsBasicListModel(model);
+    int objSize = csonModelObjSize(model, modelSize);
+    char *ptr = vector->data;
+    int ret;
+
+    if (csonBufferWrite(buffer, "[", 1) != 0)
+    {
+        return -1;
+    }
+    for (size_t i = 0; i < vector->len; i++, ptr += objSize)
+    {
+        if (i > 0 && csonBufferWrite(buffer, ", ", fmt ? 2 : 1) != 0)
+        {
+            return -1;
+        }
+        if (basic)
+        {
+            ret = csonPrintBasic(buffer, ptr, model[1].type);
+        }
+        else
+        {
+            ret = csonPrintObject(buffer, ptr, model, modelSize, depth + 1, fmt);
+        }
+        if (ret != 0)
+        {
+            return -1;
+        }
+    }
+    return csonBufferWrite(buffer, "]", 1);
+}
+
+
+/**
+ * @brief 输出数组
+ *
+ * @param buffer 缓冲
+ * @param base 数组基址
+ * @param elementType 数组元素类型
+ * @param arraySize 数组大小
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+static int csonPrintArray(CsonBuffer *buffer, void *base, CsonType elementType, short arraySize,
+                          int fmt)
+{
+    int size = csonTypeSize(elementType);
+
+    if (csonBufferWrite(buffer, "[", 1) != 0)
+    {
+        return -1;
+    }
+    for (short i = 0; size > 0 && i < arraySize; i++)
+    {
+        if ((i > 0 && csonBufferWrite(buffer, ", ", fmt ? 2 : 1) != 0)
+            || csonPrintBasic(buffer, (char *)base + i * size, elementType) != 0)
+        {
+            return -1;
+        }
+    }
+    return csonBufferWrite(buffer, "]", 1);
+}
+
+
+/**
+ * @brief 输出子json
+ *
+ * @param buffer 缓冲
+ * @param json json字符串
+ * @param depth 深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ * @note 与cJSON一致，子json会被重新解析并按照当前格式输出，
+ *       上下文设置了`CSON_OPTION_RAW_JSON`时原样输出，不重新格式化
+ */
+static int csonPrintJson(CsonBuffer *buffer, const char *json, int depth, int fmt)
+{
+    CsonParser parser = {.pos = json, .end = json + strlen(json)};
+    const char *start;
+
+    csonParserSkip(&parser);
+    if (buffer->ctx && (buffer->ctx->options & CSON_OPTION_RAW_JSON))
+    {
+        start = parser.pos;
+        csonParserSkipValue(&parser);
+        return csonBufferWrite(buffer, start, parser.pos - start);
+    }
+    return csonReprintValue(&parser, buffer, depth, fmt);
+}
+
+
+/**
+ * @brief 子json是否可以输出
+ *
+ * @param json json字符串
+ * @return int 是否可以输出
+ */
+static int csonIsValidJson(const char *json)
+{
+    CsonParser parser = {.pos = json, .end = json + strlen(json)};
+
+    csonParserSkip(&parser);
+    return csonParserSkipValue(&parser) == 0;
+}
+
+
+/**
+ * @brief 输出对象成员的键值
+ *
+ * @param buffer 缓冲
+ * @param key 键值
+ * @param len 键值长度
+ * @param index 成员序号，不为0时先输出分隔符
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+static int csonPrintKey(CsonBuffer *buffer, const char *key, int len, int index,
+                        int depth, int fmt)
+{
+    if ((index > 0 && csonBufferWrite(buffer, ",\n", fmt ? 2 : 1) != 0)
+        || (fmt && csonBufferFill(buffer, '\t', depth + 1) != 0)
+        || csonPrintString(buffer, key, len) != 0
+        || csonBufferWrite(buffer, ":\t", fmt ? 2 : 1) != 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 对象成员是否不输出
+ *
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @return int 是否不输出
+ * @note 值为NULL的字符串、链表、结构体和子json不会被输出
+ */
+static int csonPrintSkipped(void *obj, CsonModel *field)
+{
+    void *ptr = (char *)obj + field->offset;
+
+    switch (field->type)
+    {
+    case CSON_TYPE_OBJ:
+        return 1;
+    case CSON_TYPE_STRING:
+    case CSON_TYPE_LIST:
+    case CSON_TYPE_STRUCT:
+        return !*(void **)ptr;
+    case CSON_TYPE_JSON:
+        return !*(char **)ptr || !csonIsValidJson(*(char **)ptr);
+    case CSON_TYPE_STRING_VIEW:
+        return !((CsonStringView *)ptr)->str;
+    case CSON_TYPE_VECTOR:
+        return !((CsonVector *)ptr)->data;
+    default:
+        return 0;
+    }
+}
+
+
+/**
+ * @brief 输出对象成员
+ *
+ * @param buffer 缓冲
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @param count 已输出的成员数量，输出成员后加1
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ * @note 值为NULL的字符串、链表、结构体和子json不会被输出
+ */
+static int csonPrintMember(CsonBuffer *buffer, void *obj, CsonModel *field, int *count,
+                           int depth, int fmt)
+{
+    void *ptr = (char *)obj + field->offset;
+
+    if (csonPrintSkipped(obj, field))
+    {
+        return 0;
+    }
+    if (csonPrintKey(buffer, field->key, strlen(field->key), (*count)++, depth, fmt) != 0)
+    {
+        return -1;
+    }
+    switch (field->type)
+    {
+    case CSON_TYPE_LIST:
+        return csonPrintList(buffer, *(CsonList **)ptr,
+            field->param.sub.model, field->param.sub.size, depth + 1, fmt);
+    case CSON_TYPE_VECTOR:
+        return csonPrintVector(buffer, (CsonVector *)ptr,
+            field->param.sub.model, field->param.sub.size, depth + 1, fmt);
+    case CSON_TYPE_STRUCT:
+        return csonPrintObject(buffer, *(void **)ptr,
+            field->param.sub.model, field->param.sub.size, depth + 1, fmt);
+    case CSON_TYPE_ARRAY:
+        return csonPrintArray(buffer, ptr,
+            field->param.array.eleType, csonGetArrayCount(obj, field), fmt);
+    case CSON_TYPE_JSON:
+        return csonPrintJson(buffer, *(char **)ptr, depth + 1, fmt);
+    default:
+        return csonPrintBasic(buffer, ptr, field->type);
+    }
+}
+
+
+/**
+ * @brief 输出对象结束符
+ *
+ * @param buffer 缓冲
+ * @param count 已输出的成员数量
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+static int csonPrintObjectEnd(CsonBuffer *buffer, int count, int depth, int fmt)
+{
+    if (count == 0)
+    {
+        if (fmt && csonBufferFill(buffer, '\t', depth - 1) != 0)
+        {
+            return -1;
+        }
+    }
+    else if (fmt && (csonBufferWrite(buffer, "\n", 1) != 0
+        || csonBufferFill(buffer, '\t', depth) != 0))
+    {
+        return -1;
+    }
+    return csonBufferWrite(buffer, "}", 1);
+}
+
+
+/**
+ * @brief 输出对象
+ *
+ * @param buffer 缓冲
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param depth 深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ * @note 输出与cJSON打印`csonEncodeObject`生成的json对象一致，
+ *       值为NULL的字符串、链表、结构体和子json不会被输出
+ */
+static int csonPrintObject(CsonBuffer *buffer, void *obj, CsonModel *model, int modelSize,
+                           int depth, int fmt)
+{
+    int count = 0;
+
+    if (!obj)
+    {
+        return csonBufferWrite(buffer, "null", 4);
+    }
+    if (csonBufferWrite(buffer, "{\n", fmt ? 2 : 1) != 0)
+    {
+        return -1;
+    }
+    for (short i = 0; i < modelSize; i++)
+    {
+        if (csonPrintMember(buffer, obj, &model[i], &count, depth, fmt) != 0)
+        {
+            return -1;
+        }
+    }
+    return csonPrintObjectEnd(buffer, count, depth, fmt);
+}
+
+
+/**
+ * @brief 直接编码成json字符串
+ *
+ * @param ctx 内存分配上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param bufferSize 初始缓冲大小
+ * @param fmt 是否格式化json字符串
+ * @return char* 编码得到的json字符串
+ * @note 根据数据模型直接将结构体输出为json文本，不生成中间的cJSON树
+ */
+static char* csonEncodeBuffered(CsonContext *ctx, void *obj, CsonModel *model, int modelSize,
+                                int bufferSize, int fmt)
+{
+    CsonBuffer buffer = {0};
+
+    buffer.ctx = ctx;
+    buffer.length = bufferSize > 0 ? bufferSize : CSON_ENCODE_BUFFER_SIZE;
+    buffer.buffer = csonCtxMalloc(ctx, buffer.length);
+    CSON_ASSERT(buffer.buffer, return NULL);
+    buffer.buffer[0] = 0;
+    if (csonPrintObject(&buffer, obj, model, modelSize, 0, fmt) != 0)
+    {
+        if (buffer.buffer)
+        {
+            csonCtxFree(ctx, buffer.buffer);
+        }
+        return NULL;
+    }
+    return buffer.buffer;
+}
+
+
+/**
+ * @brief 编码成json字符串
+ * 
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param bufferSize 分配给json字符串的空间大小
+ * @param fmt 是否格式化json字符串
+ * @return char* 编码得到的json字符串
+ */
+char* csonEncode(void *obj, CsonModel *model, int modelSize, int bufferSize, int fmt)
+{
+    return csonEncodeBuffered(NULL, obj, model, modelSize, bufferSize, fmt);
+}
+
+
+/**
+ * @brief 编码成json字符串
+ * 
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return char* 编码得到的json字符串
+ */
+char* csonEncodeUnformatted(void *obj, CsonModel *model, int modelSize)
+{
+    return csonEncodeBuffered(NULL, obj, model, modelSize, CSON_ENCODE_BUFFER_SIZE, 0);
+}
+
+
+/**
+ * @brief 使用上下文编码成json字符串
+ *
+ * @param ctx 内存分配上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param bufferSize 初始缓冲大小
+ * @param fmt 是否格式化json字符串
+ * @return char* 编码得到的json字符串
+ */
+char* csonEncodeCtx(CsonContext *ctx, void *obj, CsonModel *model, int modelSize,
+                    int bufferSize, int fmt)
+{
+    return csonEncodeBuffered(ctx, obj, model, modelSize, bufferSize, fmt);
+}
+
+
+/**
+ * @brief 编码json字符串到指定缓冲区
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param buf 输出缓冲区，可为NULL
+ * @param cap 输出缓冲区大小
+ * @param written 编码得到的json字符串长度，不包含结束符
+ * @return int 0 成功 -1 缓冲区空间不足
+ * @note 编码过程不分配内存，缓冲区空间不足时，`written`仍然返回完整的json长度，
+ *       使用不小于`written + 1`的缓冲区重新编码即可
+ */
+int csonEncodeInto(void *obj, CsonModel *model, int modelSize,
+                   char *buf, size_t cap, size_t *written)
+{
+    CsonBuffer buffer = {0};
+
+    buffer.buffer = cap > 0 ? buf : NULL;
+    buffer.length = cap > INT_MAX ? INT_MAX : (int)cap;
+    buffer.fixed = 1;
+    if (buffer.buffer)
+    {
+        buffer.buffer[0] = 0;
+    }
+    csonPrintObject(&buffer, obj, model, modelSize, 0, 0);
+    if (written)
+    {
+        *written = buffer.offset;
+    }
+    return buffer.offset < buffer.length ? 0 : -1;
+}
+
+
+/**
+ * @brief 编码json字符串并通过输出函数输出
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param write 输出函数
+ * @param param 输出函数参数
+ * @param fmt 是否格式化json字符串
+ * @return int 0 成功 -1 失败
+ * @note 编码过程不分配内存，只使用栈上`CSON_STREAM_BUFFER_SIZE`大小的缓冲，
+ *       输出内容与`csonEncode`一致，不包含结束符
+ */
+int csonEncodeStream(void *obj, CsonModel *model, int modelSize,
+                     CsonWriteFunc write, void *param, int fmt)
+{
+    char data[CSON_STREAM_BUFFER_SIZE];
+    CsonBuffer buffer = {0};
+
+    CSON_ASSERT(write, return -1);
+    buffer.buffer = data;
+    buffer.length = CSON_STREAM_BUFFER_SIZE;
+    buffer.write = write;
+    buffer.param = param;
+    data[0] = 0;
+    if (csonPrintObject(&buffer, obj, model, modelSize, 0, fmt) != 0
+        || csonBufferFlush(&buffer) != 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 输出null
+ *
+ * @param writer 输出器
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteNull(CsonWriter *writer)
+{
+    return csonBufferWrite(writer, "null", 4);
+}
+
+
+/**
+ * @brief 输出对象开始符
+ *
+ * @param writer 输出器
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteObjectBegin(CsonWriter *writer, int fmt)
+{
+    return csonBufferWrite(writer, "{\n", fmt ? 2 : 1);
+}
+
+
+/**
+ * @brief 输出对象成员的键值
+ *
+ * @param writer 输出器
+ * @param key 键值
+ * @param len 键值长度
+ * @param index 成员序号，不为0时先输出分隔符
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteKey(CsonWriter *writer, const char *key, int len, int index, int depth, int fmt)
+{
+    return csonPrintKey(writer, key, len, index, depth, fmt);
+}
+
+
+/**
+ * @brief 输出基本类型值
+ *
+ * @param writer 输出器
+ * @param ptr 数据地址
+ * @param type 数据类型
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteValue(CsonWriter *writer, void *ptr, CsonType type)
+{
+    return csonPrintBasic(writer, ptr, type);
+}
+
+
+/**
+ * @brief 按成员数据模型输出成员
+ *
+ * @param writer 输出器
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @param count 已输出的成员数量，输出成员后加1
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteMember(CsonWriter *writer, void *obj, CsonModel *field, int *count,
+                    int depth, int fmt)
+{
+    return csonPrintMember(writer, obj, field, count, depth, fmt);
+}
+
+
+/**
+ * @brief 输出对象结束符
+ *
+ * @param writer 输出器
+ * @param count 已输出的成员数量
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteObjectEnd(CsonWriter *writer, int count, int depth, int fmt)
+{
+    return csonPrintObjectEnd(writer, count, depth, fmt);
+}
+
+
+/**
+ * @brief 使用生成的输出函数编码成json字符串
+ *
+ * @param ctx 内存分配上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param print 生成的输出函数
+ * @param bufferSize 初始缓冲大小
+ * @param fmt 是否格式化json字符串
+ * @return char* 编码得到的json字符串
+ */
+char *csonEncodeGenerated(CsonContext *ctx, void *obj, CsonPrintFunc print,
+                          int bufferSize, int fmt)
+{
+    CsonBuffer buffer = {0};
+
+    CSON_ASSERT(print, return NULL);
+    buffer.ctx = ctx;
+    buffer.length = bufferSize > 0 ? bufferSize : CSON_ENCODE_BUFFER_SIZE;
+    buffer.buffer = csonCtxMalloc(ctx, buffer.length);
+    CSON_ASSERT(buffer.buffer, return NULL);
+    buffer.buffer[0] = 0;
+    if (print(&buffer, obj, 0, fmt) != 0)
+    {
+        if (buffer.buffer)
+        {
+            csonCtxFree(ctx, buffer.buffer);
+        }
+        return NULL;
+    }
+    return buffer.buffer;
+}
+
+
+/**
+ * @brief MessagePack值类型
+ *
+ */
+typedef enum
+{
+    CSON_MSGPACK_NIL = 0,               /**< nil */
+    CSON_MSGPACK_BOOL,                  /**< 布尔值 */
+    CSON_MSGPACK_INT,                   /**< 整数 */
+    CSON_MSGPACK_FLOAT,                 /**< 单精度浮点数 */
+    CSON_MSGPACK_DOUBLE,                /**< 双精度浮点数，超出int64范围的无符号整数也按浮点数处理 */
+    CSON_MSGPACK_STR,                   /**< 字符串 */
+    CSON_MSGPACK_BIN,                   /**< 二进制数据 */
+    CSON_MSGPACK_EXT,                   /**< 扩展类型 */
+    CSON_MSGPACK_ARRAY,                 /**< 数组 */
+    CSON_MSGPACK_MAP,                   /**< 映射 */
+} CsonMsgpackType;
+
+
+/**
+ * @brief MessagePack值
+ *
+ * @note 数组和映射只读取头部，元素需要继续读取
+ */
+typedef struct
+{
+    CsonMsgpackType type;               /**< 值类型 */
+    int64_t integer;                    /**< 整数值，浮点数为转换后的整数，布尔值为0或1 */
+    double number;                      /**< 浮点值 */
+    const char *str;                    /**< 字符串、二进制数据和扩展类型的内容 */
+    size_t len;                         /**< 内容长度，数组和映射为元素数量 */
+} CsonMsgpackValue;
+
+
+static int csonMsgpackPrintObject(CsonBuffer *buffer, void *obj, CsonModel *model, int modelSize);
+static int csonMsgpackObject(CsonParser *parser, CsonMsgpackValue *value,
+                             CsonModel *model, int modelSize, void **obj);
+static int csonMsgpackFields(CsonParser *parser, CsonMsgpackValue *value, void *obj,
+                             CsonModel *model, int modelSize);
+
+
+/**
+ * @brief 输出MessagePack类型字节和大端序数据
+ *
+ * @param buffer 缓冲
+ * @param type 类型字节
+ * @param value 数据
+ * @param size 数据字节数
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackWriteBig(CsonBuffer *buffer, unsigned char type, uint64_t value, int size)
+{
+    char data[9];
+
+    data[0] = (char)type;
+    for (int i = size; i > 0; i--)
+    {
+        data[i] = (char)(value & 0xFF);
+        value >>= 8;
+    }
+    return csonBufferWrite(buffer, data, size + 1);
+}
+
+
+/**
+ * @brief 输出MessagePack整数
+ *
+ * @param buffer 缓冲
+ * @param value 整数
+ * @return int 0 成功 -1 失败
+ * @note 使用能容纳数值的最短格式
+ */
+static int csonMsgpackWriteInt(CsonBuffer *buffer, int64_t value)
+{
+    if (value >= 0)
+    {
+        if (value < 0x80)
+        {
+            return csonMsgpackWriteBig(buffer, (unsigned char)value, 0, 0);
+        }
+        return value <= UINT8_MAX ? csonMsgpackWriteBig(buffer, 0xCC, value, 1)
+            : value <= UINT16_MAX ? csonMsgpackWriteBig(buffer, 0xCD, value, 2)
+            : value <= UINT32_MAX ? csonMsgpackWriteBig(buffer, 0xCE, value, 4)
+            : csonMsgpackWriteBig(buffer, 0xCF, value, 8);
+    }
+    if (value >= -32)
+    {
+        return csonMsgpackWriteBig(buffer, (unsigned char)(value & 0xFF), 0, 0);
+    }
+    return value >= INT8_MIN ? csonMsgpackWriteBig(buffer, 0xD0, (uint64_t)value, 1)
+        : value >= INT16_MIN ? csonMsgpackWriteBig(buffer, 0xD1, (uint64_t)value, 2)
+        : value >= INT32_MIN ? csonMsgpackWriteBig(buffer, 0xD2, (uint64_t)value, 4)
+        : csonMsgpackWriteBig(buffer, 0xD3, (uint64_t)value, 8);
+}
+
+
+/**
+ * @brief 输出MessagePack单精度浮点数
+ *
+ * @param buffer 缓冲
+ * @param value 浮点数
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackWriteFloat(CsonBuffer *buffer, float value)
+{
+    uint32_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    return csonMsgpackWriteBig(buffer, 0xCA, bits, 4);
+}
+
+
+/**
+ * @brief 输出MessagePack双精度浮点数
+ *
+ * @param buffer 缓冲
+ * @param value 浮点数
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackWriteDouble(CsonBuffer *buffer, double value)
+{
+    uint64_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    return csonMsgpackWriteBig(buffer, 0xCB, bits, 8);
+}
+
+
+/**
+ * @brief 输出MessagePack字符串
+ *
+ * @param buffer 缓冲
+ * @param str 字符串
+ * @param len 字符串长度
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackWriteStr(CsonBuffer *buffer, const char *str, size_t len)
+{
+    int ret = len < 32 ? csonMsgpackWriteBig(buffer, (unsigned char)(0xA0 | len), 0, 0)
+        : len <= UINT8_MAX ? csonMsgpackWriteBig(buffer, 0xD9, len, 1)
+        : len <= UINT16_MAX ? csonMsgpackWriteBig(buffer, 0xDA, len, 2)
+        : csonMsgpackWriteBig(buffer, 0xDB, len, 4);
+
+    return ret != 0 ? -1 : csonBufferWrite(buffer, str, (int)len);
+}
+
+
+/**
+ * @brief 输出MessagePack数组或映射头部
+ *
+ * @param buffer 缓冲
+ * @param map 是否为映射
+ * @param count 元素数量
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackWriteContainer(CsonBuffer *buffer, int map, size_t count)
+{
+    if (count < 16)
+    {
+        return csonMsgpackWriteBig(buffer, (unsigned char)((map ? 0x80 : 0x90) | count), 0, 0);
+    }
+    return count <= UINT16_MAX ? csonMsgpackWriteBig(buffer, map ? 0xDE : 0xDC, count, 2)
+        : csonMsgpackWriteBig(buffer, map ? 0xDF : 0xDD, count, 4);
+}
+
+
+/**
+ * @brief 输出基本类型值
+ *
+ * @param buffer 缓冲
+ * @param ptr 值地址
+ * @param type 数据类型
+ * @return int 0 成功 -1 失败
+ * @note 不支持的类型输出为nil
+ */
+static int csonMsgpackPrintBasic(CsonBuffer *buffer, void *ptr, CsonType type)
+{
+    char *str;
+    CsonStringView *view;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+        return csonMsgpackWriteInt(buffer, *(char *)ptr);
+    case CSON_TYPE_SHORT:
+        return csonMsgpackWriteInt(buffer, *(short *)ptr);
+    case CSON_TYPE_INT:
+        return csonMsgpackWriteInt(buffer, *(int *)ptr);
+    case CSON_TYPE_LONG:
+        return csonMsgpackWriteInt(buffer, *(long *)ptr);
+    case CSON_TYPE_FLOAT:
+        return csonMsgpackWriteFloat(buffer, *(float *)ptr);
+    case CSON_TYPE_DOUBLE:
+        return csonMsgpackWriteDouble(buffer, *(double *)ptr);
+    case CSON_TYPE_BOOL:
+        return csonMsgpackWriteBig(buffer, *(char *)ptr ? 0xC3 : 0xC2, 0, 0);
+    case CSON_TYPE_STRING:
+        str = *(char **)ptr;
+        return csonMsgpackWriteStr(buffer, str ? str : "", str ? strlen(str) : 0);
+    case CSON_TYPE_STRING_VIEW:
+        view = (CsonStringView *)ptr;
+        return csonMsgpackWriteStr(buffer, view->str ? view->str : "", view->str ? view->len : 0);
+    default:
+        return csonMsgpackWriteBig(buffer, 0xC0, 0, 0);
+    }
+}
+
+
+/**
+ * @brief 输出CsonList
+ *
+ * @param buffer 缓冲
+ * @param list 链表
+ * @param model 链表成员数据模型
+ * @param modelSize 链表成员数据模型数量
+ * @return int 0 成功 -1 失败
+ * @note 与json编码一致，obj为NULL的节点不输出
+ */
+static int csonMsgpackPrintList(CsonBuffer *buffer, CsonList *list, CsonModel *model, int modelSize)
+{
+    int basic = csonIsBasicListModel(model);
+    size_t count = 0;
+    int ret;
+
+    for (CsonList *p = list; p; p = p->next)
+    {
+        count += p->obj ? 1 : 0;
+    }
+    if (csonMsgpackWriteContainer(buffer, 0, count) != 0)
+    {
+        return -1;
+    }
+    for (CsonList *p = list; p; p = p->next)
+    {
+        if (!p->obj)
+        {
+            continue;
+        }
+        ret = basic ? csonMsgpackPrintBasic(buffer, &(p->obj), model[1].type)
+            : csonMsgpackPrintObject(buffer, p->obj, model, modelSize);
+        if (ret != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 输出CsonVector
+ *
+ * @param buffer 缓冲
+ * @param vector CsonVector
+ * @param model 元素数据模型
+ * @param modelSize 元素数据模型数量
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackPrintVector(CsonBuffer *buffer, CsonVector *vector, CsonModel *model,
+                                  int modelSize)
+{
+    int basic = csonIsBasicListModel(model);
+    int objSize = csonModelObjSize(model, modelSize);
+    char *ptr = vector->data;
+    int ret;
+
+    if (csonMsgpackWriteContainer(buffer, 0, vector->len) != 0)
+    {
+        return -1;
+    }
+    for (size_t i = 0; i < vector->len; i++, ptr += objSize)
+    {
+        ret = basic ? csonMsgpackPrintBasic(buffer, ptr, model[1].type)
+            : csonMsgpackPrintObject(buffer, ptr, model, modelSize);
+        if (ret != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 输出数组
+ *
+ * @param buffer 缓冲
+ * @param base 数组基址
+ * @param elementType 数组元素类型
+ * @param arraySize 数组大小
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackPrintArray(CsonBuffer *buffer, void *base, CsonType elementType,
+                                 short arraySize)
+{
+    int size = csonTypeSize(elementType);
+
+    if (csonMsgpackWriteContainer(buffer, 0, size > 0 ? arraySize : 0) != 0)
+    {
+        return -1;
+    }
+    for (short i = 0; size > 0 && i < arraySize; i++)
+    {
+        if (csonMsgpackPrintBasic(buffer, (char *)base + i * size, elementType) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 将json字符串转换为MessagePack字符串输出
+ *
+ * @param parser 解析器，位于字符串开始的'"'
+ * @param buffer 缓冲
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackConvertString(CsonParser *parser, CsonBuffer *buffer)
+{
+    const char *str;
+    char *unescaped;
+    int len, escaped, ret;
+
+    if (csonParserString(parser, &str, &len, &escaped) != 0)
+    {
+        return -1;
+    }
+    if (!escaped)
+    {
+        return csonMsgpackWriteStr(buffer, str, len);
+    }
+    unescaped = csonCtxMalloc(buffer->ctx, len + 1);
+    if (!unescaped)
+    {
+        return -1;
+    }
+    ret = csonMsgpackWriteStr(buffer, unescaped, csonUnescape(str, len, unescaped));
+    csonCtxFree(buffer->ctx, unescaped);
+    return ret;
+}
+
+
+/**
+ * @brief 将json值转换为MessagePack输出
+ *
+ * @param parser 解析器
+ * @param buffer 缓冲
+ * @return int 0 成功 -1 失败
+ * @note 整数输出为MessagePack整数，其余数字输出为双精度浮点数
+ */
+static int csonMsgpackConvert(CsonParser *parser, CsonBuffer *buffer)
+{
+    CsonNumber number;
+    size_t count;
+    char c = csonParserPeek(parser);
+
+    if (c == '\"')
+    {
+        return csonMsgpackConvertString(parser, buffer);
+    }
+    if (c == '[' || c == '{')
+    {
+        if (csonParserCount(parser, &count) != 0
+            || csonMsgpackWriteContainer(buffer, c == '{', count) != 0)
+        {
+            return -1;
+        }
+        parser->pos++;
+        csonParserSkip(parser);
+        for (size_t i = 0; i < count; i++)
+        {
+            csonParserSkip(parser);
+            if (c == '{')
+            {
+                if (csonMsgpackConvertString(parser, buffer) != 0)
+                {
+                    return -1;
+                }
+                csonParserSkip(parser);
+                parser->pos++;
+                csonParserSkip(parser);
+            }
+            if (csonMsgpackConvert(parser, buffer) != 0)
+            {
+                return -1;
+            }
+            csonParserSkip(parser);
+            parser->pos++;
+        }
+        if (count == 0)
+        {
+            parser->pos++;
+        }
+        return 0;
+    }
+    if (csonParserLiteral(parser, "true", 4))
+    {
+        return csonMsgpackWriteBig(buffer, 0xC3, 0, 0);
+    }
+    if (csonParserLiteral(parser, "false", 5))
+    {
+        return csonMsgpackWriteBig(buffer, 0xC2, 0, 0);
+    }
+    if (csonParserLiteral(parser, "null", 4))
+    {
+        return csonMsgpackWriteBig(buffer, 0xC0, 0, 0);
+    }
+    if (csonParserIsNumber(parser))
+    {
+        csonParserNumber(parser, &number);
+        return number.isInteger ? csonMsgpackWriteInt(buffer, number.integer)
+                                : csonMsgpackWriteDouble(buffer, number.value);
+    }
+    return csonParserError(parser);
+}
+
+
+/**
+ * @brief 输出子json
+ *
+ * @param buffer 缓冲
+ * @param json json字符串
+ * @return int 0 成功 -1 失败
+ * @note 子json被转换为对应的MessagePack值
+ */
+static int csonMsgpackPrintJson(CsonBuffer *buffer, const char *json)
+{
+    CsonParser parser = {.pos = json, .end = json + strlen(json)};
+
+    csonParserSkip(&parser);
+    return csonMsgpackConvert(&parser, buffer);
+}
+
+
+/**
+ * @brief 输出对象成员的值
+ *
+ * @param buffer 缓冲
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackPrintMember(CsonBuffer *buffer, void *obj, CsonModel *field)
+{
+    void *ptr = (char *)obj + field->offset;
+
+    switch (field->type)
+    {
+    case CSON_TYPE_LIST:
+        return csonMsgpackPrintList(buffer, *(CsonList **)ptr,
+            field->param.sub.model, field->param.sub.size);
+    case CSON_TYPE_VECTOR:
+        return csonMsgpackPrintVector(buffer, (CsonVector *)ptr,
+            field->param.sub.model, field->param.sub.size);
+    case CSON_TYPE_STRUCT:
+        return csonMsgpackPrintObject(buffer, *(void **)ptr,
+            field->param.sub.model, field->param.sub.size);
+    case CSON_TYPE_ARRAY:
+        return csonMsgpackPrintArray(buffer, ptr,
+            field->param.array.eleType, csonGetArrayCount(obj, field));
+    case CSON_TYPE_JSON:
+        return csonMsgpackPrintJson(buffer, *(char **)ptr);
+    default:
+        return csonMsgpackPrintBasic(buffer, ptr, field->type);
+    }
+}
+
+
+/**
+ * @brief 输出对象
+ *
+ * @param buffer 缓冲
+ * @param obj 对象，为NULL时输出nil
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return int 0 成功 -1 失败
+ * @note 对象输出为以成员键值为键的映射，输出的成员与json编码一致
+ */
+static int csonMsgpackPrintObject(CsonBuffer *buffer, void *obj, CsonModel *model, int modelSize)
+{
+    size_t count = 0;
+
+    if (!obj)
+    {
+        return csonMsgpackWriteBig(buffer, 0xC0, 0, 0);
+    }
+    for (short i = 0; i < modelSize; i++)
+    {
+        count += csonPrintSkipped(obj, &model[i]) ? 0 : 1;
+    }
+    if (csonMsgpackWriteContainer(buffer, 1, count) != 0)
+    {
+        return -1;
+    }
+    for (short i = 0; i < modelSize; i++)
+    {
+        if (csonPrintSkipped(obj, &model[i]))
+        {
+            continue;
+        }
+        if (csonMsgpackWriteStr(buffer, model[i].key, strlen(model[i].key)) != 0
+            || csonMsgpackPrintMember(buffer, obj, &model[i]) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 使用上下文编码成MessagePack
+ *
+ * @param ctx 内存分配上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param len 编码得到的数据长度
+ * @return char* 编码得到的数据
+ */
+char* csonEncodeMsgpackCtx(CsonContext *ctx, void *obj, CsonModel *model, int modelSize,
+                           size_t *len)
+{
+    CsonBuffer buffer = {0};
+
+    CSON_ASSERT(model && len, return NULL);
+    buffer.ctx = ctx;
+    buffer.length = CSON_ENCODE_BUFFER_SIZE;
+    buffer.buffer = csonCtxMalloc(ctx, buffer.length);
+    CSON_ASSERT(buffer.buffer, return NULL);
+    if (csonMsgpackPrintObject(&buffer, obj, model, modelSize) != 0)
+    {
+        if (buffer.buffer)
+        {
+            csonCtxFree(ctx, buffer.buffer);
+        }
+        return NULL;
+    }
+    *len = buffer.offset;
+    return buffer.buffer;
+}
+
+
+/**
+ * @brief 编码成MessagePack
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param len 编码得到的数据长度
+ * @return char* 编码得到的数据
+ */
+char* csonEncodeMsgpack(void *obj, CsonModel *model, int modelSize, size_t *len)
+{
+    return csonEncodeMsgpackCtx(NULL, obj, model, modelSize, len);
+}
+
+
+/**
+ * @brief 编码成MessagePack并通过输出函数输出
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param write 输出函数
+ * @param param 输出函数参数
+ * @return int 0 成功 -1 失败
+ * @note 只使用栈上`CSON_STREAM_BUFFER_SIZE`大小的缓冲
+ */
+int csonEncodeMsgpackStream(void *obj, CsonModel *model, int modelSize,
+                            CsonWriteFunc write, void *param)
+{
+    char data[CSON_STREAM_BUFFER_SIZE];
+    CsonBuffer buffer = {0};
+
+    CSON_ASSERT(model && write, return -1);
+    buffer.buffer = data;
+    buffer.length = CSON_STREAM_BUFFER_SIZE;
+    buffer.write = write;
+    buffer.param = param;
+    if (csonMsgpackPrintObject(&buffer, obj, model, modelSize) != 0
+        || csonBufferFlush(&buffer) != 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 读取大端序数据
+ *
+ * @param parser 解析器
+ * @param size 数据字节数
+ * @param value 读取的数据
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackReadBig(CsonParser *parser, int size, uint64_t *value)
+{
+    const unsigned char *data = (const unsigned char *)parser->pos;
+
+    if (parser->end - parser->pos < size)
+    {
+        return csonParserError(parser);
+    }
+    *value = 0;
+    for (int i = 0; i < size; i++)
+    {
+        *value = (*value << 8) | data[i];
+    }
+    parser->pos += size;
+    return 0;
+}
+
+
+/**
+ * @brief 读取MessagePack值
+ *
+ * @param parser 解析器
+ * @param value 读取的值
+ * @return int 0 成功 -1 失败
+ * @note 字符串、二进制数据和扩展类型指向输入中的内容，
+ *       数组和映射只读取头部，元素数量超过剩余数据长度时解析失败
+ */
+static int csonMsgpackNext(CsonParser *parser, CsonMsgpackValue *value)
+{
+    const char *start = parser->pos;
+    unsigned char c;
+    uint64_t data = 0;
+    int size = 0;
+    float f;
+    uint32_t bits;
+
+    if (parser->pos >= parser->end)
+    {
+        return csonParserError(parser);
+    }
+    c = (unsigned char)*parser->pos++;
+    value->integer = 0;
+    value->number = 0;
+    value->str = NULL;
+    value->len = 0;
+    if (c <= 0x7F || c >= 0xE0)
+    {
+        value->type = CSON_MSGPACK_INT;
+        value->integer = c <= 0x7F ? c : (int64_t)c - 0x100;
+        value->number = (double)value->integer;
+        return 0;
+    }
+    if (c <= 0x9F)
+    {
+        value->type = c <= 0x8F ? CSON_MSGPACK_MAP : CSON_MSGPACK_ARRAY;
+        data = c & 0x0F;
+    }
+    else if (c <= 0xBF)
+    {
+        value->type = CSON_MSGPACK_STR;
+        data = c & 0x1F;
+    }
+    else
+    {
+        switch (c)
+        {
+        case 0xC0:
+            value->type = CSON_MSGPACK_NIL;
+            return 0;
+        case 0xC2:
+        case 0xC3:
+            value->type = CSON_MSGPACK_BOOL;
+            value->integer = c & 1;
+            return 0;
+        case 0xC4: case 0xC5: case 0xC6:
+            value->type = CSON_MSGPACK_BIN;
+            size = 1 << (c - 0xC4);
             break;
-        case CSON_TYPE_INT:
-            item = cJSON_CreateNumber(*(int *)((int)base + (i * sizeof(int))));
+        case 0xC7: case 0xC8: case 0xC9:
+            value->type = CSON_MSGPACK_EXT;
+            size = 1 << (c - 0xC7);
             break;
-        case CSON_TYPE_LONG:
-            item = cJSON_CreateNumber(*(long *)((int)base + (i * sizeof(int))));
+        case 0xCA:
+        case 0xCB:
+            if (csonMsgpackReadBig(parser, c == 0xCA ? 4 : 8, &data) != 0)
+            {
+                parser->pos = start;
+                return -1;
+            }
+            if (c == 0xCA)
+            {
+                bits = (uint32_t)data;
+                memcpy(&f, &bits, sizeof(f));
+                value->type = CSON_MSGPACK_FLOAT;
+                value->number = f;
+            }
+            else
+            {
+                value->type = CSON_MSGPACK_DOUBLE;
+                memcpy(&value->number, &data, sizeof(double));
+            }
+            value->integer = csonNumberToInt64(value->number);
+            return 0;
+        case 0xCC: case 0xCD: case 0xCE: case 0xCF:
+        case 0xD0: case 0xD1: case 0xD2: case 0xD3:
+            size = 1 << ((c - 0xCC) & 3);
+            if (csonMsgpackReadBig(parser, size, &data) != 0)
+            {
+                parser->pos = start;
+                return -1;
+            }
+            value->type = CSON_MSGPACK_INT;
+            if (c >= 0xD0)
+            {
+                value->integer = size < 8 && (data >> (size * 8 - 1))
+                    ? (int64_t)data - ((int64_t)1 << (size * 8)) : (int64_t)data;
+                value->number = (double)value->integer;
+            }
+            else if (data > INT64_MAX)
+            {
+                value->type = CSON_MSGPACK_DOUBLE;
+                value->number = (double)data;
+                value->integer = INT64_MAX;
+            }
+            else
+            {
+                value->integer = (int64_t)data;
+                value->number = (double)value->integer;
+            }
+            return 0;
+        case 0xD4: case 0xD5: case 0xD6: case 0xD7: case 0xD8:
+            value->type = CSON_MSGPACK_EXT;
+            data = (1 << (c - 0xD4)) + 1;
             break;
-        case CSON_TYPE_FLOAT:
-            item = cJSON_CreateNumber(*(float *)((int)base + (i * sizeof(float))));
+        case 0xD9: case 0xDA: case 0xDB:
+            value->type = CSON_MSGPACK_STR;
+            size = 1 << (c - 0xD9);
             break;
-        case CSON_TYPE_DOUBLE:
-            item = cJSON_CreateNumber(*(double *)((int)base + (i * sizeof(double))));
+        case 0xDC: case 0xDD:
+            value->type = CSON_MSGPACK_ARRAY;
+            size = 2 << (c - 0xDC);
             break;
-        case CSON_TYPE_STRING:
-            item = cJSON_CreateString((char *)*(int *)((int)base + (i * sizeof(int))));
+        case 0xDE: case 0xDF:
+            value->type = CSON_MSGPACK_MAP;
+            size = 2 << (c - 0xDE);
             break;
         default:
-            break;
+            parser->pos = start;
+            return csonParserError(parser);
+        }
+    }
+    if (size > 0 && csonMsgpackReadBig(parser, size, &data) != 0)
+    {
+        parser->pos = start;
+        return -1;
+    }
+    if (value->type == CSON_MSGPACK_EXT && size > 0)
+    {
+        data++;
+    }
+    if (value->type == CSON_MSGPACK_ARRAY || value->type == CSON_MSGPACK_MAP)
+    {
+        value->len = data;
+        if (data > (uint64_t)(parser->end - parser->pos) / (value->type == CSON_MSGPACK_MAP ? 2 : 1))
+        {
+            parser->pos = start;
+            return csonParserError(parser);
+        }
+        return 0;
+    }
+    if (data > (uint64_t)(parser->end - parser->pos))
+    {
+        parser->pos = start;
+        return csonParserError(parser);
+    }
+    value->str = parser->pos;
+    value->len = data;
+    parser->pos += data;
+    return 0;
+}
+
+
+/**
+ * @brief 跳过MessagePack值
+ *
+ * @param parser 解析器
+ * @param count 需要跳过的值的数量
+ * @return int 0 成功 -1 失败
+ * @note 不使用递归，嵌套层数不受限制
+ */
+static int csonMsgpackSkip(CsonParser *parser, size_t count)
+{
+    CsonMsgpackValue value;
+
+    while (count > 0)
+    {
+        if (csonMsgpackNext(parser, &value) != 0)
+        {
+            return -1;
+        }
+        count--;
+        if (value.type == CSON_MSGPACK_ARRAY || value.type == CSON_MSGPACK_MAP)
+        {
+            count += value.type == CSON_MSGPACK_MAP ? value.len * 2 : value.len;
+            if (count > (size_t)(parser->end - parser->pos))
+            {
+                return csonParserError(parser);
+            }
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 跳过已读取头部的MessagePack值的剩余内容
+ *
+ * @param parser 解析器
+ * @param value 已读取的值
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackSkipContent(CsonParser *parser, CsonMsgpackValue *value)
+{
+    switch (value->type)
+    {
+    case CSON_MSGPACK_ARRAY:
+        return csonMsgpackSkip(parser, value->len);
+    case CSON_MSGPACK_MAP:
+        return csonMsgpackSkip(parser, value->len * 2);
+    default:
+        return 0;
+    }
+}
+
+
+/**
+ * @brief 复制MessagePack字符串
+ *
+ * @param parser 解析器
+ * @param value 字符串值
+ * @return char* 复制的字符串，失败返回NULL
+ */
+static char *csonMsgpackNewString(CsonParser *parser, CsonMsgpackValue *value)
+{
+    char *str = csonParserMalloc(parser, value->len + 1);
+
+    if (!str)
+    {
+        csonParserError(parser);
+        return NULL;
+    }
+    memcpy(str, value->str, value->len);
+    str[value->len] = 0;
+    return str;
+}
+
+
+/**
+ * @brief 解析基本类型值
+ *
+ * @param parser 解析器
+ * @param value 已读取的值
+ * @param ptr 写入地址
+ * @param type 数据类型
+ * @param element 是否为数组元素
+ * @return int 0 成功 -1 失败
+ * @note 类型转换规则与json解析一致，字符串视图不需要反转义，
+ *       没有设置`ownViews`时直接指向输入
+ */
+static int csonMsgpackBasic(CsonParser *parser, CsonMsgpackValue *value, void *ptr,
+                            CsonType type, int element)
+{
+    CsonStringView *view;
+
+    switch (type)
+    {
+    case CSON_TYPE_CHAR:
+    case CSON_TYPE_SHORT:
+    case CSON_TYPE_INT:
+    case CSON_TYPE_LONG:
+    case CSON_TYPE_FLOAT:
+    case CSON_TYPE_DOUBLE:
+        if (value->type == CSON_MSGPACK_INT || value->type == CSON_MSGPACK_FLOAT
+            || value->type == CSON_MSGPACK_DOUBLE)
+        {
+            csonStoreNumber(ptr, type, value->integer, value->number);
+            return 0;
+        }
+        csonStoreNumber(ptr, type,
+            element && value->type == CSON_MSGPACK_BOOL && value->integer, 0);
+        return csonMsgpackSkipContent(parser, value);
+    case CSON_TYPE_BOOL:
+        *(char *)ptr = value->type == CSON_MSGPACK_BOOL && value->integer;
+        return csonMsgpackSkipContent(parser, value);
+    case CSON_TYPE_STRING:
+        *(char **)ptr = NULL;
+        if (value->type == CSON_MSGPACK_STR)
+        {
+            *(char **)ptr = csonMsgpackNewString(parser, value);
+            return *(char **)ptr ? 0 : -1;
+        }
+        return csonMsgpackSkipContent(parser, value);
+    case CSON_TYPE_STRING_VIEW:
+        view = (CsonStringView *)ptr;
+        memset(view, 0, sizeof(CsonStringView));
+        if (value->type != CSON_MSGPACK_STR)
+        {
+            return csonMsgpackSkipContent(parser, value);
+        }
+        if (!parser->ownViews)
+        {
+            view->str = value->str;
+            view->len = value->len;
+            return 0;
+        }
+        view->str = csonMsgpackNewString(parser, value);
+        view->len = value->len;
+        view->owned = view->str ? 1 : 0;
+        return view->str ? 0 : -1;
+    default:
+        return csonMsgpackSkipContent(parser, value);
+    }
+}
+
+
+/**
+ * @brief 将MessagePack值输出为json
+ *
+ * @param parser 解析器
+ * @param value 已读取的值
+ * @param buffer 缓冲
+ * @return int 0 成功 -1 失败
+ * @note 映射的键必须是字符串，二进制数据和扩展类型无法转换
+ */
+static int csonMsgpackPrintValue(CsonParser *parser, CsonMsgpackValue *value, CsonBuffer *buffer)
+{
+    CsonMsgpackValue item;
+    int map = value->type == CSON_MSGPACK_MAP;
+
+    switch (value->type)
+    {
+    case CSON_MSGPACK_NIL:
+        return csonBufferWrite(buffer, "null", 4);
+    case CSON_MSGPACK_BOOL:
+        return value->integer ? csonBufferWrite(buffer, "true", 4)
+                              : csonBufferWrite(buffer, "false", 5);
+    case CSON_MSGPACK_INT:
+        return csonPrintInteger(buffer, value->integer);
+    case CSON_MSGPACK_FLOAT:
+        return csonPrintFloat(buffer, (float)value->number);
+    case CSON_MSGPACK_DOUBLE:
+        return csonPrintNumber(buffer, value->number);
+    case CSON_MSGPACK_STR:
+        return csonPrintString(buffer, value->str, (int)value->len);
+    case CSON_MSGPACK_ARRAY:
+    case CSON_MSGPACK_MAP:
+        if (csonBufferWrite(buffer, map ? "{" : "[", 1) != 0)
+        {
+            return -1;
+        }
+        for (size_t i = 0; i < value->len; i++)
+        {
+            if (i > 0 && csonBufferWrite(buffer, ",", 1) != 0)
+            {
+                return -1;
+            }
+            if (map && (csonMsgpackNext(parser, &item) != 0
+                || item.type != CSON_MSGPACK_STR
+                || csonPrintString(buffer, item.str, (int)item.len) != 0
+                || csonBufferWrite(buffer, ":", 1) != 0))
+            {
+                return -1;
+            }
+            if (csonMsgpackNext(parser, &item) != 0
+                || csonMsgpackPrintValue(parser, &item, buffer) != 0)
+            {
+                return -1;
+            }
+        }
+        return csonBufferWrite(buffer, map ? "}" : "]", 1);
+    default:
+        return -1;
+    }
+}
+
+
+/**
+ * @brief 解析子json
+ *
+ * @param parser 解析器
+ * @param value 已读取的值
+ * @param json 转换得到的json字符串
+ * @return int 0 成功 -1 失败
+ * @note 输出格式与json解析得到的子json一致
+ */
+static int csonMsgpackJson(CsonParser *parser, CsonMsgpackValue *value, char **json)
+{
+    CsonBuffer buffer = {0};
+    const char *start = parser->pos;
+
+    buffer.ctx = parser->ctx;
+    buffer.buffer = csonCtxMalloc(buffer.ctx, 64);
+    if (!buffer.buffer)
+    {
+        return csonParserError(parser);
+    }
+    buffer.length = 64;
+    buffer.buffer[0] = 0;
+    if (csonMsgpackPrintValue(parser, value, &buffer) != 0)
+    {
+        if (buffer.buffer)
+        {
+            csonCtxFree(buffer.ctx, buffer.buffer);
+        }
+        if (!parser->err)
+        {
+            parser->pos = start;
+        }
+        return csonParserError(parser);
+    }
+    return csonParserTakeBuffer(parser, &buffer, json);
+}
+
+
+/**
+ * @brief 解析CsonList
+ *
+ * @param parser 解析器
+ * @param value 数组头部
+ * @param model CsonList成员数据模型
+ * @param modelSize CsonList成员模型数量
+ * @param list 链表
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackList(CsonParser *parser, CsonMsgpackValue *value,
+                           CsonModel *model, int modelSize, CsonList **list)
+{
+    CsonList **tail = list;
+    CsonList *node;
+    CsonMsgpackValue item;
+    union {
+        char c;
+        short s;
+        int i;
+        long l;
+        float f;
+        double d;
+        void *p;
+    } element;
+    int basic = csonIsBasicListModel(model);
+    int objSize = csonModelObjSize(model, modelSize);
+
+    for (size_t i = 0; i < value->len; i++)
+    {
+        node = csonListNew(parser->ctx);
+        if (!node)
+        {
+            return csonParserError(parser);
+        }
+        node->next = NULL;
+        node->obj = NULL;
+        *tail = node;
+        tail = &node->next;
+        if (csonMsgpackNext(parser, &item) != 0)
+        {
+            return -1;
+        }
+        if (basic)
+        {
+            memset(&element, 0, sizeof(element));
+            if (csonMsgpackBasic(parser, &item, &element, model[1].type, 0) != 0)
+            {
+                return -1;
+            }
+            memcpy(&node->obj, &element,
+                objSize < (int)sizeof(void *) ? objSize : (int)sizeof(void *));
+        }
+        else if (csonMsgpackObject(parser, &item, model, modelSize, &node->obj) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 解析CsonVector
+ *
+ * @param parser 解析器
+ * @param value 数组头部
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ * @param vector CsonVector
+ * @return int 0 成功 -1 失败
+ * @note 数组头部已包含元素数量，所有元素一次分配，nil元素保持为0
+ */
+static int csonMsgpackVector(CsonParser *parser, CsonMsgpackValue *value,
+                             CsonModel *model, int modelSize, CsonVector *vector)
+{
+    int basic = csonIsBasicListModel(model);
+    int objSize = csonModelObjSize(model, modelSize);
+    CsonMsgpackValue item;
+    char *data;
+    int ret;
+
+    if (value->len == 0)
+    {
+        return 0;
+    }
+    if (objSize > 0 && value->len > SIZE_MAX / objSize)
+    {
+        return csonParserError(parser);
+    }
+    data = csonParserMalloc(parser, value->len * objSize);
+    if (!data)
+    {
+        return csonParserError(parser);
+    }
+    memset(data, 0, value->len * objSize);
+    vector->data = data;
+    vector->len = value->len;
+    vector->cap = value->len;
+    for (size_t i = 0; i < value->len; i++, data += objSize)
+    {
+        if (csonMsgpackNext(parser, &item) != 0)
+        {
+            return -1;
+        }
+        if (basic)
+        {
+            ret = csonMsgpackBasic(parser, &item, data, model[1].type, 0);
+        }
+        else if (item.type == CSON_MSGPACK_NIL)
+        {
+            ret = 0;
+        }
+        else
+        {
+            ret = csonMsgpackFields(parser, &item, data, model, modelSize);
+        }
+        if (ret != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 解析数组
+ *
+ * @param parser 解析器
+ * @param value 数组头部
+ * @param base 数组基址
+ * @param elementType 数组元素类型
+ * @param arraySize 数组大小
+ * @param count 写入的元素数量
+ * @return int 0 成功 -1 失败
+ * @note 超出数组大小的元素会被忽略
+ */
+static int csonMsgpackArray(CsonParser *parser, CsonMsgpackValue *value, void *base,
+                            CsonType elementType, short arraySize, short *count)
+{
+    int size = csonTypeSize(elementType);
+    CsonMsgpackValue item;
+    int ret;
+
+    *count = 0;
+    for (size_t i = 0; i < value->len; i++)
+    {
+        if (csonMsgpackNext(parser, &item) != 0)
+        {
+            return -1;
+        }
+        if (i < (size_t)arraySize && size > 0)
+        {
+            ret = csonMsgpackBasic(parser, &item, (char *)base + i * size, elementType, 1);
+            *count = i + 1;
+        }
+        else
+        {
+            ret = csonMsgpackSkipContent(parser, &item);
+        }
+        if (ret != 0)
+        {
+            return -1;
         }
-        cJSON_AddItemToArray(root, item);
     }
-    return root;
+    return 0;
 }
 
 
 /**
- * @brief 编码JSON对象
- * 
+ * @brief 解析对象成员
+ *
+ * @param parser 解析器
+ * @param value 已读取的值
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @return int 0 成功 -1 失败
+ */
+static int csonMsgpackField(CsonParser *parser, CsonMsgpackValue *value, void *obj,
+                            CsonModel *field)
+{
+    void *ptr = (char *)obj + field->offset;
+    short count;
+    int ret;
+
+    switch (field->type)
+    {
+    case CSON_TYPE_LIST:
+        *(CsonList **)ptr = NULL;
+        return value->type == CSON_MSGPACK_ARRAY
+            ? csonMsgpackList(parser, value, field->param.sub.model,
+                field->param.sub.size, (CsonList **)ptr)
+            : csonMsgpackSkipContent(parser, value);
+    case CSON_TYPE_VECTOR:
+        memset(ptr, 0, sizeof(CsonVector));
+        return value->type == CSON_MSGPACK_ARRAY
+            ? csonMsgpackVector(parser, value, field->param.sub.model,
+                field->param.sub.size, (CsonVector *)ptr)
+            : csonMsgpackSkipContent(parser, value);
+    case CSON_TYPE_STRUCT:
+        return csonMsgpackObject(parser, value, field->param.sub.model,
+            field->param.sub.size, (void **)ptr);
+    case CSON_TYPE_ARRAY:
+        count = 0;
+        ret = value->type == CSON_MSGPACK_ARRAY
+            ? csonMsgpackArray(parser, value, ptr, field->param.array.eleType,
+                field->param.array.size, &count)
+            : csonMsgpackSkipContent(parser, value);
+        csonSetArrayCount(obj, field, count);
+        return ret;
+    case CSON_TYPE_JSON:
+        return csonMsgpackJson(parser, value, (char **)ptr);
+    default:
+        return csonMsgpackBasic(parser, value, ptr, field->type, 0);
+    }
+}
+
+
+/**
+ * @brief 解析映射的所有成员
+ *
+ * @param parser 解析器
+ * @param value 映射头部
  * @param obj 对象
  * @param model 数据模型
  * @param modelSize 数据模型数量
- * @return cJSON* 编码得到的json对象
+ * @return int 0 成功 -1 失败
+ * @note 键值匹配规则与json解析一致，同名键值只取第一个，不是字符串的键被忽略
  */
-cJSON* csonEncodeObject(void *obj, CsonModel *model, int modelSize)
+static int csonMsgpackMembers(CsonParser *parser, CsonMsgpackValue *value, void *obj,
+                              CsonModel *model, int modelSize)
 {
-    if (!obj) {
-        return cJSON_CreateNull();
+    unsigned char seenBuffer[CSON_SEEN_BUFFER_SIZE];
+    unsigned char *seen = seenBuffer;
+    CsonMsgpackValue key, item;
+    const char *start;
+    int matched;
+    int ret = -1;
+
+    if (modelSize > CSON_SEEN_BUFFER_SIZE * 8)
+    {
+        seen = csonCtxMalloc(parser->ctx, (modelSize + 7) / 8);
+        if (!seen)
+        {
+            return csonParserError(parser);
+        }
     }
-    cJSON *root = cJSON_CreateObject();
+    memset(seen, 0, (modelSize + 7) / 8);
 
-    for (short i = 0; i < modelSize; i++)
+    for (size_t i = 0; i < value->len; i++)
     {
-        switch (model[i].type)
+        if (csonMsgpackNext(parser, &key) != 0)
         {
-        case CSON_TYPE_CHAR:
-            csonEncodeNumber(root, model[i].key, *(char *)((int)obj + model[i].offset));
-            break;
-        case CSON_TYPE_SHORT:
-            csonEncodeNumber(root, model[i].key, *(short *)((int)obj + model[i].offset));
-            break;
-        case CSON_TYPE_INT:
-            csonEncodeNumber(root, model[i].key, *(int *)((int)obj + model[i].offset));
-            break;
-        case CSON_TYPE_LONG:
-            csonEncodeNumber(root, model[i].key, *(long *)((int)obj + model[i].offset));
-            break;
-        case CSON_TYPE_FLOAT:
-            csonEncodeNumber(root, model[i].key, *(float *)((int)obj + model[i].offset));
-            break;
-        case CSON_TYPE_DOUBLE:
-            csonEncodeNumber(root, model[i].key, *(double *)((int)obj + model[i].offset));
-            break;
-        case CSON_TYPE_BOOL:
-            cJSON_AddBoolToObject(root, model[i].key, *(char *)((int)obj + model[i].offset));
-            break;
-        case CSON_TYPE_STRING:
-            if ((char *)(*(int *)((int)obj + model[i].offset)))
-            {
-                csonEncodeString(root, model[i].key, (char *)(*(int *)((int)obj + model[i].offset)));
-            }
-            break;
-        case CSON_TYPE_LIST:
-            if ((CsonList *)*(int *)((int)obj + model[i].offset))
+            goto exit;
+        }
+        if (key.type != CSON_MSGPACK_STR)
+        {
+            if (csonMsgpackSkipContent(parser, &key) != 0 || csonMsgpackSkip(parser, 1) != 0)
             {
-                cJSON_AddItemToObject(root, model[i].key, 
-                    csonEncodeList((CsonList *)*(int *)((int)obj + model[i].offset),
-                        model[i].param.sub.model, model[i].param.sub.size));
+                goto exit;
             }
-            break;
-        case CSON_TYPE_STRUCT:
-            if ((void *)(*(int *)((int)obj + model[i].offset)))
+            continue;
+        }
+        start = parser->pos;
+        matched = 0;
+        for (int j = 0; j < modelSize; j++)
+        {
+            if (model[j].type == CSON_TYPE_OBJ || !model[j].key
+                || (seen[j >> 3] & (1 << (j & 7)))
+                || !csonKeyMatch(parser->ctx, key.str, (int)key.len, 0, model[j].key, -1))
             {
-                cJSON_AddItemToObject(root, model[i].key, csonEncodeObject(
-                    (void *)(*(int *)((int)obj + model[i].offset)),
-                    model[i].param.sub.model, model[i].param.sub.size));
+                continue;
             }
-            break;
-        case CSON_TYPE_ARRAY:
-            cJSON_AddItemToObject(root, model[i].key, csonEncodeArray(
-                (void *)((int)obj + model[i].offset),
-                model[i].param.array.eleType, model[i].param.array.size));
-            break;
-        case CSON_TYPE_JSON:
-            if ((char *)(*(int *)((int)obj + model[i].offset)))
+            parser->pos = start;
+            if (csonMsgpackNext(parser, &item) != 0
+                || csonMsgpackField(parser, &item, obj, &model[j]) != 0)
             {
-                cJSON_AddItemToObject(root, model[i].key, 
-                    cJSON_Parse((char *)(*(int *)((int)obj + model[i].offset))));
+                goto exit;
             }
-            break;
-        default:
-            break;
+            seen[j >> 3] |= 1 << (j & 7);
+            matched = 1;
+        }
+        if (!matched && csonMsgpackSkip(parser, 1) != 0)
+        {
+            goto exit;
         }
     }
-    return root;
+    ret = 0;
+
+exit:
+    if (seen != seenBuffer)
+    {
+        csonCtxFree(parser->ctx, seen);
+    }
+    return ret;
 }
 
 
 /**
- * @brief 编码成json字符串
- * 
- * @param obj 对象
+ * @brief 解析对象成员到已分配的对象
+ *
+ * @param parser 解析器
+ * @param value 已读取的值
+ * @param obj 对象，需要预先清零
  * @param model 数据模型
  * @param modelSize 数据模型数量
- * @param bufferSize 分配给json字符串的空间大小
- * @param fmt 是否格式化json字符串
- * @return char* 编码得到的json字符串
+ * @return int 0 成功 -1 失败
+ * @note 值不是映射时，与json解析一致，只有没有键值的成员解析该值本身
  */
-char* csonEncode(void *obj, CsonModel *model, int modelSize, int bufferSize, int fmt)
+static int csonMsgpackFields(CsonParser *parser, CsonMsgpackValue *value, void *obj,
+                             CsonModel *model, int modelSize)
 {
-    cJSON *json = csonEncodeObject(obj, model, modelSize);
-    CSON_ASSERT(json, return NULL);
-    char *jsonStr = cJSON_PrintBuffered(json, bufferSize, fmt);
-    cJSON_Delete(json);
-    return jsonStr;
+    const char *start = parser->pos;
+    int ret = 0;
+
+    if (value->type == CSON_MSGPACK_MAP)
+    {
+        return csonMsgpackMembers(parser, value, obj, model, modelSize);
+    }
+    for (int i = 0; i < modelSize && ret == 0; i++)
+    {
+        if (model[i].type != CSON_TYPE_OBJ && !model[i].key)
+        {
+            parser->pos = start;
+            ret = csonMsgpackField(parser, value, obj, &model[i]);
+        }
+    }
+    if (ret == 0)
+    {
+        parser->pos = start;
+        ret = csonMsgpackSkipContent(parser, value);
+    }
+    return ret;
 }
 
 
 /**
- * @brief 编码成json字符串
- * 
- * @param obj 对象
+ * @brief 解析对象
+ *
+ * @param parser 解析器
+ * @param value 已读取的值
  * @param model 数据模型
  * @param modelSize 数据模型数量
- * @return char* 编码得到的json字符串
+ * @param obj 解析得到的对象，值为nil时为NULL
+ * @return int 0 成功 -1 失败
  */
-char* csonEncodeUnformatted(void *obj, CsonModel *model, int modelSize)
+static int csonMsgpackObject(CsonParser *parser, CsonMsgpackValue *value,
+                             CsonModel *model, int modelSize, void **obj)
 {
-    cJSON *json = csonEncodeObject(obj, model, modelSize);
-    CSON_ASSERT(json, return NULL);
-    char *jsonStr = cJSON_PrintUnformatted(json);
-    cJSON_Delete(json);
-    return jsonStr;
+    int objSize;
+    int ret;
+
+    *obj = NULL;
+    if (value->type == CSON_MSGPACK_NIL)
+    {
+        return 0;
+    }
+    objSize = csonModelObjSize(model, modelSize);
+    *obj = csonParserMalloc(parser, objSize);
+    if (!*obj)
+    {
+        return csonParserError(parser);
+    }
+    memset(*obj, 0, objSize);
+
+    ret = csonMsgpackFields(parser, value, *obj, model, modelSize);
+    if (ret != 0)
+    {
+        if (!parser->ctx || !parser->ctx->arena)
+        {
+            csonFreeObject(parser->ctx, *obj, model, modelSize);
+        }
+        *obj = NULL;
+    }
+    return ret;
 }
 
 
 /**
- * @brief 释放CSON解析出的对象
- * 
+ * @brief 使用上下文解析MessagePack
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param data MessagePack数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeMsgpackCtx(CsonContext *ctx, const void *data, size_t len,
+                           CsonModel *model, int modelSize)
+{
+    CsonParser parser = {0};
+    CsonMsgpackValue value;
+    CsonArena *arena = ctx ? ctx->arena : NULL;
+    size_t offset = arena ? arena->offset : 0;
+    void *obj = NULL;
+    int ret;
+
+    CSON_ASSERT(data && model, return NULL);
+    parser.pos = (const char *)data;
+    parser.end = parser.pos + len;
+    parser.ctx = ctx;
+    ret = csonMsgpackNext(&parser, &value);
+    if (ret == 0)
+    {
+        ret = csonMsgpackObject(&parser, &value, model, modelSize, &obj);
+    }
+    if (ret == 0 && ctx && (ctx->options & CSON_OPTION_REQUIRE_END) && parser.pos < parser.end)
+    {
+        ret = csonParserError(&parser);
+        if (!arena)
+        {
+            csonFreeObject(ctx, obj, model, modelSize);
+        }
+    }
+    if (ret != 0 && arena)
+    {
+        arena->offset = offset;
+    }
+    if (ctx)
+    {
+        ctx->error = ret == 0 ? NULL : parser.err;
+    }
+    CSON_ASSERT(ret == 0, return NULL);
+    return obj;
+}
+
+
+/**
+ * @brief 解析MessagePack
+ *
+ * @param data MessagePack数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeMsgpack(const void *data, size_t len, CsonModel *model, int modelSize)
+{
+    return csonDecodeMsgpackCtx(NULL, data, len, model, modelSize);
+}
+
+
+/**
+ * @brief 释放字符串视图
+ *
+ * @param ctx 上下文
+ * @param view 字符串视图
+ */
+static void csonFreeStringView(CsonContext *ctx, CsonStringView *view)
+{
+    if (view->owned)
+    {
+        csonCtxFree(ctx, (void *)view->str);
+    }
+}
+
+
+/**
+ * @brief 释放连续存放的元素
+ *
+ * @param ctx 内存分配上下文
+ * @param data 第一个元素
+ * @param len 元素数量
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ * @note 元素本身所在的空间不释放
+ */
+static void csonFreeElements(CsonContext *ctx, char *data, size_t len,
+                             CsonModel *model, int modelSize)
+{
+    int basic = csonIsBasicListModel(model);
+    int objSize = csonModelObjSize(model, modelSize);
+
+    for (size_t i = 0; i < len && (!basic || model[1].type == CSON_TYPE_STRING);
+         i++, data += objSize)
+    {
+        if (!basic)
+        {
+            csonFreeFields(ctx, data, model, modelSize);
+        }
+        else if (*(char **)data)
+        {
+            csonCtxFree(ctx, *(char **)data);
+        }
+    }
+}
+
+
+/**
+ * @brief 释放CsonVector
+ *
+ * @param ctx 内存分配上下文
+ * @param vector CsonVector
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ */
+static void csonFreeVector(CsonContext *ctx, CsonVector *vector, CsonModel *model, int modelSize)
+{
+    if (!vector->data)
+    {
+        return;
+    }
+    csonFreeElements(ctx, vector->data, vector->len, model, modelSize);
+    csonCtxFree(ctx, vector->data);
+}
+
+
+/**
+ * @brief 释放CsonList
+ *
+ * @param ctx 内存分配上下文
+ * @param list 链表
+ * @param model 元素数据模型
+ * @param modelSize 元素模型数量
+ */
+static void csonFreeList(CsonContext *ctx, CsonList *list, CsonModel *model, int modelSize)
+{
+    CsonList *p;
+
+    while (list)
+    {
+        p = list;
+        list = list->next;
+        if (p->obj)
+        {
+            if (!csonIsBasicListModel(model))
+            {
+                csonFreeObject(ctx, p->obj, model, modelSize);
+            }
+            else if (model[1].type == CSON_TYPE_STRING)
+            {
+                csonCtxFree(ctx, p->obj);
+            }
+        }
+        csonListRelease(ctx, p);
+    }
+}
+
+
+/**
+ * @brief 释放对象成员占用的内存
+ *
+ * @param ctx 内存分配上下文
  * @param obj 对象
  * @param model 对象模型
  * @param modelSize 对象模型数量
+ * @note 对象本身不释放
  */
-void csonFree(void *obj, CsonModel *model, int modelSize)
+static void csonFreeFields(CsonContext *ctx, void *obj, CsonModel *model, int modelSize)
 {
-    CsonList *list, *p;
-    int *tmpNode;
-
     for (short i = 0; i < modelSize; i++)
     {
         switch ((int)model[i].type)
@@ -614,33 +8068,21 @@ void csonFree(void *obj, CsonModel *model, int modelSize)
             break;
         case CSON_TYPE_STRING:
         case CSON_TYPE_JSON:
-            cson.free((char *)(*(int *)((int)obj + model[i].offset)));
+            csonCtxFree(ctx, *(char **)((char *)obj + model[i].offset));
+            break;
+        case CSON_TYPE_STRING_VIEW:
+            csonFreeStringView(ctx, (CsonStringView *)((char *)obj + model[i].offset));
             break;
         case CSON_TYPE_LIST:
-            list = (CsonList *)*(int *)((int)obj + model[i].offset);
-            while (list)
-            {
-                p = list;
-                list = list->next;
-                if (p->obj)
-                {
-                    if (csonIsBasicListModel(model[i].param.sub.model))
-                    {
-                        tmpNode = cson.malloc(sizeof(int));
-                        *tmpNode = (int)(&(p->obj));
-                    }
-                    else
-                    {
-                        tmpNode = p->obj;
-                    }
-                    csonFree(tmpNode, 
-                        model[i].param.sub.model, model[i].param.sub.size);
-                }
-                cson.free(p);
-            }
+            csonFreeList(ctx, *(CsonList **)((char *)obj + model[i].offset),
+                model[i].param.sub.model, model[i].param.sub.size);
             break;
         case CSON_TYPE_STRUCT:
-            csonFree((void *)(*(int *)((int)obj + model[i].offset)), 
+            csonFreeObject(ctx, *(void **)((char *)obj + model[i].offset),
+                model[i].param.sub.model, model[i].param.sub.size);
+            break;
+        case CSON_TYPE_VECTOR:
+            csonFreeVector(ctx, (CsonVector *)((char *)obj + model[i].offset),
                 model[i].param.sub.model, model[i].param.sub.size);
             break;
         case CSON_TYPE_ARRAY:
@@ -648,18 +8090,75 @@ void csonFree(void *obj, CsonModel *model, int modelSize)
             {
                 for (short j = 0; j< model[i].param.array.size; j++)
                 {
-                    if (*(int *)((int)obj + model[i].offset + (j << 2)))
+                    if (*((char **)((char *)obj + model[i].offset) + j))
                     {
-                        cson.free((void *)*(int *)((int)obj + model[i].offset + (j << 2)));
+                        csonCtxFree(ctx, *((char **)((char *)obj + model[i].offset) + j));
                     }
                 }
             }
+            else if (model[i].param.array.eleType == CSON_TYPE_STRING_VIEW)
+            {
+                for (short j = 0; j< model[i].param.array.size; j++)
+                {
+                    csonFreeStringView(ctx, (CsonStringView *)((char *)obj + model[i].offset) + j);
+                }
+            }
             break;
         default:
             break;
         }
     }
-    cson.free(obj);
+}
+
+
+/**
+ * @brief 释放CSON解析出的对象
+ * 
+ * @param ctx 内存分配上下文
+ * @param obj 对象
+ * @param model 对象模型
+ * @param modelSize 对象模型数量
+ */
+static void csonFreeObject(CsonContext *ctx, void *obj, CsonModel *model, int modelSize)
+{
+    if (!obj)
+    {
+        return;
+    }
+    csonFreeFields(ctx, obj, model, modelSize);
+    csonCtxFree(ctx, obj);
+}
+
+
+/**
+ * @brief 释放CSON解析出的对象
+ * 
+ * @param obj 对象
+ * @param model 对象模型
+ * @param modelSize 对象模型数量
+ */
+void csonFree(void *obj, CsonModel *model, int modelSize)
+{
+    csonFreeObject(NULL, obj, model, modelSize);
+}
+
+
+/**
+ * @brief 使用上下文释放CSON解析出的对象
+ *
+ * @param ctx 解析时使用的上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param model 对象模型
+ * @param modelSize 对象模型数量
+ * @note 从内存池中解析得到的对象不需要释放
+ */
+void csonFreeCtx(CsonContext *ctx, void *obj, CsonModel *model, int modelSize)
+{
+    if (ctx && ctx->arena)
+    {
+        return;
+    }
+    csonFreeObject(ctx, obj, model, modelSize);
 }
 
 
@@ -675,6 +8174,19 @@ void csonFreeJson(const char *jsonStr)
 }
 
 
+/**
+ * @brief 使用上下文释放cson编码生成的json字符串
+ *
+ * @param ctx 编码时使用的上下文，为NULL时使用默认上下文
+ * @param jsonStr json字符串
+ */
+void csonFreeJsonCtx(CsonContext *ctx, const char *jsonStr)
+{
+    CSON_ASSERT(jsonStr, return);
+    csonCtxFree(ctx, (void *)jsonStr);
+}
+
+
 /**
  * @brief CSON链表添加节点
  * 
@@ -686,7 +8198,7 @@ CsonList* csonListAdd(CsonList *list, void *obj)
 {
     if (!list)
     {
-        list = cson.malloc(sizeof(CsonList));
+        list = csonListNew(NULL);
         if (!list)
         {
             return NULL;
@@ -706,7 +8218,7 @@ CsonList* csonListAdd(CsonList *list, void *obj)
     }
     else
     {
-        CsonList *node = cson.malloc(sizeof(CsonList));
+        CsonList *node = csonListNew(NULL);
         if (node)
         {
             node->obj = obj;
@@ -743,7 +8255,7 @@ CsonList *csonListDelete(CsonList *list, void *obj, char freeMem)
             if (freeMem)
             {
                 cson.free(tmp->obj);
-                cson.free(tmp);
+                csonListRelease(NULL, tmp);
             }
             break;
         }
@@ -14,6 +14,7 @@
 
 #include "stddef.h"
 #include "cJSON.h"
+#include "cson_pool.h"
 
 
 #define     CSON_VERSION        "1.0.4"         /**< CSON版本 */
@@ -45,6 +46,8 @@ typedef enum
     CSON_TYPE_LIST,
     CSON_TYPE_ARRAY,
     CSON_TYPE_JSON,
+    CSON_TYPE_STRING_VIEW,
+    CSON_TYPE_VECTOR,
 } CsonType;
 
 
@@ -56,7 +59,7 @@ typedef struct cson_model
 {
     CsonType type;                      /**< 数据类型 */
     char *key;                          /**< 元素键值 */
-    short offset;                       /**< 元素偏移 */
+    size_t offset;                      /**< 元素偏移 */
     union
     {
         struct
@@ -68,6 +71,7 @@ typedef struct cson_model
         {
             CsonType eleType;           /**< 数组元素类型 */
             short size;                 /**< 数组大小 */
+            ptrdiff_t countOffset;      /**< 元素数量成员相对数组成员的偏移，为0时不记录元素数量 */
         } array;                        /**< 数组 */
         int objSize;                    /**< 对象大小 */
         CsonType basicListType;         /**< 基础数据链表类型 */
@@ -86,6 +90,34 @@ typedef struct cson_list
 } CsonList;
 
 
+/**
+ * @brief 字符串视图
+ *
+ * @note 不包含转义字符时直接指向解析输入中的字符串内容，不以'\0'结尾，
+ *       输入缓冲需要在对象释放前保持有效，包含转义字符时指向单独分配的反转义结果
+ */
+typedef struct cson_string_view
+{
+    const char *str;                    /**< 字符串内容，json中不存在或不是字符串时为NULL */
+    size_t len;                         /**< 字符串长度 */
+    int owned;                          /**< 字符串内容是否为单独分配的内存，释放对象时一并释放 */
+} CsonStringView;
+
+
+/**
+ * @brief 连续存储的数组
+ *
+ * @note 元素连续存放在data中，结构体元素直接保存结构体本身，
+ *       基础类型元素保存值，元素数据模型与CsonList相同
+ */
+typedef struct cson_vector
+{
+    void *data;                         /**< 元素数组，json中不存在或为空数组时为NULL */
+    size_t len;                         /**< 元素数量 */
+    size_t cap;                         /**< 已分配的元素数量 */
+} CsonVector;
+
+
 extern CsonModel csonBasicListModel[];  /**< 基础类型链表数据模型 */
 
 #define CSON_MODEL_CHAR_LIST        &csonBasicListModel[0]      /**< char型链表数据模型 */
@@ -98,6 +130,84 @@ extern CsonModel csonBasicListModel[];  /**< 基础类型链表数据模型 */
 
 #define CSON_BASIC_LIST_MODEL_SIZE  2                           /**< 基础类型链表数据模型大小 */
 
+/**
+ * @brief 预编译数据模型
+ *
+ * @note 由`csonCompileModel`生成，编译后不可修改，可在多个线程中同时使用
+ */
+typedef struct cson_compiled_model CsonCompiledModel;
+
+/**
+ * @brief 内存池
+ *
+ * @note 内存池从一块连续内存中顺序分配，在内存池中解析得到的对象不需要调用`csonFree`释放，
+ *       通过`csonArenaReset`一次性回收
+ */
+typedef struct cson_arena
+{
+    char *buffer;                       /**< 内存块 */
+    size_t size;                        /**< 内存块大小 */
+    size_t offset;                      /**< 已分配大小 */
+} CsonArena;
+
+#define CSON_ARENA_ALIGN            8                           /**< 内存池分配对齐 */
+
+/**
+ * @brief 解析上下文
+ *
+ * @note 每个线程使用各自的上下文即可并发解析和编码，上下文中未设置的分配函数使用`csonInit`设置的函数
+ */
+typedef struct cson_context
+{
+    void *(*malloc)(size_t);            /**< 内存分配函数 */
+    void (*free)(void *);               /**< 内存释放函数 */
+    CsonArena *arena;                   /**< 内存池，不为NULL时解析结果从内存池中分配 */
+    int options;                        /**< 解析选项 */
+    const char *error;                  /**< 最近一次解析失败的位置，解析成功时为NULL */
+} CsonContext;
+
+#define CSON_OPTION_REQUIRE_END     (1 << 0)                    /**< json值之后只允许空白字符 */
+#define CSON_OPTION_RAW_JSON        (1 << 1)                    /**< 子json解析时直接复制原始文本，编码时原样输出，不重新解析和格式化 */
+#define CSON_OPTION_MINIFY_JSON     (1 << 2)                    /**< 与`CSON_OPTION_RAW_JSON`一起使用，复制子json时去除字符串外的空白字符 */
+#define CSON_OPTION_CASE_SENSITIVE  (1 << 3)                    /**< 键值区分大小写，默认与cJSON_GetObjectItem一致不区分大小写 */
+
+#define CSON_UPDATE_REPLACE_STRUCT  (1 << 0)                    /**< 就地更新时子结构体整体替换，默认只更新json中存在的成员 */
+#define CSON_UPDATE_IGNORE_NULL     (1 << 1)                    /**< 就地更新时json中的null不修改成员，默认与解析一致清空成员 */
+
+/**
+ * @brief 校验错误
+ *
+ */
+typedef struct cson_validate_error
+{
+    int code;                           /**< 错误类型，CSON_VALIDATE_* */
+    size_t offset;                      /**< 出错位置在输入中的偏移 */
+    const char *key;                    /**< 出错成员的键值，不在成员中时为NULL */
+} CsonValidateError;
+
+#define CSON_VALIDATE_OK            0                           /**< 校验通过 */
+#define CSON_VALIDATE_SYNTAX        1                           /**< json语法错误 */
+#define CSON_VALIDATE_TYPE          2                           /**< json值的类型与成员类型不符 */
+#define CSON_VALIDATE_MISSING       3                           /**< 缺少数据模型中的成员 */
+#define CSON_VALIDATE_BOUNDS        4                           /**< 数组元素数量超过数组大小 */
+
+/**
+ * @brief 增量解析器
+ *
+ * @note 由`csonDecoderCreate`创建，用于解析分段接收的json
+ */
+typedef struct cson_decoder CsonDecoder;
+
+/**
+ * @brief 流式编码输出函数
+ *
+ * @param param 输出函数参数
+ * @param data 输出数据
+ * @param len 数据长度
+ * @return int 0 成功 其他 失败
+ */
+typedef int (*CsonWriteFunc)(void *param, const char *data, size_t len);
+
 /**
  * @brief 对象数据模型
  * 
@@ -178,6 +288,16 @@ extern CsonModel csonBasicListModel[];  /**< 基础类型链表数据模型 */
 #define CSON_MODEL_STRING(type, key) \
         {CSON_TYPE_STRING, #key, offsetof(type, key)}
 
+/**
+ * @brief 字符串视图型数据模型
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @note 成员类型为`CsonStringView`，使用直接解析接口时字符串不需要分配内存
+ */
+#define CSON_MODEL_STRING_VIEW(type, key) \
+        {CSON_TYPE_STRING_VIEW, #key, offsetof(type, key)}
+
 /**
  * @brief 结构体型数据模型
  * 
@@ -200,6 +320,18 @@ extern CsonModel csonBasicListModel[];  /**< 基础类型链表数据模型 */
 #define CSON_MODEL_LIST(type, key, submodel, subsize) \
         {CSON_TYPE_LIST, #key, offsetof(type, key), .param.sub.model=submodel, .param.sub.size=subsize}
 
+/**
+ * @brief vector型数据模型
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param submodel 元素模型，基础类型使用基础类型链表数据模型
+ * @param subsize 元素模型大小
+ * @note 成员类型为`CsonVector`，元素连续存放
+ */
+#define CSON_MODEL_VECTOR(type, key, submodel, subsize) \
+        {CSON_TYPE_VECTOR, #key, offsetof(type, key), .param.sub.model=submodel, .param.sub.size=subsize}
+
 /**
  * @brief list型数据模型
  * 
@@ -210,6 +342,22 @@ extern CsonModel csonBasicListModel[];  /**< 基础类型链表数据模型 */
  */
 #define CSON_MODEL_ARRAY(type, key, elementType, arraySize) \
         {CSON_TYPE_ARRAY, #key, offsetof(type, key), .param.array.eleType=elementType, .param.array.size=arraySize}
+
+/**
+ * @brief 带元素数量的数组数据模型
+ *
+ * @param type 对象模型
+ * @param key 数据键值
+ * @param elementType 数组元素类型
+ * @param arraySize 数组大小
+ * @param count 记录元素数量的成员，类型为int，不需要出现在数据模型中
+ * @note 解析时最多写入arraySize个元素，并将写入的数量保存到count，
+ *       编码时只输出前count个元素，count可以位于数组之前或之后
+ */
+#define CSON_MODEL_ARRAY_COUNT(type, key, elementType, arraySize, count) \
+        {CSON_TYPE_ARRAY, #key, offsetof(type, key), .param.array.eleType=elementType, \
+        .param.array.size=arraySize, \
+        .param.array.countOffset=(ptrdiff_t)offsetof(type, count) - (ptrdiff_t)offsetof(type, key)}
         
 /**
  * @brief 子json数据模型
@@ -240,6 +388,24 @@ extern CsonModel csonBasicListModel[];  /**< 基础类型链表数据模型 */
  */
 void csonInit(void *malloc, void *free);
 
+/**
+ * @brief 使用上下文分配内存
+ *
+ * @param ctx 上下文，为NULL或未设置分配函数时使用`csonInit`设置的函数
+ * @param size 内存大小
+ * @return void* 分配的内存
+ * @note 不使用上下文中的内存池，供`cson_batch.c`等扩展模块使用
+ */
+void *csonCtxMalloc(CsonContext *ctx, size_t size);
+
+/**
+ * @brief 使用上下文释放内存
+ *
+ * @param ctx 上下文，为NULL或未设置释放函数时使用`csonInit`设置的函数
+ * @param ptr 内存
+ */
+void csonCtxFree(CsonContext *ctx, void *ptr);
+
 /**
  * @brief 解析JSON对象
  * 
@@ -267,6 +433,8 @@ void *csonDecodeObject(cJSON *json, CsonModel *model, int modelSize);
  * @param model 数据模型
  * @param modelSize 数据模型数量
  * @return void* 解析得到的对象
+ * @note 数字经过cJSON树以double保存，绝对值超过2^53的整数写入long成员时会被舍入，
+ *       `csonDecodeDirect`等直接解析函数按64位整数精确保存
  */
 void *csonDecode(const char *jsonStr, CsonModel *model, int modelSize);
 
@@ -280,6 +448,308 @@ void *csonDecode(const char *jsonStr, CsonModel *model, int modelSize);
 #define csonDecodeEx(jsonStr, model) \
         csonDecode(jsonStr, model, sizeof(model) / sizeof(CsonModel));
 
+/**
+ * @brief 直接解析JSON字符串
+ *
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ * @note 解析结果与`csonDecode`一致，但不会生成中间的cJSON树，
+ *       json文本根据数据模型被直接解析到结构体中
+ */
+void *csonDecodeDirect(const char *jsonStr, CsonModel *model, int modelSize);
+
+/**
+ * @brief 直接解析JSON字符串
+ *
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @return void* 解析得到的对象
+ */
+#define csonDecodeDirectEx(jsonStr, model) \
+        csonDecodeDirect(jsonStr, model, sizeof(model) / sizeof(CsonModel))
+
+/**
+ * @brief 预编译数据模型
+ *
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return CsonCompiledModel* 预编译模型
+ * @note 预编译模型缓存对象大小，解析子结构体模型，并为成员键值建立哈希索引，
+ *       解析时每个json成员只需要一次查找即可找到对应的结构体成员
+ */
+CsonCompiledModel *csonCompileModel(CsonModel *model, int modelSize);
+
+/**
+ * @brief 预编译数据模型
+ *
+ * @param model 数据模型
+ * @return CsonCompiledModel* 预编译模型
+ */
+#define csonCompileModelEx(model) \
+        csonCompileModel(model, sizeof(model) / sizeof(CsonModel))
+
+/**
+ * @brief 释放预编译数据模型
+ *
+ * @param compiled 预编译模型
+ */
+void csonFreeCompiledModel(CsonCompiledModel *compiled);
+
+/**
+ * @brief 使用预编译模型直接解析JSON字符串
+ *
+ * @param jsonStr json字符串
+ * @param compiled 预编译模型
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeCompiled(const char *jsonStr, CsonCompiledModel *compiled);
+
+/**
+ * @brief 初始化内存池
+ *
+ * @param arena 内存池
+ * @param buffer 内存池使用的内存块
+ * @param size 内存块大小
+ */
+void csonArenaInit(CsonArena *arena, void *buffer, size_t size);
+
+/**
+ * @brief 从内存池分配内存
+ *
+ * @param arena 内存池
+ * @param size 内存大小
+ * @return void* 分配的内存，内存池空间不足时返回NULL
+ */
+void *csonArenaAlloc(CsonArena *arena, size_t size);
+
+/**
+ * @brief 重置内存池
+ *
+ * @param arena 内存池
+ * @note 重置后，之前从内存池中解析得到的所有对象都将失效
+ */
+void csonArenaReset(CsonArena *arena);
+
+/**
+ * @brief 在内存池中直接解析JSON字符串
+ *
+ * @param arena 内存池
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ * @note 解析得到的结构体，字符串，链表节点全部从内存池中分配，不能使用`csonFree`释放，
+ *       内存池空间不足时解析失败，已分配的空间会被回退
+ */
+void *csonDecodeInArena(CsonArena *arena, const char *jsonStr, CsonModel *model, int modelSize);
+
+/**
+ * @brief 在内存池中直接解析JSON字符串
+ *
+ * @param arena 内存池
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @return void* 解析得到的对象
+ */
+#define csonDecodeInArenaEx(arena, jsonStr, model) \
+        csonDecodeInArena(arena, jsonStr, model, sizeof(model) / sizeof(CsonModel))
+
+/**
+ * @brief 使用上下文直接解析JSON字符串
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ * @note 解析过程不使用任何全局状态，解析失败时错误位置记录在`ctx->error`中
+ */
+void *csonDecodeCtx(CsonContext *ctx, const char *jsonStr, CsonModel *model, int modelSize);
+
+/**
+ * @brief 使用上下文直接解析JSON字符串
+ *
+ * @param ctx 解析上下文
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @return void* 解析得到的对象
+ */
+#define csonDecodeCtxEx(ctx, jsonStr, model) \
+        csonDecodeCtx(ctx, jsonStr, model, sizeof(model) / sizeof(CsonModel))
+
+/**
+ * @brief 使用上下文和预编译模型直接解析JSON字符串
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param jsonStr json字符串
+ * @param compiled 预编译模型
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeCompiledCtx(CsonContext *ctx, const char *jsonStr, CsonCompiledModel *compiled);
+
+/**
+ * @brief 使用上下文和预编译模型解析指定长度的JSON字符串
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param json json字符串，不需要以'\0'结尾
+ * @param len json字符串长度
+ * @param compiled 预编译模型
+ * @return void* 解析得到的对象
+ * @note 解析不会读取超出`len`的内容，可以直接解析大缓冲区中的一段
+ */
+void *csonDecodeCompiledLen(CsonContext *ctx, const char *json, size_t len,
+                            CsonCompiledModel *compiled);
+
+/**
+ * @brief 解析JSON字符串并就地更新已有对象
+ *
+ * @param obj 已有对象，由cson解析得到或者成员由`csonNewString`等分配
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param flags 更新标记，CSON_UPDATE_*
+ * @return int 0 成功 -1 失败
+ * @note 只更新json中存在的成员，其他成员保持不变，
+ *       字符串空间足够时直接写入，链表复用已有节点，vector容量足够时复用原有空间
+ */
+int csonDecodeInto(void *obj, const char *jsonStr, CsonModel *model, int modelSize, int flags);
+
+/**
+ * @brief 解析JSON字符串并就地更新已有对象
+ *
+ * @param obj 已有对象
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param flags 更新标记，CSON_UPDATE_*
+ * @return int 0 成功 -1 失败
+ */
+#define csonDecodeIntoEx(obj, jsonStr, model, flags) \
+        csonDecodeInto(obj, jsonStr, model, sizeof(model) / sizeof(CsonModel), flags)
+
+/**
+ * @brief 使用上下文解析JSON字符串并就地更新已有对象
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param obj 已有对象，由相同的分配函数分配
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param flags 更新标记，CSON_UPDATE_*
+ * @return int 0 成功 -1 失败，失败时`ctx->error`指向出错位置
+ * @note 新成员使用上下文的分配函数分配，被替换的成员使用上下文的释放函数释放，
+ *       上下文的选项同样生效，上下文不能设置内存池
+ */
+int csonDecodeIntoCtx(CsonContext *ctx, void *obj, const char *jsonStr,
+                      CsonModel *model, int modelSize, int flags);
+
+/**
+ * @brief 使用上下文解析JSON字符串并就地更新已有对象
+ *
+ * @param ctx 解析上下文
+ * @param obj 已有对象
+ * @param jsonStr json字符串
+ * @param model 数据模型
+ * @param flags 更新标记，CSON_UPDATE_*
+ * @return int 0 成功 -1 失败
+ */
+#define csonDecodeIntoCtxEx(ctx, obj, jsonStr, model, flags) \
+        csonDecodeIntoCtx(ctx, obj, jsonStr, model, sizeof(model) / sizeof(CsonModel), flags)
+
+/**
+ * @brief 校验json是否符合数据模型
+ *
+ * @param json json字符串，不需要以'\0'结尾
+ * @param len json字符串长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param error 校验错误，可为NULL
+ * @return int 0 校验通过 -1 校验失败
+ * @note 只扫描一次输入，不分配内存，检查json语法，成员是否存在，
+ *       值的类型以及数组元素数量，数据模型中有键值的成员都必须存在，
+ *       结构体、链表、CsonVector、数组和字符串成员可以为null
+ */
+int csonValidate(const char *json, size_t len, CsonModel *model, int modelSize,
+                 CsonValidateError *error);
+
+/**
+ * @brief 校验json是否符合数据模型
+ *
+ * @param json json字符串
+ * @param model 数据模型
+ * @param error 校验错误，可为NULL
+ * @return int 0 校验通过 -1 校验失败
+ */
+#define csonValidateEx(json, model, error) \
+        csonValidate(json, strlen(json), model, sizeof(model) / sizeof(CsonModel), error)
+
+/**
+ * @brief 创建增量解析器
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return CsonDecoder* 增量解析器
+ * @note 增量解析器用于分段接收的json，通过`csonDecoderFeed`逐段输入，
+ *       输入的分段不需要保留，解析结果与`csonDecodeDirect`一致
+ */
+CsonDecoder *csonDecoderCreate(CsonContext *ctx, CsonModel *model, int modelSize);
+
+/**
+ * @brief 创建增量解析器
+ *
+ * @param ctx 解析上下文
+ * @param model 数据模型
+ * @return CsonDecoder* 增量解析器
+ */
+#define csonDecoderCreateEx(ctx, model) \
+        csonDecoderCreate(ctx, model, sizeof(model) / sizeof(CsonModel))
+
+/**
+ * @brief 使用预编译模型创建增量解析器
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param compiled 预编译模型，需要在解析器释放前保持有效
+ * @return CsonDecoder* 增量解析器
+ */
+CsonDecoder *csonDecoderCreateCompiled(CsonContext *ctx, CsonCompiledModel *compiled);
+
+/**
+ * @brief 输入一段json
+ *
+ * @param decoder 增量解析器
+ * @param chunk json分段，不需要以'\0'结尾，函数返回后即可释放
+ * @param len 分段长度
+ * @return int 0 成功 -1 解析失败
+ * @note 解析失败后继续输入会直接返回-1，失败位置通过`csonDecoderOffset`获取
+ */
+int csonDecoderFeed(CsonDecoder *decoder, const char *chunk, size_t len);
+
+/**
+ * @brief 结束输入，获取解析结果
+ *
+ * @param decoder 增量解析器，调用后被释放
+ * @return void* 解析得到的对象，json不完整或解析失败时为NULL
+ */
+void *csonDecoderFinish(CsonDecoder *decoder);
+
+/**
+ * @brief 放弃解析并释放增量解析器
+ *
+ * @param decoder 增量解析器
+ * @note 已经解析出的部分对象会一并释放
+ */
+void csonDecoderFree(CsonDecoder *decoder);
+
+/**
+ * @brief 获取增量解析器已处理的字节数
+ *
+ * @param decoder 增量解析器
+ * @return size_t 已处理的字节数，解析失败后为失败位置在整个json中的偏移
+ */
+size_t csonDecoderOffset(CsonDecoder *decoder);
+
 /**
  * @brief 编码成json字符串
  * 
@@ -287,6 +757,7 @@ void *csonDecode(const char *jsonStr, CsonModel *model, int modelSize);
  * @param model 数据模型
  * @param modelSize 数据模型数量
  * @return char* 编码得到的json字符串
+ * @note cJSON节点以double保存数字，绝对值超过2^53的long成员会被舍入
  */
 cJSON* csonEncodeObject(void *obj, CsonModel *model, int modelSize);
 
@@ -299,9 +770,25 @@ cJSON* csonEncodeObject(void *obj, CsonModel *model, int modelSize);
  * @param bufferSize 分配给json字符串的空间大小
  * @param fmt 是否格式化json字符串
  * @return char* 编码得到的json字符串
+ * @note long成员按64位整数原样输出，绝对值超过2^53时与打印`csonEncodeObject`的结果不同
  */
 char* csonEncode(void *obj, CsonModel *model, int modelSize, int bufferSize, int fmt);
 
+/**
+ * @brief 使用上下文编码成json字符串
+ *
+ * @param ctx 内存分配上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param bufferSize 初始缓冲大小
+ * @param fmt 是否格式化json字符串
+ * @return char* 编码得到的json字符串，使用`csonFreeJsonCtx`释放
+ * @note 编码结果不从内存池中分配
+ */
+char* csonEncodeCtx(CsonContext *ctx, void *obj, CsonModel *model, int modelSize,
+                    int bufferSize, int fmt);
+
 /**
  * @brief 编码成json字符串
  * 
@@ -334,6 +821,154 @@ char* csonEncodeUnformatted(void *obj, CsonModel *model, int modelSize);
 #define csonEncodeUnformattedEx(obj, model) \
         csonEncodeUnformatted(obj, model, sizeof(model) / sizeof(CsonModel))
 
+/**
+ * @brief 编码json字符串到指定缓冲区
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param buf 输出缓冲区，可为NULL
+ * @param cap 输出缓冲区大小
+ * @param written 编码得到的json字符串长度，不包含结束符
+ * @return int 0 成功 -1 缓冲区空间不足
+ * @note 编码过程不分配内存，输出与`csonEncodeUnformatted`一致，
+ *       缓冲区空间不足时，`written`仍然返回完整的json长度
+ */
+int csonEncodeInto(void *obj, CsonModel *model, int modelSize,
+                   char *buf, size_t cap, size_t *written);
+
+/**
+ * @brief 编码json字符串到指定缓冲区
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param buf 输出缓冲区
+ * @param cap 输出缓冲区大小
+ * @param written 编码得到的json字符串长度，不包含结束符
+ * @return int 0 成功 -1 缓冲区空间不足
+ */
+#define csonEncodeIntoEx(obj, model, buf, cap, written) \
+        csonEncodeInto(obj, model, sizeof(model) / sizeof(CsonModel), buf, cap, written)
+
+/**
+ * @brief 编码json字符串并通过输出函数输出
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param write 输出函数，返回非0时停止编码
+ * @param param 输出函数参数
+ * @param fmt 是否格式化json字符串
+ * @return int 0 成功 -1 输出失败
+ * @note 只使用固定大小的栈上缓冲，适合直接输出到文件或网络，
+ *       输出内容与`csonEncode`一致
+ */
+int csonEncodeStream(void *obj, CsonModel *model, int modelSize,
+                     CsonWriteFunc write, void *param, int fmt);
+
+/**
+ * @brief 编码json字符串并通过输出函数输出
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param write 输出函数
+ * @param param 输出函数参数
+ * @param fmt 是否格式化json字符串
+ * @return int 0 成功 -1 输出失败
+ */
+#define csonEncodeStreamEx(obj, model, write, param, fmt) \
+        csonEncodeStream(obj, model, sizeof(model) / sizeof(CsonModel), write, param, fmt)
+
+/**
+ * @brief 编码成MessagePack
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param len 编码得到的数据长度
+ * @return char* 编码得到的数据，使用`csonFreeJson`释放
+ * @note 对象编码为以成员键值为键的映射，输出的成员与`csonEncode`一致，
+ *       float和double成员分别编码为单精度和双精度浮点数，子json转换为对应的MessagePack值
+ */
+char* csonEncodeMsgpack(void *obj, CsonModel *model, int modelSize, size_t *len);
+
+/**
+ * @brief 使用上下文编码成MessagePack
+ *
+ * @param ctx 内存分配上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param len 编码得到的数据长度
+ * @return char* 编码得到的数据，使用`csonFreeJsonCtx`释放
+ * @note 编码结果不从内存池中分配
+ */
+char* csonEncodeMsgpackCtx(CsonContext *ctx, void *obj, CsonModel *model, int modelSize,
+                           size_t *len);
+
+/**
+ * @brief 编码成MessagePack
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param len 编码得到的数据长度
+ * @return char* 编码得到的数据
+ */
+#define csonEncodeMsgpackEx(obj, model, len) \
+        csonEncodeMsgpack(obj, model, sizeof(model) / sizeof(CsonModel), len)
+
+/**
+ * @brief 编码成MessagePack并通过输出函数输出
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param write 输出函数，返回非0时停止编码
+ * @param param 输出函数参数
+ * @return int 0 成功 -1 输出失败
+ * @note 只使用固定大小的栈上缓冲，输出内容与`csonEncodeMsgpack`一致
+ */
+int csonEncodeMsgpackStream(void *obj, CsonModel *model, int modelSize,
+                            CsonWriteFunc write, void *param);
+
+/**
+ * @brief 解析MessagePack
+ *
+ * @param data MessagePack数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象，使用`csonFree`释放
+ * @note 类型转换和键值匹配规则与`csonDecodeDirect`一致，
+ *       字符串视图直接指向输入数据，输入需要在对象释放前保持有效
+ */
+void *csonDecodeMsgpack(const void *data, size_t len, CsonModel *model, int modelSize);
+
+/**
+ * @brief 使用上下文解析MessagePack
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param data MessagePack数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象，使用`csonFreeCtx`释放
+ * @note 解析失败时`ctx->error`指向输入数据中出错的位置
+ */
+void *csonDecodeMsgpackCtx(CsonContext *ctx, const void *data, size_t len,
+                           CsonModel *model, int modelSize);
+
+/**
+ * @brief 解析MessagePack
+ *
+ * @param data MessagePack数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @return void* 解析得到的对象
+ */
+#define csonDecodeMsgpackEx(data, len, model) \
+        csonDecodeMsgpack(data, len, model, sizeof(model) / sizeof(CsonModel))
+
 /**
  * @brief 释放CSON解析出的对象
  * 
@@ -352,6 +987,17 @@ void csonFree(void *obj, CsonModel *model, int modelSize);
 #define csonFreeEx(obj, model) \
         csonFree(obj, model, sizeof(model) / sizeof(CsonModel))
 
+/**
+ * @brief 使用上下文释放CSON解析出的对象
+ *
+ * @param ctx 解析时使用的上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param model 对象模型
+ * @param modelSize 对象模型数量
+ * @note 从内存池中解析得到的对象不需要释放
+ */
+void csonFreeCtx(CsonContext *ctx, void *obj, CsonModel *model, int modelSize);
+
 /**
  * @brief 释放cson编码生成的json字符串
  * 
@@ -359,6 +1005,14 @@ void csonFree(void *obj, CsonModel *model, int modelSize);
  */
 void csonFreeJson(const char *jsonStr);
 
+/**
+ * @brief 使用上下文释放cson编码生成的json字符串
+ *
+ * @param ctx 编码时使用的上下文，为NULL时使用默认上下文
+ * @param jsonStr json字符串
+ */
+void csonFreeJsonCtx(CsonContext *ctx, const char *jsonStr);
+
 /**
  * @brief CSON链表添加节点
  * 
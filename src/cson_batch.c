@@ -0,0 +1,285 @@
+/**
+ * @file cson_batch.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief cson批量解析
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 依赖pthread，只有需要批量解析时才需要编译此文件，
+ *       记录数组以及线程参数使用`csonInit`设置的分配函数
+ */
+
+#include "cson_batch.h"
+#include "cson_pool.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "pthread.h"
+#include "unistd.h"
+
+
+/**
+ * @brief 批量解析任务
+ *
+ */
+typedef struct
+{
+    CsonBatchRecord *records;           /**< 记录 */
+    size_t count;                       /**< 记录数量 */
+    size_t next;                        /**< 下一条待领取的记录 */
+    size_t chunk;                       /**< 每次领取的记录数量 */
+    size_t failed;                      /**< 解析失败的记录数量 */
+    CsonCompiledModel *compiled;        /**< 预编译模型 */
+    pthread_mutex_t lock;               /**< 任务锁 */
+} CsonBatchJob;
+
+
+/**
+ * @brief 批量解析工作线程参数
+ *
+ */
+typedef struct
+{
+    CsonBatchJob *job;                  /**< 批量解析任务 */
+    CsonContext *ctx;                   /**< 工作线程使用的上下文 */
+} CsonBatchWorker;
+
+
+/**
+ * @brief 判断记录是否为空行
+ *
+ * @param str 记录
+ * @param len 记录长度
+ * @return int 1 空行 0 非空行
+ */
+static int csonBatchIsBlank(const char *str, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if ((unsigned char)str[i] > 32)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+/**
+ * @brief 按行切分记录
+ *
+ * @param buffer NDJSON数据
+ * @param len 数据长度
+ * @param records 记录，为NULL时只统计数量
+ * @return size_t 记录数量
+ */
+static size_t csonBatchSplit(const char *buffer, size_t len, CsonBatchRecord *records)
+{
+    const char *pos = buffer;
+    const char *end = buffer + len;
+    const char *line;
+    size_t count = 0;
+
+    while (pos < end)
+    {
+        line = memchr(pos, '\n', end - pos);
+        if (!line)
+        {
+            line = end;
+        }
+        if (!csonBatchIsBlank(pos, line - pos))
+        {
+            if (records)
+            {
+                records[count].obj = NULL;
+                records[count].record = pos;
+                records[count].length = line - pos;
+                records[count].error = NULL;
+                records[count].ctx = NULL;
+            }
+            count++;
+        }
+        pos = line + 1;
+    }
+    return count;
+}
+
+
+/**
+ * @brief 批量解析工作线程
+ *
+ * @param param 工作线程参数
+ * @return void* NULL
+ */
+static void *csonBatchWork(void *param)
+{
+    CsonBatchWorker *worker = param;
+    CsonBatchJob *job = worker->job;
+    CsonContext ctx = {0};
+    CsonBatchRecord *record;
+    size_t start, end, failed = 0;
+
+    if (worker->ctx)
+    {
+        ctx = *worker->ctx;
+    }
+    ctx.options |= CSON_OPTION_REQUIRE_END;
+    while (1)
+    {
+        pthread_mutex_lock(&job->lock);
+        start = job->next;
+        end = job->count - start > job->chunk ? start + job->chunk : job->count;
+        job->next = end;
+        pthread_mutex_unlock(&job->lock);
+        if (start >= end)
+        {
+            break;
+        }
+        for (size_t i = start; i < end; i++)
+        {
+            record = &job->records[i];
+            record->obj = csonDecodeCompiledLen(&ctx, record->record, record->length,
+                job->compiled);
+            record->error = ctx.error;
+            record->ctx = worker->ctx;
+            if (!record->obj && ctx.error)
+            {
+                failed++;
+            }
+        }
+    }
+    pthread_mutex_lock(&job->lock);
+    job->failed += failed;
+    pthread_mutex_unlock(&job->lock);
+    return NULL;
+}
+
+
+/**
+ * @brief 批量解析创建的线程
+ *
+ * @param param 工作线程参数
+ * @return void* NULL
+ * @note 线程退出前释放节点池缓存的节点，调用线程的节点池保持不变
+ */
+static void *csonBatchThread(void *param)
+{
+    csonBatchWork(param);
+    csonPoolRelease();
+    return NULL;
+}
+
+
+/**
+ * @brief 多线程批量解析NDJSON(JSON Lines)
+ *
+ * @param buffer NDJSON数据，每行一条记录，不需要以'\0'结尾
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param threads 工作线程数量，小于等于0时使用CPU核心数
+ * @param contexts 每个工作线程使用的解析上下文数组，为NULL时使用默认上下文
+ * @param records 解析结果
+ * @param count 记录数量
+ * @return int 解析失败的记录数量，-1 批量解析无法启动
+ */
+int csonDecodeBatch(const char *buffer, size_t len, CsonModel *model, int modelSize,
+                    int threads, CsonContext *contexts,
+                    CsonBatchRecord **records, size_t *count)
+{
+    CsonBatchJob job = {0};
+    CsonBatchWorker *workers;
+    pthread_t *tids;
+    int started = 0;
+
+    CSON_ASSERT(buffer && model && records && count, return -1);
+    *records = NULL;
+    *count = 0;
+
+    if (threads <= 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    job.count = csonBatchSplit(buffer, len, NULL);
+    if (job.count == 0)
+    {
+        return 0;
+    }
+    if ((size_t)threads > job.count)
+    {
+        threads = (int)job.count;
+    }
+    /* 每个线程平均领取CSON_BATCH_CHUNK_ROUNDS次，记录较少时每次领取的数量随之减少 */
+    job.chunk = job.count / ((size_t)threads * CSON_BATCH_CHUNK_ROUNDS);
+    if (job.chunk == 0)
+    {
+        job.chunk = 1;
+    }
+    else if (job.chunk > CSON_BATCH_CHUNK_SIZE)
+    {
+        job.chunk = CSON_BATCH_CHUNK_SIZE;
+    }
+
+    job.compiled = csonCompileModel(model, modelSize);
+    job.records = csonCtxMalloc(NULL, job.count * sizeof(CsonBatchRecord));
+    workers = csonCtxMalloc(NULL, threads * sizeof(CsonBatchWorker));
+    tids = csonCtxMalloc(NULL, threads * sizeof(pthread_t));
+    if (!job.compiled || !job.records || !workers || !tids
+        || pthread_mutex_init(&job.lock, NULL) != 0)
+    {
+        csonFreeCompiledModel(job.compiled);
+        csonCtxFree(NULL, job.records);
+        csonCtxFree(NULL, workers);
+        csonCtxFree(NULL, tids);
+        CSON_ASSERT(0, return -1);
+    }
+    csonBatchSplit(buffer, len, job.records);
+
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i].job = &job;
+        workers[i].ctx = contexts ? &contexts[i] : NULL;
+        if (i > 0 && pthread_create(&tids[started], NULL, csonBatchThread, &workers[i]) == 0)
+        {
+            started++;
+        }
+    }
+    csonBatchWork(&workers[0]);
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(tids[i], NULL);
+    }
+
+    pthread_mutex_destroy(&job.lock);
+    csonFreeCompiledModel(job.compiled);
+    csonCtxFree(NULL, workers);
+    csonCtxFree(NULL, tids);
+    *records = job.records;
+    *count = job.count;
+    return (int)job.failed;
+}
+
+
+/**
+ * @brief 释放批量解析结果
+ *
+ * @param records 解析结果
+ * @param count 记录数量
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ */
+void csonFreeBatch(CsonBatchRecord *records, size_t count, CsonModel *model, int modelSize)
+{
+    if (!records)
+    {
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        csonFreeCtx(records[i].ctx, records[i].obj, model, modelSize);
+    }
+    csonCtxFree(NULL, records);
+}
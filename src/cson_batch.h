@@ -0,0 +1,89 @@
+/**
+ * @file cson_batch.h
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief cson批量解析
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ */
+
+#ifndef __CSON_BATCH_H__
+#define __CSON_BATCH_H__
+
+#include "cson.h"
+
+/**
+ * @addtogroup CSON
+ * @{
+ */
+
+#define CSON_BATCH_CHUNK_SIZE       256     /**< 工作线程每次最多领取的记录数量 */
+#define CSON_BATCH_CHUNK_ROUNDS     8       /**< 每个工作线程平均领取的次数，记录较少时按此减小每次领取的数量 */
+
+
+/**
+ * @brief 批量解析记录
+ *
+ */
+typedef struct cson_batch_record
+{
+    void *obj;                          /**< 解析得到的对象，解析失败时为NULL */
+    const char *record;                 /**< 记录在输入缓冲中的起始位置 */
+    size_t length;                      /**< 记录长度，不包含换行符 */
+    const char *error;                  /**< 解析失败的位置，解析成功时为NULL */
+    CsonContext *ctx;                   /**< 解析使用的上下文，使用默认上下文时为NULL */
+} CsonBatchRecord;
+
+
+/**
+ * @brief 多线程批量解析NDJSON(JSON Lines)
+ *
+ * @param buffer NDJSON数据，每行一条记录，不需要以'\0'结尾
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @param threads 工作线程数量，小于等于0时使用CPU核心数
+ * @param contexts 每个工作线程使用的解析上下文数组，长度为`threads`，为NULL时使用默认上下文
+ * @param records 解析结果，按输入顺序排列，空行不产生记录，使用`csonFreeBatch`释放
+ * @param count 记录数量
+ * @return int 解析失败的记录数量，-1 批量解析无法启动
+ * @note 每条记录都必须是完整的json值，记录之后只允许空白字符，
+ *       线程数量不超过记录数量，记录数组使用`csonInit`设置的分配函数
+ */
+int csonDecodeBatch(const char *buffer, size_t len, CsonModel *model, int modelSize,
+                    int threads, CsonContext *contexts,
+                    CsonBatchRecord **records, size_t *count);
+
+/**
+ * @brief 多线程批量解析NDJSON(JSON Lines)
+ *
+ * @param buffer NDJSON数据
+ * @param len 数据长度
+ * @param model 数据模型
+ * @param threads 工作线程数量
+ * @param records 解析结果
+ * @param count 记录数量
+ * @return int 解析失败的记录数量，-1 批量解析无法启动
+ */
+#define csonDecodeBatchEx(buffer, len, model, threads, records, count) \
+        csonDecodeBatch(buffer, len, model, sizeof(model) / sizeof(CsonModel), \
+                        threads, NULL, records, count)
+
+/**
+ * @brief 释放批量解析结果
+ *
+ * @param records 解析结果
+ * @param count 记录数量
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @note 每条记录的对象使用解析时的上下文释放
+ */
+void csonFreeBatch(CsonBatchRecord *records, size_t count, CsonModel *model, int modelSize);
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,502 @@
+/**
+ * @file cson_gen.h
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief cson专用编解码函数生成
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 通过X宏为结构体生成数据模型以及专用的解析和编码函数，
+ *       生成的函数直接按成员展开，不再遍历数据模型和逐个比较键值，
+ *       解析和输出结果与`csonDecodeDirect`，`csonEncode`一致
+ */
+
+#ifndef __CSON_GEN_H__
+#define __CSON_GEN_H__
+
+#include "cson.h"
+#include "string.h"
+
+/**
+ * @brief json读取器
+ *
+ * @note 生成的解析函数使用，由`csonDecodeGenerated`创建
+ */
+typedef struct cson_reader CsonReader;
+
+/**
+ * @brief json输出器
+ *
+ * @note 生成的编码函数使用，由`csonEncodeGenerated`创建
+ */
+typedef struct cson_writer CsonWriter;
+
+/**
+ * @brief 生成的对象解析函数
+ *
+ * @param reader 读取器
+ * @param obj 解析得到的对象，json为null时为NULL
+ * @return int 0 成功 -1 失败，失败时对象已释放
+ */
+typedef int (*CsonReadFunc)(CsonReader *reader, void **obj);
+
+/**
+ * @brief 生成的对象输出函数
+ *
+ * @param writer 输出器
+ * @param obj 对象
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+typedef int (*CsonPrintFunc)(CsonWriter *writer, void *obj, int depth, int fmt);
+
+
+/**
+ * @brief 基础类型子模型，可以作为成员列表中LIST，VECTOR的子模型名使用
+ *
+ */
+#define csonCharModel               CSON_MODEL_CHAR_LIST
+#define csonCharModelSize           CSON_BASIC_LIST_MODEL_SIZE
+#define csonShortModel              CSON_MODEL_SHORT_LIST
+#define csonShortModelSize          CSON_BASIC_LIST_MODEL_SIZE
+#define csonIntModel                CSON_MODEL_INT_LIST
+#define csonIntModelSize            CSON_BASIC_LIST_MODEL_SIZE
+#define csonLongModel               CSON_MODEL_LONG_LIST
+#define csonLongModelSize           CSON_BASIC_LIST_MODEL_SIZE
+#define csonFloatModel              CSON_MODEL_FLOAT_LIST
+#define csonFloatModelSize          CSON_BASIC_LIST_MODEL_SIZE
+#define csonDoubleModel             CSON_MODEL_DOUBLE_LIST
+#define csonDoubleModelSize         CSON_BASIC_LIST_MODEL_SIZE
+#define csonStringModel             CSON_MODEL_STRING_LIST
+#define csonStringModelSize         CSON_BASIC_LIST_MODEL_SIZE
+
+
+/**
+ * @brief 成员数据模型
+ *
+ * @note 成员列表中每一项为`X(type, kind, key, arg)`，kind为下列宏的后缀，
+ *       STRUCT，LIST，VECTOR的arg为同样由`CSON_GENERATE`生成的子模型名，
+ *       LIST，VECTOR也可以使用csonInt等基础类型子模型名，
+ *       *_ARRAY的arg为数组大小，其他类型的arg不使用
+ */
+#define CSON_GEN_MODEL(type, kind, key, arg) \
+        CSON_GEN_MODEL_##kind(type, key, arg),
+#define CSON_GEN_MODEL_CHAR(type, key, arg)         CSON_MODEL_CHAR(type, key)
+#define CSON_GEN_MODEL_SHORT(type, key, arg)        CSON_MODEL_SHORT(type, key)
+#define CSON_GEN_MODEL_INT(type, key, arg)          CSON_MODEL_INT(type, key)
+#define CSON_GEN_MODEL_LONG(type, key, arg)         CSON_MODEL_LONG(type, key)
+#define CSON_GEN_MODEL_FLOAT(type, key, arg)        CSON_MODEL_FLOAT(type, key)
+#define CSON_GEN_MODEL_DOUBLE(type, key, arg)       CSON_MODEL_DOUBLE(type, key)
+#define CSON_GEN_MODEL_BOOL(type, key, arg)         CSON_MODEL_BOOL(type, key)
+#define CSON_GEN_MODEL_STRING(type, key, arg)       CSON_MODEL_STRING(type, key)
+#define CSON_GEN_MODEL_STRING_VIEW(type, key, arg)  CSON_MODEL_STRING_VIEW(type, key)
+#define CSON_GEN_MODEL_JSON(type, key, arg)         CSON_MODEL_JSON(type, key)
+#define CSON_GEN_MODEL_STRUCT(type, key, arg) \
+        CSON_MODEL_STRUCT(type, key, arg##Model, arg##ModelSize)
+#define CSON_GEN_MODEL_LIST(type, key, arg) \
+        CSON_MODEL_LIST(type, key, arg##Model, arg##ModelSize)
+#define CSON_GEN_MODEL_VECTOR(type, key, arg) \
+        CSON_MODEL_VECTOR(type, key, arg##Model, arg##ModelSize)
+#define CSON_GEN_MODEL_CHAR_ARRAY(type, key, arg) \
+        CSON_MODEL_ARRAY(type, key, CSON_TYPE_CHAR, arg)
+#define CSON_GEN_MODEL_SHORT_ARRAY(type, key, arg) \
+        CSON_MODEL_ARRAY(type, key, CSON_TYPE_SHORT, arg)
+#define CSON_GEN_MODEL_INT_ARRAY(type, key, arg) \
+        CSON_MODEL_ARRAY(type, key, CSON_TYPE_INT, arg)
+#define CSON_GEN_MODEL_LONG_ARRAY(type, key, arg) \
+        CSON_MODEL_ARRAY(type, key, CSON_TYPE_LONG, arg)
+#define CSON_GEN_MODEL_FLOAT_ARRAY(type, key, arg) \
+        CSON_MODEL_ARRAY(type, key, CSON_TYPE_FLOAT, arg)
+#define CSON_GEN_MODEL_DOUBLE_ARRAY(type, key, arg) \
+        CSON_MODEL_ARRAY(type, key, CSON_TYPE_DOUBLE, arg)
+#define CSON_GEN_MODEL_STRING_ARRAY(type, key, arg) \
+        CSON_MODEL_ARRAY(type, key, CSON_TYPE_STRING, arg)
+
+/**
+ * @brief 成员序号，成员i对应数据模型中的第i + 1项
+ *
+ */
+#define CSON_GEN_INDEX(type, kind, key, arg) \
+        CSON_GEN_INDEX_##key,
+
+#define CSON_GEN_SEEN(key) \
+        (seen[CSON_GEN_INDEX_##key >> 3] & (1 << (CSON_GEN_INDEX_##key & 7)))
+
+/**
+ * @brief 成员解析
+ *
+ * @note 展开在生成的解析函数的成员循环中，键值匹配时解析成员并进入下一个成员，
+ *       先比较键值长度，只有长度相同或者键值包含转义时才逐字符比较
+ */
+#define CSON_GEN_READ(type, kind, key, arg) \
+        if (!CSON_GEN_SEEN(key) && (escaped || len == sizeof(#key) - 1) \
+            && csonReadKeyMatch(reader, str, len, escaped, #key, sizeof(#key) - 1)) \
+        { \
+            if ((ret = CSON_GEN_READ_##kind(type, key, arg)) != 0) \
+            { \
+                break; \
+            } \
+            seen[CSON_GEN_INDEX_##key >> 3] |= 1 << (CSON_GEN_INDEX_##key & 7); \
+            continue; \
+        }
+#define CSON_GEN_READ_VALUE(key, valueType) \
+        csonReadValue(reader, &obj->key, valueType)
+#define CSON_GEN_READ_FIELD(key) \
+        csonReadField(reader, obj, &model[CSON_GEN_INDEX_##key + 1])
+#define CSON_GEN_READ_CHAR(type, key, arg)          CSON_GEN_READ_VALUE(key, CSON_TYPE_CHAR)
+#define CSON_GEN_READ_SHORT(type, key, arg)         CSON_GEN_READ_VALUE(key, CSON_TYPE_SHORT)
+#define CSON_GEN_READ_INT(type, key, arg)           CSON_GEN_READ_VALUE(key, CSON_TYPE_INT)
+#define CSON_GEN_READ_LONG(type, key, arg)          CSON_GEN_READ_VALUE(key, CSON_TYPE_LONG)
+#define CSON_GEN_READ_FLOAT(type, key, arg)         CSON_GEN_READ_VALUE(key, CSON_TYPE_FLOAT)
+#define CSON_GEN_READ_DOUBLE(type, key, arg)        CSON_GEN_READ_VALUE(key, CSON_TYPE_DOUBLE)
+#define CSON_GEN_READ_BOOL(type, key, arg)          CSON_GEN_READ_VALUE(key, CSON_TYPE_CHAR)
+#define CSON_GEN_READ_STRING(type, key, arg)        CSON_GEN_READ_VALUE(key, CSON_TYPE_STRING)
+#define CSON_GEN_READ_STRING_VIEW(type, key, arg)   CSON_GEN_READ_VALUE(key, CSON_TYPE_STRING_VIEW)
+#define CSON_GEN_READ_STRUCT(type, key, arg) \
+        arg##Read(reader, (void **)&obj->key)
+#define CSON_GEN_READ_JSON(type, key, arg)          CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_LIST(type, key, arg)          CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_VECTOR(type, key, arg)        CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_CHAR_ARRAY(type, key, arg)    CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_SHORT_ARRAY(type, key, arg)   CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_INT_ARRAY(type, key, arg)     CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_LONG_ARRAY(type, key, arg)    CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_FLOAT_ARRAY(type, key, arg)   CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_DOUBLE_ARRAY(type, key, arg)  CSON_GEN_READ_FIELD(key)
+#define CSON_GEN_READ_STRING_ARRAY(type, key, arg)  CSON_GEN_READ_FIELD(key)
+
+/**
+ * @brief 成员输出
+ *
+ * @note 展开在生成的输出函数中，与`csonEncode`一致，
+ *       值为NULL的字符串、结构体不会被输出
+ */
+#define CSON_GEN_PRINT(type, kind, key, arg) \
+        if (CSON_GEN_PRINT_##kind(type, key, arg) != 0) \
+        { \
+            return -1; \
+        }
+#define CSON_GEN_PRINT_KEY(key) \
+        csonWriteKey(writer, #key, sizeof(#key) - 1, count++, depth, fmt)
+#define CSON_GEN_PRINT_VALUE(key, valueType) \
+        (CSON_GEN_PRINT_KEY(key) || csonWriteValue(writer, &obj->key, valueType))
+#define CSON_GEN_PRINT_FIELD(key) \
+        csonWriteMember(writer, obj, &model[CSON_GEN_INDEX_##key + 1], &count, depth, fmt)
+#define CSON_GEN_PRINT_CHAR(type, key, arg)         CSON_GEN_PRINT_VALUE(key, CSON_TYPE_CHAR)
+#define CSON_GEN_PRINT_SHORT(type, key, arg)        CSON_GEN_PRINT_VALUE(key, CSON_TYPE_SHORT)
+#define CSON_GEN_PRINT_INT(type, key, arg)          CSON_GEN_PRINT_VALUE(key, CSON_TYPE_INT)
+#define CSON_GEN_PRINT_LONG(type, key, arg)         CSON_GEN_PRINT_VALUE(key, CSON_TYPE_LONG)
+#define CSON_GEN_PRINT_FLOAT(type, key, arg)        CSON_GEN_PRINT_VALUE(key, CSON_TYPE_FLOAT)
+#define CSON_GEN_PRINT_DOUBLE(type, key, arg)       CSON_GEN_PRINT_VALUE(key, CSON_TYPE_DOUBLE)
+#define CSON_GEN_PRINT_BOOL(type, key, arg)         CSON_GEN_PRINT_VALUE(key, CSON_TYPE_CHAR)
+#define CSON_GEN_PRINT_STRING(type, key, arg) \
+        (obj->key && CSON_GEN_PRINT_VALUE(key, CSON_TYPE_STRING))
+#define CSON_GEN_PRINT_STRING_VIEW(type, key, arg) \
+        (obj->key.str && CSON_GEN_PRINT_VALUE(key, CSON_TYPE_STRING_VIEW))
+#define CSON_GEN_PRINT_STRUCT(type, key, arg) \
+        (obj->key && (CSON_GEN_PRINT_KEY(key) || arg##Print(writer, obj->key, depth + 1, fmt)))
+#define CSON_GEN_PRINT_JSON(type, key, arg)         CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_LIST(type, key, arg)         CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_VECTOR(type, key, arg)       CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_CHAR_ARRAY(type, key, arg)   CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_SHORT_ARRAY(type, key, arg)  CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_INT_ARRAY(type, key, arg)    CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_LONG_ARRAY(type, key, arg)   CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_FLOAT_ARRAY(type, key, arg)  CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_DOUBLE_ARRAY(type, key, arg) CSON_GEN_PRINT_FIELD(key)
+#define CSON_GEN_PRINT_STRING_ARRAY(type, key, arg) CSON_GEN_PRINT_FIELD(key)
+
+
+/**
+ * @brief 声明`CSON_GENERATE`生成的数据模型和函数，在头文件中使用
+ *
+ * @param name 生成名
+ */
+#define CSON_GENERATE_DECLARE(name) \
+        extern CsonModel name##Model[]; \
+        int name##Read(CsonReader *reader, void **obj); \
+        int name##Print(CsonWriter *writer, void *obj, int depth, int fmt); \
+        void *name##Decode(const char *jsonStr); \
+        void *name##DecodeCtx(CsonContext *ctx, const char *jsonStr); \
+        char *name##Encode(void *obj, int bufferSize, int fmt); \
+        char *name##EncodeCtx(CsonContext *ctx, void *obj, int bufferSize, int fmt); \
+        void name##Free(void *obj); \
+        void name##FreeCtx(CsonContext *ctx, void *obj)
+
+/**
+ * @brief 生成结构体的数据模型和专用编解码函数
+ *
+ * @param name 生成名，生成`name##Model`，`name##Decode`，`name##Encode`，`name##Free`等
+ * @param type 结构体类型
+ * @param FIELDS 成员列表宏，形如`#define FIELDS(X, T) X(T, INT, id, 0) X(T, STRING, name, 0)`，
+ *               成员名同时作为json键值
+ * @note 子结构体需要在使用前生成，不支持自身递归引用的结构体，
+ *       成员名只有大小写不同时，json键值只解析到第一个成员，
+ *       解析得到的对象使用`name##Free`或者`csonFree`释放
+ */
+#define CSON_GENERATE(name, type, FIELDS) \
+        CsonModel name##Model[] = \
+        { \
+            CSON_MODEL_OBJ(type), \
+            FIELDS(CSON_GEN_MODEL, type) \
+        }; \
+        enum { name##ModelSize = sizeof(name##Model) / sizeof(CsonModel) }; \
+        int name##Read(CsonReader *reader, void **out) \
+        { \
+            enum { FIELDS(CSON_GEN_INDEX, type) CSON_GEN_FIELD_COUNT }; \
+            unsigned char seen[CSON_GEN_FIELD_COUNT / 8 + 1] = {0}; \
+            CsonModel *model = name##Model; \
+            type *obj; \
+            const char *str; \
+            int len, escaped, first; \
+            int ret = csonReadBegin(reader, out, sizeof(type)); \
+            if (ret <= 0) \
+            { \
+                return ret; \
+            } \
+            obj = *out; \
+            (void)model; \
+            for (first = 1; (ret = csonReadKey(reader, &str, &len, &escaped, first)) > 0; first = 0) \
+            { \
+                FIELDS(CSON_GEN_READ, type) \
+                if ((ret = csonReadSkip(reader)) != 0) \
+                { \
+                    break; \
+                } \
+            } \
+            if (ret != 0) \
+            { \
+                csonReadFree(reader, obj, name##Model, name##ModelSize); \
+                *out = NULL; \
+                return -1; \
+            } \
+            return 0; \
+        } \
+        int name##Print(CsonWriter *writer, void *ptr, int depth, int fmt) \
+        { \
+            enum { FIELDS(CSON_GEN_INDEX, type) CSON_GEN_FIELD_COUNT }; \
+            CsonModel *model = name##Model; \
+            type *obj = ptr; \
+            int count = 0; \
+            if (!obj) \
+            { \
+                return csonWriteNull(writer); \
+            } \
+            if (csonWriteObjectBegin(writer, fmt) != 0) \
+            { \
+                return -1; \
+            } \
+            (void)model; \
+            FIELDS(CSON_GEN_PRINT, type) \
+            return csonWriteObjectEnd(writer, count, depth, fmt); \
+        } \
+        void *name##Decode(const char *jsonStr) \
+        { \
+            return csonDecodeGenerated(NULL, jsonStr, name##Read, name##Model, name##ModelSize); \
+        } \
+        void *name##DecodeCtx(CsonContext *ctx, const char *jsonStr) \
+        { \
+            return csonDecodeGenerated(ctx, jsonStr, name##Read, name##Model, name##ModelSize); \
+        } \
+        char *name##Encode(void *obj, int bufferSize, int fmt) \
+        { \
+            return csonEncodeGenerated(NULL, obj, name##Print, bufferSize, fmt); \
+        } \
+        char *name##EncodeCtx(CsonContext *ctx, void *obj, int bufferSize, int fmt) \
+        { \
+            return csonEncodeGenerated(ctx, obj, name##Print, bufferSize, fmt); \
+        } \
+        void name##Free(void *obj) \
+        { \
+            csonFree(obj, name##Model, name##ModelSize); \
+        } \
+        void name##FreeCtx(CsonContext *ctx, void *obj) \
+        { \
+            csonFreeCtx(ctx, obj, name##Model, name##ModelSize); \
+        }
+
+
+/**
+ * @brief 开始解析对象
+ *
+ * @param reader 读取器
+ * @param obj 分配的对象，json为null时为NULL
+ * @param objSize 对象大小
+ * @return int 1 json为对象，需要继续解析成员 0 解析完成 -1 失败
+ * @note 与`csonDecodeDirect`一致，json不是对象时得到清零的对象
+ */
+int csonReadBegin(CsonReader *reader, void **obj, int objSize);
+
+/**
+ * @brief 读取对象成员的键值
+ *
+ * @param reader 读取器
+ * @param str 键值原始内容
+ * @param len 键值原始内容长度
+ * @param escaped 键值是否包含转义
+ * @param first 是否为对象的第一个成员
+ * @return int 1 读取到键值，已跳过冒号 0 对象结束 -1 失败
+ */
+int csonReadKey(CsonReader *reader, const char **str, int *len, int *escaped, int first);
+
+/**
+ * @brief 比较键值
+ *
+ * @param str 键值原始内容
+ * @param len 键值原始内容长度
+ * @param escaped 键值是否包含转义
+ * @param key 模型键值
+ * @return int 是否相等
+ * @note 与cJSON_GetObjectItem一致，不区分大小写
+ */
+int csonReadKeyEqual(const char *str, int len, int escaped, const char *key);
+
+/**
+ * @brief 按读取器的解析选项比较键值
+ *
+ * @param reader 读取器
+ * @param str 键值原始内容
+ * @param len 键值原始内容长度
+ * @param escaped 键值是否包含转义
+ * @param key 模型键值
+ * @param keyLen 模型键值长度
+ * @return int 是否相等
+ * @note 上下文选项包含`CSON_OPTION_CASE_SENSITIVE`时区分大小写，
+ *       此时不包含转义的键值只比较长度和memcmp
+ */
+int csonReadKeyMatch(CsonReader *reader, const char *str, int len, int escaped,
+                     const char *key, int keyLen);
+
+/**
+ * @brief 读取基本类型值
+ *
+ * @param reader 读取器
+ * @param ptr 写入地址
+ * @param type 数据类型
+ * @return int 0 成功 -1 失败
+ */
+int csonReadValue(CsonReader *reader, void *ptr, CsonType type);
+
+/**
+ * @brief 按成员数据模型读取成员
+ *
+ * @param reader 读取器
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @return int 0 成功 -1 失败
+ */
+int csonReadField(CsonReader *reader, void *obj, CsonModel *field);
+
+/**
+ * @brief 跳过一个值
+ *
+ * @param reader 读取器
+ * @return int 0 成功 -1 失败
+ */
+int csonReadSkip(CsonReader *reader);
+
+/**
+ * @brief 释放解析失败的对象
+ *
+ * @param reader 读取器
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @note 使用内存池时不释放
+ */
+void csonReadFree(CsonReader *reader, void *obj, CsonModel *model, int modelSize);
+
+/**
+ * @brief 使用生成的解析函数解析json字符串
+ *
+ * @param ctx 解析上下文，为NULL时使用默认上下文
+ * @param jsonStr json字符串
+ * @param read 生成的解析函数
+ * @param model 数据模型
+ * @param modelSize 数据模型数量
+ * @return void* 解析得到的对象
+ */
+void *csonDecodeGenerated(CsonContext *ctx, const char *jsonStr, CsonReadFunc read,
+                          CsonModel *model, int modelSize);
+
+/**
+ * @brief 输出null
+ *
+ * @param writer 输出器
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteNull(CsonWriter *writer);
+
+/**
+ * @brief 输出对象开始符
+ *
+ * @param writer 输出器
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteObjectBegin(CsonWriter *writer, int fmt);
+
+/**
+ * @brief 输出对象成员的键值
+ *
+ * @param writer 输出器
+ * @param key 键值
+ * @param len 键值长度
+ * @param index 成员序号，不为0时先输出分隔符
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteKey(CsonWriter *writer, const char *key, int len, int index, int depth, int fmt);
+
+/**
+ * @brief 输出基本类型值
+ *
+ * @param writer 输出器
+ * @param ptr 数据地址
+ * @param type 数据类型
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteValue(CsonWriter *writer, void *ptr, CsonType type);
+
+/**
+ * @brief 按成员数据模型输出成员
+ *
+ * @param writer 输出器
+ * @param obj 对象
+ * @param field 成员数据模型
+ * @param count 已输出的成员数量，输出成员后加1
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteMember(CsonWriter *writer, void *obj, CsonModel *field, int *count,
+                    int depth, int fmt);
+
+/**
+ * @brief 输出对象结束符
+ *
+ * @param writer 输出器
+ * @param count 已输出的成员数量
+ * @param depth 对象深度
+ * @param fmt 是否格式化
+ * @return int 0 成功 -1 失败
+ */
+int csonWriteObjectEnd(CsonWriter *writer, int count, int depth, int fmt);
+
+/**
+ * @brief 使用生成的输出函数编码成json字符串
+ *
+ * @param ctx 内存分配上下文，为NULL时使用默认上下文
+ * @param obj 对象
+ * @param print 生成的输出函数
+ * @param bufferSize 初始缓冲大小
+ * @param fmt 是否格式化json字符串
+ * @return char* 编码得到的json字符串
+ */
+char *csonEncodeGenerated(CsonContext *ctx, void *obj, CsonPrintFunc print,
+                          int bufferSize, int fmt);
+
+#endif
@@ -0,0 +1,894 @@
+/**
+ * @file cson_number.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief json数字解析与输出
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ */
+
+#include "cson_number.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "limits.h"
+
+#define CSON_NUMBER_MAX_DIGITS      19      /**< uint64_t可以直接累加的十进制位数 */
+#define CSON_NUMBER_MAX_EXACT       ((uint64_t)1 << 53)     /**< double可以精确表示的最大整数 */
+#define CSON_NUMBER_MAX_EXPONENT    100000  /**< 指数部分的累加上限，超过后结果必然溢出或为0 */
+#define CSON_NUMBER_SLOW_DIGITS     780     /**< 慢速解析保留的有效位数，超过double正确舍入需要的767位 */
+
+#define CSON_NUMBER_DIGIT(p, e)     ((p) != (e) && *(p) >= '0' && *(p) <= '9')
+
+
+/**
+ * @brief 二进制浮点数 f * 2^e
+ *
+ */
+typedef struct
+{
+    uint64_t f;                         /**< 有效数 */
+    int e;                              /**< 二进制指数 */
+} CsonDiyFp;
+
+
+/**
+ * @brief 可以用double精确表示的10的幂
+ *
+ */
+static const double csonNumberPow10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/**
+ * @brief 10的幂，整数形式
+ *
+ */
+static const uint64_t csonNumberPow10U64[] =
+{
+    UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000), UINT64_C(10000),
+    UINT64_C(100000), UINT64_C(1000000), UINT64_C(10000000), UINT64_C(100000000),
+    UINT64_C(1000000000), UINT64_C(10000000000), UINT64_C(100000000000),
+    UINT64_C(1000000000000), UINT64_C(10000000000000), UINT64_C(100000000000000),
+    UINT64_C(1000000000000000), UINT64_C(10000000000000000),
+    UINT64_C(100000000000000000), UINT64_C(1000000000000000000),
+    UINT64_C(10000000000000000000)
+};
+
+
+/**
+ * @brief Grisu使用的10的幂缓存，10^-348到10^340，步长为8
+ *
+ */
+static const struct
+{
+    uint64_t f;
+    int16_t e;
+} csonNumberCachedPowers[] =
+{
+    {UINT64_C(0xfa8fd5a0081c0288), -1220}, {UINT64_C(0xbaaee17fa23ebf76), -1193},
+    {UINT64_C(0x8b16fb203055ac76), -1166}, {UINT64_C(0xcf42894a5dce35ea), -1140},
+    {UINT64_C(0x9a6bb0aa55653b2d), -1113}, {UINT64_C(0xe61acf033d1a45df), -1087},
+    {UINT64_C(0xab70fe17c79ac6ca), -1060}, {UINT64_C(0xff77b1fcbebcdc4f), -1034},
+    {UINT64_C(0xbe5691ef416bd60c), -1007}, {UINT64_C(0x8dd01fad907ffc3c), -980},
+    {UINT64_C(0xd3515c2831559a83), -954}, {UINT64_C(0x9d71ac8fada6c9b5), -927},
+    {UINT64_C(0xea9c227723ee8bcb), -901}, {UINT64_C(0xaecc49914078536d), -874},
+    {UINT64_C(0x823c12795db6ce57), -847}, {UINT64_C(0xc21094364dfb5637), -821},
+    {UINT64_C(0x9096ea6f3848984f), -794}, {UINT64_C(0xd77485cb25823ac7), -768},
+    {UINT64_C(0xa086cfcd97bf97f4), -741}, {UINT64_C(0xef340a98172aace5), -715},
+    {UINT64_C(0xb23867fb2a35b28e), -688}, {UINT64_C(0x84c8d4dfd2c63f3b), -661},
+    {UINT64_C(0xc5dd44271ad3cdba), -635}, {UINT64_C(0x936b9fcebb25c996), -608},
+    {UINT64_C(0xdbac6c247d62a584), -582}, {UINT64_C(0xa3ab66580d5fdaf6), -555},
+    {UINT64_C(0xf3e2f893dec3f126), -529}, {UINT64_C(0xb5b5ada8aaff80b8), -502},
+    {UINT64_C(0x87625f056c7c4a8b), -475}, {UINT64_C(0xc9bcff6034c13053), -449},
+    {UINT64_C(0x964e858c91ba2655), -422}, {UINT64_C(0xdff9772470297ebd), -396},
+    {UINT64_C(0xa6dfbd9fb8e5b88f), -369}, {UINT64_C(0xf8a95fcf88747d94), -343},
+    {UINT64_C(0xb94470938fa89bcf), -316}, {UINT64_C(0x8a08f0f8bf0f156b), -289},
+    {UINT64_C(0xcdb02555653131b6), -263}, {UINT64_C(0x993fe2c6d07b7fac), -236},
+    {UINT64_C(0xe45c10c42a2b3b06), -210}, {UINT64_C(0xaa242499697392d3), -183},
+    {UINT64_C(0xfd87b5f28300ca0e), -157}, {UINT64_C(0xbce5086492111aeb), -130},
+    {UINT64_C(0x8cbccc096f5088cc), -103}, {UINT64_C(0xd1b71758e219652c), -77},
+    {UINT64_C(0x9c40000000000000), -50}, {UINT64_C(0xe8d4a51000000000), -24},
+    {UINT64_C(0xad78ebc5ac620000), 3}, {UINT64_C(0x813f3978f8940984), 30},
+    {UINT64_C(0xc097ce7bc90715b3), 56}, {UINT64_C(0x8f7e32ce7bea5c70), 83},
+    {UINT64_C(0xd5d238a4abe98068), 109}, {UINT64_C(0x9f4f2726179a2245), 136},
+    {UINT64_C(0xed63a231d4c4fb27), 162}, {UINT64_C(0xb0de65388cc8ada8), 189},
+    {UINT64_C(0x83c7088e1aab65db), 216}, {UINT64_C(0xc45d1df942711d9a), 242},
+    {UINT64_C(0x924d692ca61be758), 269}, {UINT64_C(0xda01ee641a708dea), 295},
+    {UINT64_C(0xa26da3999aef774a), 322}, {UINT64_C(0xf209787bb47d6b85), 348},
+    {UINT64_C(0xb454e4a179dd1877), 375}, {UINT64_C(0x865b86925b9bc5c2), 402},
+    {UINT64_C(0xc83553c5c8965d3d), 428}, {UINT64_C(0x952ab45cfa97a0b3), 455},
+    {UINT64_C(0xde469fbd99a05fe3), 481}, {UINT64_C(0xa59bc234db398c25), 508},
+    {UINT64_C(0xf6c69a72a3989f5c), 534}, {UINT64_C(0xb7dcbf5354e9bece), 561},
+    {UINT64_C(0x88fcf317f22241e2), 588}, {UINT64_C(0xcc20ce9bd35c78a5), 614},
+    {UINT64_C(0x98165af37b2153df), 641}, {UINT64_C(0xe2a0b5dc971f303a), 667},
+    {UINT64_C(0xa8d9d1535ce3b396), 694}, {UINT64_C(0xfb9b7cd9a4a7443c), 720},
+    {UINT64_C(0xbb764c4ca7a44410), 747}, {UINT64_C(0x8bab8eefb6409c1a), 774},
+    {UINT64_C(0xd01fef10a657842c), 800}, {UINT64_C(0x9b10a4e5e9913129), 827},
+    {UINT64_C(0xe7109bfba19c0c9d), 853}, {UINT64_C(0xac2820d9623bf429), 880},
+    {UINT64_C(0x80444b5e7aa7cf85), 907}, {UINT64_C(0xbf21e44003acdd2d), 933},
+    {UINT64_C(0x8e679c2f5e44ff8f), 960}, {UINT64_C(0xd433179d9c8cb841), 986},
+    {UINT64_C(0x9e19db92b4e31ba9), 1013}, {UINT64_C(0xeb96bf6ebadf77d9), 1039},
+    {UINT64_C(0xaf87023b9bf0ee6b), 1066}
+};
+
+
+/**
+ * @brief 慢速解析数字，交给strtod完成正确舍入
+ *
+ * @param intStart 整数部分起始位置
+ * @param intEnd 整数部分结束位置
+ * @param fracStart 小数部分起始位置
+ * @param fracEnd 小数部分结束位置
+ * @param exponent 指数部分
+ * @return double 解析出的数字绝对值
+ * @note 重新组织为不含小数点的"数字e指数"形式，不受locale影响
+ */
+static double csonNumberParseSlow(const char *intStart, const char *intEnd,
+                                  const char *fracStart, const char *fracEnd, long exponent)
+{
+    char buf[CSON_NUMBER_SLOW_DIGITS + 32];
+    const char *p;
+    int n = 0;
+    int sticky = 0;
+
+    for (p = intStart; p != intEnd; p++)
+    {
+        if (n == 0 && *p == '0')
+        {
+            continue;
+        }
+        if (n < CSON_NUMBER_SLOW_DIGITS)
+        {
+            buf[n++] = *p;
+        }
+        else
+        {
+            exponent++;
+            sticky |= *p != '0';
+        }
+    }
+    for (p = fracStart; p != fracEnd; p++)
+    {
+        if (n == 0 && *p == '0')
+        {
+            exponent--;
+            continue;
+        }
+        if (n < CSON_NUMBER_SLOW_DIGITS)
+        {
+            buf[n++] = *p;
+            exponent--;
+        }
+        else
+        {
+            sticky |= *p != '0';
+        }
+    }
+    if (n == 0)
+    {
+        return 0.0;
+    }
+    if (sticky)
+    {
+        buf[n++] = '1';
+        exponent--;
+    }
+    sprintf(buf + n, "e%ld", exponent);
+    return strtod(buf, NULL);
+}
+
+
+/**
+ * @brief 解析数字
+ *
+ * @param str 数字起始位置
+ * @param end 输入结束位置，为NULL时输入以'\0'结尾
+ * @param number 解析得到的数字
+ * @return const char* 数字之后的位置
+ * @note 语法与cJSON的parse_number一致
+ */
+const char *csonNumberParse(const char *str, const char *end, CsonNumber *number)
+{
+    const char *num = str;
+    const char *intStart, *intEnd, *fracStart, *fracEnd;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int truncated = 0;
+    int negative = 0;
+    int scale = 0;
+    int exponent = 0, signExponent = 1;
+    int hasExponent = 0;
+    double value;
+
+    if (num != end && *num == '-')
+    {
+        negative = 1;
+        num++;
+    }
+    intStart = num;
+    if (num != end && *num == '0')
+    {
+        num++;
+    }
+    if (num != end && *num >= '1' && *num <= '9')
+    {
+        do
+        {
+            if (digits < CSON_NUMBER_MAX_DIGITS)
+            {
+                mantissa = mantissa * 10 + (*num - '0');
+                digits++;
+            }
+            else
+            {
+                scale++;
+                truncated |= *num != '0';
+            }
+            num++;
+        } while (CSON_NUMBER_DIGIT(num, end));
+    }
+    intEnd = fracStart = fracEnd = num;
+    if (num != end && *num == '.' && CSON_NUMBER_DIGIT(num + 1, end))
+    {
+        num++;
+        fracStart = num;
+        do
+        {
+            if (mantissa == 0 && *num == '0')
+            {
+                scale--;
+            }
+            else if (digits < CSON_NUMBER_MAX_DIGITS)
+            {
+                mantissa = mantissa * 10 + (*num - '0');
+                digits++;
+                scale--;
+            }
+            else
+            {
+                truncated |= *num != '0';
+            }
+            num++;
+        } while (CSON_NUMBER_DIGIT(num, end));
+        fracEnd = num;
+    }
+    if (num != end && (*num == 'e' || *num == 'E'))
+    {
+        hasExponent = 1;
+        num++;
+        if (num != end && *num == '+')
+        {
+            num++;
+        }
+        else if (num != end && *num == '-')
+        {
+            signExponent = -1;
+            num++;
+        }
+        while (CSON_NUMBER_DIGIT(num, end))
+        {
+            if (exponent < CSON_NUMBER_MAX_EXPONENT)
+            {
+                exponent = exponent * 10 + (*num - '0');
+            }
+            num++;
+        }
+    }
+
+    number->isInteger = 0;
+    number->integer = 0;
+    if (!truncated && !hasExponent && fracStart == fracEnd && scale == 0
+        && mantissa <= (uint64_t)INT64_MAX + negative)
+    {
+        number->isInteger = 1;
+        number->integer = negative ? (int64_t)(0 - mantissa) : (int64_t)mantissa;
+    }
+
+    scale += exponent * signExponent;
+    if (mantissa == 0)
+    {
+        value = 0.0;
+    }
+    else if (!truncated && mantissa <= CSON_NUMBER_MAX_EXACT && scale >= -22 && scale <= 22)
+    {
+        value = (double)mantissa;
+        value = scale < 0 ? value / csonNumberPow10[-scale] : value * csonNumberPow10[scale];
+    }
+    else
+    {
+        value = csonNumberParseSlow(intStart, intEnd, fracStart, fracEnd,
+                                    (long)exponent * signExponent);
+    }
+    number->value = negative ? -value : value;
+    return num;
+}
+
+
+/**
+ * @brief 跳过数字
+ *
+ * @param str 数字起始位置
+ * @param end 输入结束位置，为NULL时输入以'\0'结尾
+ * @return const char* 数字之后的位置
+ * @note 只扫描不转换，接受的字符与`csonNumberParse`完全相同
+ */
+const char *csonNumberSkip(const char *str, const char *end)
+{
+    const char *num = str;
+
+    if (num != end && *num == '-')
+    {
+        num++;
+    }
+    if (num != end && *num == '0')
+    {
+        num++;
+    }
+    if (num != end && *num >= '1' && *num <= '9')
+    {
+        while (CSON_NUMBER_DIGIT(num, end))
+        {
+            num++;
+        }
+    }
+    if (num != end && *num == '.' && CSON_NUMBER_DIGIT(num + 1, end))
+    {
+        num++;
+        while (CSON_NUMBER_DIGIT(num, end))
+        {
+            num++;
+        }
+    }
+    if (num != end && (*num == 'e' || *num == 'E'))
+    {
+        num++;
+        if (num != end && (*num == '+' || *num == '-'))
+        {
+            num++;
+        }
+        while (CSON_NUMBER_DIGIT(num, end))
+        {
+            num++;
+        }
+    }
+    return num;
+}
+
+
+/**
+ * @brief 规格化，使最高位为1
+ *
+ * @param x 浮点数
+ * @return CsonDiyFp 规格化后的浮点数
+ */
+static CsonDiyFp csonDiyFpNormalize(CsonDiyFp x)
+{
+    while (!(x.f & ((uint64_t)1 << 63)))
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+
+/**
+ * @brief 乘法，保留结果的高64位并四舍五入
+ *
+ * @param x 乘数
+ * @param y 乘数
+ * @return CsonDiyFp 乘积
+ */
+static CsonDiyFp csonDiyFpMultiply(CsonDiyFp x, CsonDiyFp y)
+{
+    const uint64_t mask = 0xFFFFFFFFu;
+    uint64_t a = x.f >> 32, b = x.f & mask;
+    uint64_t c = y.f >> 32, d = y.f & mask;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask) + ((uint64_t)1 << 31);
+    CsonDiyFp r;
+
+    r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+
+/**
+ * @brief Grisu舍入，使输出尽量接近原值
+ *
+ * @param buffer 数字
+ * @param len 数字长度
+ * @param wpw 上边界与原值的差
+ * @param delta 允许范围
+ * @param rest 剩余部分
+ * @param tenKappa 当前位的单位
+ * @param unit 边界的误差，为0时按Grisu2处理，不检查结果
+ * @return int Grisu3下结果是否确定为最短且最接近原值
+ */
+static int csonNumberGrisuRound(char *buffer, int len, uint64_t wpw, uint64_t delta,
+                                uint64_t rest, uint64_t tenKappa, uint64_t unit)
+{
+    uint64_t small = wpw - unit;
+    uint64_t big = wpw + unit;
+
+    while (rest < small && delta - rest >= tenKappa
+           && (rest + tenKappa < small || small - rest >= rest + tenKappa - small))
+    {
+        buffer[len - 1]--;
+        rest += tenKappa;
+    }
+    if (rest < big && delta - rest >= tenKappa
+        && (rest + tenKappa < big || big - rest > rest + tenKappa - big))
+    {
+        return 0;
+    }
+    return 2 * unit <= rest && rest <= delta - 4 * unit;
+}
+
+
+/**
+ * @brief Grisu生成数字
+ *
+ * @param w 原值
+ * @param mp 上边界
+ * @param delta 上下边界的差
+ * @param unit 边界的误差，为0时按Grisu2处理
+ * @param buffer 数字
+ * @param len 数字长度
+ * @param k 十进制指数
+ * @return int Grisu3下结果是否确定为最短且最接近原值
+ */
+static int csonNumberDigitGen(CsonDiyFp w, CsonDiyFp mp, uint64_t delta, uint64_t unit,
+                              char *buffer, int *len, int *k)
+{
+    CsonDiyFp one = {(uint64_t)1 << -mp.e, mp.e};
+    uint64_t wpw = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    uint64_t tmp;
+    int kappa = 1;
+    uint32_t d;
+
+    while (kappa < 10 && p1 >= csonNumberPow10U64[kappa])
+    {
+        kappa++;
+    }
+    *len = 0;
+    while (kappa > 0)
+    {
+        d = (uint32_t)(p1 / csonNumberPow10U64[kappa - 1]);
+        p1 = (uint32_t)(p1 % csonNumberPow10U64[kappa - 1]);
+        if (d || *len)
+        {
+            buffer[(*len)++] = (char)('0' + d);
+        }
+        kappa--;
+        tmp = ((uint64_t)p1 << -one.e) + p2;
+        if (tmp < delta || (!unit && tmp == delta))
+        {
+            *k += kappa;
+            return csonNumberGrisuRound(buffer, *len, wpw, delta, tmp,
+                                        csonNumberPow10U64[kappa] << -one.e, unit);
+        }
+    }
+    while (1)
+    {
+        p2 *= 10;
+        delta *= 10;
+        unit *= 10;
+        d = (uint32_t)(p2 >> -one.e);
+        if (d || *len)
+        {
+            buffer[(*len)++] = (char)('0' + d);
+        }
+        p2 &= one.f - 1;
+        kappa--;
+        if (p2 < delta)
+        {
+            *k += kappa;
+            return csonNumberGrisuRound(buffer, *len,
+                                        -kappa < 20 ? wpw * csonNumberPow10U64[-kappa] : 0,
+                                        delta, p2, one.f, unit);
+        }
+    }
+}
+
+
+/**
+ * @brief Grisu计算十进制表示
+ *
+ * @param f 二进制有效数，不为0
+ * @param e 二进制指数
+ * @param lowerCloser 下边界是否更近(有效数为最小规格化值)
+ * @param grisu3 为1时使用Grisu3，否则使用Grisu2
+ * @param buffer 数字
+ * @param len 数字长度
+ * @param k 十进制指数，原值为 数字 * 10^k
+ * @return int Grisu3下结果是否确定为最短且最接近原值，Grisu2的结果总能还原，但不一定最短
+ */
+static int csonNumberGrisu(uint64_t f, int e, int lowerCloser, int grisu3,
+                           char *buffer, int *len, int *k)
+{
+    CsonDiyFp v = {f, e};
+    CsonDiyFp mp = {(f << 1) + 1, e - 1};
+    CsonDiyFp mm;
+    CsonDiyFp c;
+    double dk;
+    int index;
+
+    mp = csonDiyFpNormalize(mp);
+    if (lowerCloser)
+    {
+        mm.f = (f << 2) - 1;
+        mm.e = e - 2;
+    }
+    else
+    {
+        mm.f = (f << 1) - 1;
+        mm.e = e - 1;
+    }
+    mm.f <<= mm.e - mp.e;
+    mm.e = mp.e;
+    v = csonDiyFpNormalize(v);
+
+    dk = (-61 - mp.e) * 0.30102999566398114 + 347;
+    *k = (int)dk;
+    if (dk - *k > 0.0)
+    {
+        (*k)++;
+    }
+    index = (*k >> 3) + 1;
+    c.f = csonNumberCachedPowers[index].f;
+    c.e = csonNumberCachedPowers[index].e;
+    *k = 348 - index * 8;
+
+    v = csonDiyFpMultiply(v, c);
+    mp = csonDiyFpMultiply(mp, c);
+    mm = csonDiyFpMultiply(mm, c);
+    /* 乘积各有不超过1的误差，Grisu2收窄边界保证结果落在真实范围内，
+       Grisu3放宽边界，再检查结果是否确定 */
+    if (grisu3)
+    {
+        mm.f--;
+        mp.f++;
+    }
+    else
+    {
+        mm.f++;
+        mp.f--;
+    }
+    return csonNumberDigitGen(v, mp, mp.f - mm.f, grisu3 ? 1 : 0, buffer, len, k);
+}
+
+
+/**
+ * @brief 检查十进制表示能否还原为原值
+ *
+ * @param digits 数字
+ * @param len 数字长度
+ * @param k 十进制指数
+ * @param value 原值的绝对值
+ * @param single 是否按单精度浮点数比较
+ * @return int 能否还原
+ * @note 使用与解析相同的`csonNumberParse`，单精度浮点数解析后转换为float
+ */
+static int csonNumberRoundTrip(const char *digits, int len, int k, double value, int single)
+{
+    char str[CSON_NUMBER_BUFFER_SIZE];
+    CsonNumber number;
+    int n;
+
+    memcpy(str, digits, len);
+    str[len] = 'e';
+    n = len + 1 + csonNumberPrintInt(str + len + 1, k);
+    csonNumberParse(str, str + n, &number);
+    return single ? (float)number.value == (float)value : number.value == value;
+}
+
+
+/**
+ * @brief 缩短Grisu2的结果
+ *
+ * @param digits 数字
+ * @param len 数字长度
+ * @param k 十进制指数
+ * @param value 原值的绝对值
+ * @param single 是否按单精度浮点数比较
+ * @note 能还原为原值的十进制数是一个连续区间，且包含原来的结果，
+ *       如果存在m位的表示，原来的结果截断到m位或者截断后进位得到的数之一必然在区间内，
+ *       逐位减少直到两者都不能还原，即得到最短表示
+ */
+static void csonNumberShorten(char *digits, int *len, int *k, double value, int single)
+{
+    char source[20];
+    char candidate[20];
+    int n = *len;
+    int found, m, i, candidateLen, candidateK;
+
+    memcpy(source, digits, n);
+    for (m = n - 1; m > 0; m--)
+    {
+        found = 0;
+        for (int pass = 0; pass < 2 && !found; pass++)
+        {
+            /* 先尝试更接近原值的一个 */
+            candidateLen = m;
+            candidateK = *k + n - m;
+            memcpy(candidate, source, m);
+            if (pass == (source[m] < '5'))
+            {
+                for (i = m - 1; i >= 0 && candidate[i] == '9'; i--)
+                {
+                    candidate[i] = '0';
+                }
+                if (i < 0)
+                {
+                    candidate[0] = '1';
+                    candidateLen = 1;
+                    candidateK += m;
+                }
+                else
+                {
+                    candidate[i]++;
+                }
+            }
+            while (candidateLen > 1 && candidate[candidateLen - 1] == '0')
+            {
+                candidateLen--;
+                candidateK++;
+            }
+            if (csonNumberRoundTrip(candidate, candidateLen, candidateK, value, single))
+            {
+                memcpy(digits, candidate, candidateLen);
+                *len = candidateLen;
+                *k = candidateK;
+                found = 1;
+            }
+        }
+        if (!found)
+        {
+            break;
+        }
+    }
+}
+
+
+/**
+ * @brief 格式化输出数字
+ *
+ * @param str 输出缓冲
+ * @param negative 是否为负数
+ * @param digits 数字
+ * @param len 数字长度
+ * @param k 十进制指数
+ * @return int 输出长度
+ * @note 格式与JavaScript的Number.prototype.toString一致
+ */
+static int csonNumberFormat(char *str, int negative, const char *digits, int len, int k)
+{
+    char *p = str;
+    int point = len + k;
+    int exp;
+
+    if (negative)
+    {
+        *p++ = '-';
+    }
+    if (len <= point && point <= 21)
+    {
+        memcpy(p, digits, len);
+        memset(p + len, '0', point - len);
+        p += point;
+    }
+    else if (0 < point && point <= 21)
+    {
+        memcpy(p, digits, point);
+        p[point] = '.';
+        memcpy(p + point + 1, digits + point, len - point);
+        p += len + 1;
+    }
+    else if (-6 < point && point <= 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', -point);
+        memcpy(p - point, digits, len);
+        p += len - point;
+    }
+    else
+    {
+        *p++ = digits[0];
+        if (len > 1)
+        {
+            *p++ = '.';
+            memcpy(p, digits + 1, len - 1);
+            p += len - 1;
+        }
+        exp = point - 1;
+        *p++ = 'e';
+        *p++ = exp < 0 ? '-' : '+';
+        p += csonNumberPrintInt(p, exp < 0 ? -exp : exp);
+        return (int)(p - str);
+    }
+    *p = 0;
+    return (int)(p - str);
+}
+
+
+/**
+ * @brief 输出整数
+ *
+ * @param str 输出缓冲，大小不小于`CSON_NUMBER_BUFFER_SIZE`
+ * @param value 整数
+ * @return int 输出长度
+ */
+int csonNumberPrintInt(char *str, int64_t value)
+{
+    char tmp[24];
+    uint64_t u = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    int n = 0, len = 0;
+
+    do
+    {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0)
+    {
+        str[len++] = '-';
+    }
+    while (n)
+    {
+        str[len++] = tmp[--n];
+    }
+    str[len] = 0;
+    return len;
+}
+
+
+/**
+ * @brief 输出浮点数
+ *
+ * @param str 输出缓冲，大小不小于`CSON_NUMBER_BUFFER_SIZE`
+ * @param value 浮点数
+ * @return int 输出长度
+ * @note 输出可以精确还原为原值的最短表示，NaN和无穷大输出为null
+ */
+int csonNumberPrint(char *str, double value)
+{
+    char digits[20];
+    uint64_t bits, f;
+    int biased, e, len, k;
+
+    if (value == 0)
+    {
+        str[0] = '0';
+        str[1] = 0;
+        return 1;
+    }
+    if (value > -(double)CSON_NUMBER_MAX_EXACT && value < (double)CSON_NUMBER_MAX_EXACT
+        && value == (double)(int64_t)value)
+    {
+        return csonNumberPrintInt(str, (int64_t)value);
+    }
+    memcpy(&bits, &value, sizeof(bits));
+    biased = (int)((bits >> 52) & 0x7FF);
+    f = bits & ((CSON_NUMBER_MAX_EXACT >> 1) - 1);
+    if (biased == 0x7FF)
+    {
+        memcpy(str, "null", 5);
+        return 4;
+    }
+    if (biased)
+    {
+        f |= CSON_NUMBER_MAX_EXACT >> 1;
+        e = biased - 1075;
+    }
+    else
+    {
+        e = -1074;
+    }
+    if (!csonNumberGrisu(f, e, f == (CSON_NUMBER_MAX_EXACT >> 1) && biased > 1, 1, digits, &len, &k))
+    {
+        csonNumberGrisu(f, e, f == (CSON_NUMBER_MAX_EXACT >> 1) && biased > 1, 0, digits, &len, &k);
+        csonNumberShorten(digits, &len, &k, value < 0 ? -value : value, 0);
+    }
+    return csonNumberFormat(str, (int)(bits >> 63), digits, len, k);
+}
+
+
+/**
+ * @brief 输出单精度浮点数
+ *
+ * @param str 输出缓冲，大小不小于`CSON_NUMBER_BUFFER_SIZE`
+ * @param value 单精度浮点数
+ * @return int 输出长度
+ * @note 输出可以精确还原为float原值的最短表示
+ */
+int csonNumberPrintFloat(char *str, float value)
+{
+    char digits[20];
+    uint32_t bits, f;
+    int biased, e, len, k;
+
+    if (value == 0)
+    {
+        str[0] = '0';
+        str[1] = 0;
+        return 1;
+    }
+    if (value > -16777216.0f && value < 16777216.0f && value == (float)(int32_t)value)
+    {
+        return csonNumberPrintInt(str, (int32_t)value);
+    }
+    memcpy(&bits, &value, sizeof(bits));
+    biased = (int)((bits >> 23) & 0xFF);
+    f = bits & 0x7FFFFF;
+    if (biased == 0xFF)
+    {
+        memcpy(str, "null", 5);
+        return 4;
+    }
+    if (biased)
+    {
+        f |= 0x800000;
+        e = biased - 150;
+    }
+    else
+    {
+        e = -149;
+    }
+    if (!csonNumberGrisu(f, e, f == 0x800000 && biased > 1, 1, digits, &len, &k))
+    {
+        csonNumberGrisu(f, e, f == 0x800000 && biased > 1, 0, digits, &len, &k);
+        csonNumberShorten(digits, &len, &k, value < 0 ? -value : value, 1);
+    }
+    return csonNumberFormat(str, (int)(bits >> 31), digits, len, k);
+}
+
+
+/**
+ * @brief 浮点数转换为int
+ *
+ * @param value 浮点数
+ * @return int 整型数，超出范围时取最接近的边界值
+ */
+int csonNumberToInt(double value)
+{
+    if (value >= INT_MAX)
+    {
+        return INT_MAX;
+    }
+    if (value <= INT_MIN)
+    {
+        return INT_MIN;
+    }
+    return value == value ? (int)value : 0;
+}
+
+
+/**
+ * @brief 浮点数转换为int64_t
+ *
+ * @param value 浮点数
+ * @return int64_t 整型数，超出范围时取最接近的边界值
+ */
+int64_t csonNumberToInt64(double value)
+{
+    if (value >= 9223372036854775807.0)
+    {
+        return INT64_MAX;
+    }
+    if (value <= -9223372036854775808.0)
+    {
+        return INT64_MIN;
+    }
+    return value == value ? (int64_t)value : 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file cson_number.h
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief json数字解析与输出
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note cJSON和cson共用的数字转换函数，整数直接按64位整型解析和输出，
+ *       浮点数解析在可以精确计算时直接计算，否则交给strtod保证正确舍入，
+ *       浮点数输出使用Grisu3算法，输出可以精确还原的最短十进制表示，
+ *       少数Grisu3无法确定的数值回退到Grisu2，再逐位缩短并检查能否还原
+ */
+
+#ifndef __CSON_NUMBER_H__
+#define __CSON_NUMBER_H__
+
+#include "stddef.h"
+#include "stdint.h"
+
+#define CSON_NUMBER_BUFFER_SIZE     32      /**< 数字输出需要的最大缓冲大小，包含结束符 */
+
+
+/**
+ * @brief 解析得到的数字
+ *
+ */
+typedef struct
+{
+    double value;                       /**< 浮点值 */
+    int64_t integer;                    /**< 整数值，isInteger不为0时有效 */
+    int isInteger;                      /**< 是否为可以用int64_t精确表示的整数 */
+} CsonNumber;
+
+
+/**
+ * @brief 解析数字
+ *
+ * @param str 数字起始位置
+ * @param end 输入结束位置，为NULL时输入以'\0'结尾
+ * @param number 解析得到的数字
+ * @return const char* 数字之后的位置
+ * @note 语法与cJSON的parse_number一致
+ */
+const char *csonNumberParse(const char *str, const char *end, CsonNumber *number);
+
+/**
+ * @brief 跳过数字
+ *
+ * @param str 数字起始位置
+ * @param end 输入结束位置，为NULL时输入以'\0'结尾
+ * @return const char* 数字之后的位置
+ * @note 接受的字符与`csonNumberParse`相同，用于只需要校验语法的场合
+ */
+const char *csonNumberSkip(const char *str, const char *end);
+
+/**
+ * @brief 输出浮点数
+ *
+ * @param str 输出缓冲，大小不小于`CSON_NUMBER_BUFFER_SIZE`
+ * @param value 浮点数
+ * @return int 输出长度
+ * @note 输出可以精确还原为原值的最短表示，NaN和无穷大输出为null
+ */
+int csonNumberPrint(char *str, double value);
+
+/**
+ * @brief 输出单精度浮点数
+ *
+ * @param str 输出缓冲，大小不小于`CSON_NUMBER_BUFFER_SIZE`
+ * @param value 单精度浮点数
+ * @return int 输出长度
+ * @note 输出可以精确还原为float原值的最短表示
+ */
+int csonNumberPrintFloat(char *str, float value);
+
+/**
+ * @brief 输出整数
+ *
+ * @param str 输出缓冲，大小不小于`CSON_NUMBER_BUFFER_SIZE`
+ * @param value 整数
+ * @return int 输出长度
+ */
+int csonNumberPrintInt(char *str, int64_t value);
+
+/**
+ * @brief 浮点数转换为int
+ *
+ * @param value 浮点数
+ * @return int 整型数，超出范围时取最接近的边界值
+ */
+int csonNumberToInt(double value);
+
+/**
+ * @brief 浮点数转换为int64_t
+ *
+ * @param value 浮点数
+ * @return int64_t 整型数，超出范围时取最接近的边界值
+ */
+int64_t csonNumberToInt64(double value);
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file cson_pool.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief cJSON节点和CsonList节点池
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ */
+
+#include "cson_pool.h"
+
+
+/**
+ * @brief 节点池
+ *
+ * @note 空闲节点的第一个指针大小的空间用于链接下一个空闲节点
+ */
+typedef struct
+{
+    void *head;                         /**< 空闲节点链表 */
+    void *(*malloc)(size_t);            /**< 缓存节点使用的内存分配函数 */
+    void (*free)(void *);               /**< 缓存节点使用的内存释放函数 */
+    CsonPoolStats stats;                /**< 统计 */
+} CsonPool;
+
+
+static size_t csonPoolMax[CSON_POOL_TYPE_COUNT];                /**< 每个线程最多缓存的节点数量，只在其他线程开始解析之前修改 */
+static CSON_THREAD_LOCAL CsonPool csonPools[CSON_POOL_TYPE_COUNT]; /**< 当前线程的节点池 */
+
+
+/**
+ * @brief 释放节点池缓存的节点
+ *
+ * @param pool 节点池
+ */
+static void csonPoolFlush(CsonPool *pool)
+{
+    void *node;
+
+    while (pool->head)
+    {
+        node = pool->head;
+        pool->head = *(void **)node;
+        pool->free(node);
+    }
+    pool->stats.cached = 0;
+}
+
+
+/**
+ * @brief 配置节点池
+ *
+ * @param jsonNodes 每个线程最多缓存的cJSON节点数量，为0时不缓存
+ * @param listNodes 每个线程最多缓存的CsonList节点数量，为0时不缓存
+ */
+void csonPoolConfig(size_t jsonNodes, size_t listNodes)
+{
+    csonPoolMax[CSON_POOL_JSON] = jsonNodes;
+    csonPoolMax[CSON_POOL_LIST] = listNodes;
+}
+
+
+/**
+ * @brief 获取当前线程的节点池统计
+ *
+ * @param type 节点池类型
+ * @param stats 节点池统计
+ */
+void csonPoolGetStats(CsonPoolType type, CsonPoolStats *stats)
+{
+    if (type < CSON_POOL_TYPE_COUNT && stats)
+    {
+        *stats = csonPools[type].stats;
+    }
+}
+
+
+/**
+ * @brief 释放当前线程缓存的所有节点
+ *
+ */
+void csonPoolRelease(void)
+{
+    for (int i = 0; i < CSON_POOL_TYPE_COUNT; i++)
+    {
+        csonPoolFlush(&csonPools[i]);
+    }
+}
+
+
+/**
+ * @brief 从节点池分配节点
+ *
+ * @param type 节点池类型
+ * @param size 节点大小
+ * @param malloc 内存分配函数
+ * @param free 内存释放函数
+ * @return void* 节点
+ */
+void *csonPoolAlloc(CsonPoolType type, size_t size,
+                    void *(*malloc)(size_t), void (*free)(void *))
+{
+    CsonPool *pool = &csonPools[type];
+    void *node;
+
+    if (pool->head && (pool->malloc != malloc || pool->free != free))
+    {
+        csonPoolFlush(pool);
+    }
+    if (pool->head)
+    {
+        node = pool->head;
+        pool->head = *(void **)node;
+        pool->stats.cached--;
+        pool->stats.hits++;
+        return node;
+    }
+    pool->stats.misses++;
+    return malloc(size);
+}
+
+
+/**
+ * @brief 释放节点到节点池
+ *
+ * @param type 节点池类型
+ * @param ptr 节点，可为NULL
+ * @param malloc 节点使用的内存分配函数
+ * @param free 节点使用的内存释放函数
+ */
+void csonPoolFree(CsonPoolType type, void *ptr,
+                  void *(*malloc)(size_t), void (*free)(void *))
+{
+    CsonPool *pool = &csonPools[type];
+
+    if (!ptr)
+    {
+        return;
+    }
+    if (pool->head && (pool->malloc != malloc || pool->free != free))
+    {
+        csonPoolFlush(pool);
+    }
+    if (pool->stats.cached >= csonPoolMax[type])
+    {
+        pool->stats.releases++;
+        free(ptr);
+        return;
+    }
+    pool->malloc = malloc;
+    pool->free = free;
+    *(void **)ptr = pool->head;
+    pool->head = ptr;
+    pool->stats.cached++;
+}
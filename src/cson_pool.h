@@ -0,0 +1,112 @@
+/**
+ * @file cson_pool.h
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief cJSON节点和CsonList节点池
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note cJSON和cson共用的固定大小节点池，每个线程各自缓存释放的节点，
+ *       分配时优先复用缓存的节点，稳定运行后节点的分配和释放不再调用内存分配函数，
+ *       默认关闭，通过`csonPoolConfig`开启
+ */
+
+#ifndef __CSON_POOL_H__
+#define __CSON_POOL_H__
+
+#include "stddef.h"
+
+/**
+ * @brief 线程局部存储，定义`CSON_POOL_NO_TLS`时所有线程共用节点池，只能在单线程中使用
+ */
+#if defined(CSON_POOL_NO_TLS)
+    #define CSON_THREAD_LOCAL
+#elif defined(_MSC_VER)
+    #define CSON_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+    #define CSON_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+    #define CSON_THREAD_LOCAL __thread
+#else
+    #define CSON_THREAD_LOCAL
+#endif
+
+
+/**
+ * @brief 节点池类型
+ *
+ */
+typedef enum
+{
+    CSON_POOL_JSON = 0,                 /**< cJSON节点 */
+    CSON_POOL_LIST,                     /**< CsonList节点 */
+    CSON_POOL_TYPE_COUNT,               /**< 节点池类型数量 */
+} CsonPoolType;
+
+
+/**
+ * @brief 节点池统计
+ *
+ * @note 统计当前线程的节点池
+ */
+typedef struct cson_pool_stats
+{
+    size_t hits;                        /**< 复用缓存节点的次数 */
+    size_t misses;                      /**< 没有缓存节点，调用分配函数的次数 */
+    size_t releases;                    /**< 缓存已满，调用释放函数的次数 */
+    size_t cached;                      /**< 当前缓存的节点数量 */
+} CsonPoolStats;
+
+
+/**
+ * @brief 配置节点池
+ *
+ * @param jsonNodes 每个线程最多缓存的cJSON节点数量，为0时不缓存
+ * @param listNodes 每个线程最多缓存的CsonList节点数量，为0时不缓存
+ * @note 配置对所有线程生效，配置本身不加锁，需要在其他线程开始解析之前调用
+ */
+void csonPoolConfig(size_t jsonNodes, size_t listNodes);
+
+/**
+ * @brief 获取当前线程的节点池统计
+ *
+ * @param type 节点池类型
+ * @param stats 节点池统计
+ */
+void csonPoolGetStats(CsonPoolType type, CsonPoolStats *stats);
+
+/**
+ * @brief 释放当前线程缓存的所有节点
+ *
+ * @note 线程退出前调用，否则线程缓存的节点不会被释放，
+ *       `csonDecodeBatch`创建的线程退出前会自动调用
+ */
+void csonPoolRelease(void);
+
+/**
+ * @brief 从节点池分配节点
+ *
+ * @param type 节点池类型
+ * @param size 节点大小，同一类型的节点大小相同
+ * @param malloc 内存分配函数
+ * @param free 内存释放函数
+ * @return void* 节点
+ * @note 内部使用，缓存的节点由其他分配函数分配时先释放缓存
+ */
+void *csonPoolAlloc(CsonPoolType type, size_t size,
+                    void *(*malloc)(size_t), void (*free)(void *));
+
+/**
+ * @brief 释放节点到节点池
+ *
+ * @param type 节点池类型
+ * @param ptr 节点，可为NULL
+ * @param malloc 节点使用的内存分配函数
+ * @param free 节点使用的内存释放函数
+ * @note 内部使用，缓存已满时直接释放
+ */
+void csonPoolFree(CsonPoolType type, void *ptr,
+                  void *(*malloc)(size_t), void (*free)(void *));
+
+#endif
@@ -0,0 +1,345 @@
+/**
+ * @file cson_scan.h
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief json字符串和空白扫描
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note cJSON和cson直接解析器共用的扫描函数，每次处理32字节，
+ *       根据编译选项使用AVX2，SSE2或者逐字节扫描，
+ *       定义`CSON_SCAN_SCALAR`可以强制使用逐字节扫描
+ * @note 只查找字符串中的引号和反斜杠，以及跳过空白，
+ *       不生成结构字符(`{}[]:,`)的掩码，结构字符仍由解析器逐个处理
+ */
+
+#ifndef __CSON_SCAN_H__
+#define __CSON_SCAN_H__
+
+#include "stddef.h"
+#include "stdint.h"
+
+#if !defined(CSON_SCAN_SCALAR) && defined(__AVX2__)
+    #define CSON_SCAN_AVX2
+    #include "immintrin.h"
+#elif !defined(CSON_SCAN_SCALAR) && (defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define CSON_SCAN_SSE2
+    #include "emmintrin.h"
+#endif
+
+#define CSON_SCAN_BLOCK_SIZE        32      /**< 每次扫描的字节数 */
+
+/**
+ * @brief 以'\0'结尾的扫描会按块对齐读取，可能读取到字符串结束之后、同一块内的字节，
+ *        这些读取不会跨越内存页，但需要对地址检查工具屏蔽
+ */
+#if defined(__has_feature)
+    #if __has_feature(address_sanitizer)
+        #define CSON_SCAN_NO_SANITIZE __attribute__((no_sanitize_address))
+    #endif
+#endif
+#if !defined(CSON_SCAN_NO_SANITIZE) && defined(__SANITIZE_ADDRESS__)
+    #define CSON_SCAN_NO_SANITIZE __attribute__((no_sanitize_address))
+#endif
+#if !defined(CSON_SCAN_NO_SANITIZE)
+    #define CSON_SCAN_NO_SANITIZE
+#endif
+
+
+/**
+ * @brief 获取最低位的1所在位置
+ *
+ * @param mask 掩码，不为0
+ * @return int 位置
+ */
+static inline int csonScanCtz(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int n = 0;
+    while (!(mask & 1))
+    {
+        mask >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+
+#if defined(CSON_SCAN_AVX2) || defined(CSON_SCAN_SSE2)
+
+#if defined(CSON_SCAN_AVX2)
+
+/**
+ * @brief 计算块中引号，反斜杠(以及'\0')的位置掩码
+ *
+ * @param p 块地址
+ * @param aligned 是否为对齐地址
+ * @param zero 是否匹配'\0'
+ * @return uint32_t 掩码
+ */
+static inline CSON_SCAN_NO_SANITIZE uint32_t csonScanQuoteMask(const char *p, int aligned, int zero)
+{
+    __m256i v = aligned ? _mm256_load_si256((const __m256i *)p)
+                        : _mm256_loadu_si256((const __m256i *)p);
+    __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"')),
+                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+    if (zero)
+    {
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_setzero_si256()));
+    }
+    return (uint32_t)_mm256_movemask_epi8(m);
+}
+
+/**
+ * @brief 计算块中非空白字符(以及'\0')的位置掩码
+ *
+ * @param p 块地址
+ * @param aligned 是否为对齐地址
+ * @param zero 是否匹配'\0'
+ * @return uint32_t 掩码
+ * @note 空白字符与cJSON一致，为1~32的所有字符
+ */
+static inline CSON_SCAN_NO_SANITIZE uint32_t csonScanSpaceMask(const char *p, int aligned, int zero)
+{
+    __m256i v = aligned ? _mm256_load_si256((const __m256i *)p)
+                        : _mm256_loadu_si256((const __m256i *)p);
+    __m256i m = _mm256_cmpeq_epi8(_mm256_max_epu8(v, _mm256_set1_epi8(33)), v);
+    if (zero)
+    {
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_setzero_si256()));
+    }
+    return (uint32_t)_mm256_movemask_epi8(m);
+}
+
+#else
+
+static inline CSON_SCAN_NO_SANITIZE uint32_t csonScanQuoteMask16(const char *p, int aligned, int zero)
+{
+    __m128i v = aligned ? _mm_load_si128((const __m128i *)p)
+                        : _mm_loadu_si128((const __m128i *)p);
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"')),
+                             _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    if (zero)
+    {
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_setzero_si128()));
+    }
+    return (uint32_t)_mm_movemask_epi8(m);
+}
+
+static inline CSON_SCAN_NO_SANITIZE uint32_t csonScanSpaceMask16(const char *p, int aligned, int zero)
+{
+    __m128i v = aligned ? _mm_load_si128((const __m128i *)p)
+                        : _mm_loadu_si128((const __m128i *)p);
+    __m128i m = _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(33)), v);
+    if (zero)
+    {
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_setzero_si128()));
+    }
+    return (uint32_t)_mm_movemask_epi8(m);
+}
+
+/**
+ * @brief 计算块中引号，反斜杠(以及'\0')的位置掩码
+ *
+ * @param p 块地址
+ * @param aligned 是否为对齐地址
+ * @param zero 是否匹配'\0'
+ * @return uint32_t 掩码
+ */
+static inline uint32_t csonScanQuoteMask(const char *p, int aligned, int zero)
+{
+    return csonScanQuoteMask16(p, aligned, zero)
+        | (csonScanQuoteMask16(p + 16, aligned, zero) << 16);
+}
+
+/**
+ * @brief 计算块中非空白字符(以及'\0')的位置掩码
+ *
+ * @param p 块地址
+ * @param aligned 是否为对齐地址
+ * @param zero 是否匹配'\0'
+ * @return uint32_t 掩码
+ * @note 空白字符与cJSON一致，为1~32的所有字符
+ */
+static inline uint32_t csonScanSpaceMask(const char *p, int aligned, int zero)
+{
+    return csonScanSpaceMask16(p, aligned, zero)
+        | (csonScanSpaceMask16(p + 16, aligned, zero) << 16);
+}
+
+#endif
+
+/**
+ * @brief 查找第一个引号或反斜杠
+ *
+ * @param p 起始位置
+ * @param end 结束位置
+ * @return const char* 找到的位置，没有找到时返回end
+ */
+static inline const char *csonScanQuote(const char *p, const char *end)
+{
+    uint32_t mask;
+
+    while (end - p >= CSON_SCAN_BLOCK_SIZE)
+    {
+        mask = csonScanQuoteMask(p, 0, 0);
+        if (mask)
+        {
+            return p + csonScanCtz(mask);
+        }
+        p += CSON_SCAN_BLOCK_SIZE;
+    }
+    while (p < end && *p != '\"' && *p != '\\')
+    {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief 查找第一个引号，反斜杠或'\0'
+ *
+ * @param p 起始位置
+ * @return const char* 找到的位置
+ */
+static inline const char *csonScanQuoteZ(const char *p)
+{
+    const char *block = (const char *)((uintptr_t)p & ~(uintptr_t)(CSON_SCAN_BLOCK_SIZE - 1));
+    uint32_t mask = csonScanQuoteMask(block, 1, 1) & (0xFFFFFFFFu << (p - block));
+
+    while (!mask)
+    {
+        block += CSON_SCAN_BLOCK_SIZE;
+        mask = csonScanQuoteMask(block, 1, 1);
+    }
+    return block + csonScanCtz(mask);
+}
+
+/**
+ * @brief 跳过空白字符
+ *
+ * @param p 起始位置
+ * @param end 结束位置
+ * @return const char* 第一个非空白字符的位置，没有找到时返回end
+ */
+static inline const char *csonScanSpace(const char *p, const char *end)
+{
+    uint32_t mask;
+
+    if (p < end && (unsigned char)(*p - 1) >= 32)
+    {
+        return p;
+    }
+    while (end - p >= CSON_SCAN_BLOCK_SIZE)
+    {
+        mask = csonScanSpaceMask(p, 0, 1);
+        if (mask)
+        {
+            return p + csonScanCtz(mask);
+        }
+        p += CSON_SCAN_BLOCK_SIZE;
+    }
+    while (p < end && (unsigned char)(*p - 1) < 32)
+    {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief 跳过空白字符
+ *
+ * @param p 起始位置，以'\0'结尾
+ * @return const char* 第一个非空白字符或'\0'的位置
+ */
+static inline const char *csonScanSpaceZ(const char *p)
+{
+    const char *block;
+    uint32_t mask;
+
+    if ((unsigned char)(*p - 1) >= 32)
+    {
+        return p;
+    }
+    block = (const char *)((uintptr_t)p & ~(uintptr_t)(CSON_SCAN_BLOCK_SIZE - 1));
+    mask = csonScanSpaceMask(block, 1, 1) & (0xFFFFFFFFu << (p - block));
+    while (!mask)
+    {
+        block += CSON_SCAN_BLOCK_SIZE;
+        mask = csonScanSpaceMask(block, 1, 1);
+    }
+    return block + csonScanCtz(mask);
+}
+
+#else
+
+/**
+ * @brief 查找第一个引号或反斜杠
+ *
+ * @param p 起始位置
+ * @param end 结束位置
+ * @return const char* 找到的位置，没有找到时返回end
+ */
+static inline const char *csonScanQuote(const char *p, const char *end)
+{
+    while (p < end && *p != '\"' && *p != '\\')
+    {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief 查找第一个引号，反斜杠或'\0'
+ *
+ * @param p 起始位置
+ * @return const char* 找到的位置
+ */
+static inline const char *csonScanQuoteZ(const char *p)
+{
+    while (*p && *p != '\"' && *p != '\\')
+    {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief 跳过空白字符
+ *
+ * @param p 起始位置
+ * @param end 结束位置
+ * @return const char* 第一个非空白字符的位置，没有找到时返回end
+ */
+static inline const char *csonScanSpace(const char *p, const char *end)
+{
+    while (p < end && (unsigned char)(*p - 1) < 32)
+    {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief 跳过空白字符
+ *
+ * @param p 起始位置，以'\0'结尾
+ * @return const char* 第一个非空白字符或'\0'的位置
+ */
+static inline const char *csonScanSpaceZ(const char *p)
+{
+    while ((unsigned char)(*p - 1) < 32)
+    {
+        p++;
+    }
+    return p;
+}
+
+#endif
+
+#endif
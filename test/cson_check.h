@@ -0,0 +1,113 @@
+/**
+ * @file cson_check.h
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief cson测试公共定义
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 每个测试文件编译为一个独立的可执行程序，由ctest运行，
+ *       检查失败时打印位置并在`checkReport`中返回非0
+ */
+
+#ifndef __CSON_CHECK_H__
+#define __CSON_CHECK_H__
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "cson.h"
+
+
+static int checkCount = 0;                  /**< 检查次数 */
+static int checkFailed = 0;                 /**< 失败次数 */
+static long checkMallocCount = 0;           /**< 分配次数 */
+static long checkLiveCount = 0;             /**< 未释放的内存块数量 */
+
+
+/**
+ * @brief 检查表达式
+ *
+ * @param expr 表达式
+ */
+#define CHECK(expr) \
+        do { \
+            checkCount++; \
+            if (!(expr)) { \
+                checkFailed++; \
+                printf(#expr " check failed at file: %s, line: %d\r\n", __FILE__, __LINE__); \
+            } \
+        } while (0)
+
+/**
+ * @brief 检查字符串相等
+ *
+ * @param got 实际值，可以为NULL
+ * @param exp 期望值，可以为NULL
+ */
+#define CHECK_STR(got, exp) \
+        do { \
+            const char *_got = (got), *_exp = (exp); \
+            checkCount++; \
+            if ((_got == NULL) != (_exp == NULL) || (_got && strcmp(_got, _exp) != 0)) { \
+                checkFailed++; \
+                printf(#got " check failed at file: %s, line: %d\r\n  got: %s\r\n  exp: %s\r\n", \
+                       __FILE__, __LINE__, _got ? _got : "(null)", _exp ? _exp : "(null)"); \
+            } \
+        } while (0)
+
+
+/**
+ * @brief 计数分配函数
+ *
+ * @param size 大小
+ * @return void* 内存
+ */
+static inline void *checkMalloc(size_t size)
+{
+    __atomic_fetch_add(&checkMallocCount, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&checkLiveCount, 1, __ATOMIC_RELAXED);
+    return malloc(size);
+}
+
+/**
+ * @brief 计数释放函数
+ *
+ * @param ptr 内存
+ */
+static inline void checkFree(void *ptr)
+{
+    if (ptr)
+    {
+        __atomic_fetch_sub(&checkLiveCount, 1, __ATOMIC_RELAXED);
+    }
+    free(ptr);
+}
+
+/**
+ * @brief 编码对象，对象为NULL时返回NULL
+ *
+ * @param obj 对象
+ * @param model 数据模型
+ * @param modelSize 数据模型大小
+ * @return char* 紧凑格式json
+ */
+static inline char *checkEncode(void *obj, CsonModel *model, int modelSize)
+{
+    return obj ? csonEncodeUnformatted(obj, model, modelSize) : NULL;
+}
+
+/**
+ * @brief 输出测试结果
+ *
+ * @param name 测试名
+ * @return int 0 全部通过 1 存在失败
+ */
+static inline int checkReport(const char *name)
+{
+    printf("%s: %d checks, %d failed\r\n", name, checkCount, checkFailed);
+    return checkFailed != 0;
+}
+
+#endif
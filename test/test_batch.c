@@ -0,0 +1,143 @@
+/**
+ * @file test_batch.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief 批量解析测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 不同线程数量下结果按输入顺序排列，失败的记录有错误位置，
+ *       记录数组和解析结果都使用cson的分配函数
+ */
+
+#include "cson_check.h"
+#include "cson_batch.h"
+
+
+struct rec
+{
+    int id;
+    char *name;
+    double v;
+    CsonList *tags;
+};
+
+CsonModel recModel[] =
+{
+    CSON_MODEL_OBJ(struct rec),
+    CSON_MODEL_INT(struct rec, id),
+    CSON_MODEL_STRING(struct rec, name),
+    CSON_MODEL_DOUBLE(struct rec, v),
+    CSON_MODEL_LIST(struct rec, tags, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE)
+};
+
+#define MODEL_SIZE  ((int) (sizeof(recModel) / sizeof(CsonModel)))
+
+
+/**
+ * @brief 生成记录，第5条和第7条解析失败，第7条之前有空行
+ *
+ * @param count 记录数量
+ * @param len 数据长度
+ * @return char* NDJSON数据
+ */
+static char *checkRecords(int count, size_t *len)
+{
+    char *buffer = malloc((size_t) count * 80 + 16);
+    char *pos = buffer;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (i == 5)
+        {
+            pos += sprintf(pos, "{\"id\": 5, \"name\": bad}\n");
+        }
+        else if (i == 7)
+        {
+            pos += sprintf(pos, "\r\n  \n{\"id\": 7} trailing\n");
+        }
+        else
+        {
+            pos += sprintf(pos, "{\"id\": %d, \"name\": \"rec%d\", \"v\": %d.5, \"tags\": [\"a\", \"b\"]}\n",
+                           i, i, i);
+        }
+    }
+    *len = pos - buffer;
+    return buffer;
+}
+
+
+/**
+ * @brief 检查批量解析结果
+ *
+ * @param count 记录数量
+ * @param threads 线程数量
+ * @param contexts 解析上下文
+ */
+static void checkBatch(int count, int threads, CsonContext *contexts)
+{
+    size_t len, recordCount;
+    char *buffer = checkRecords(count, &len);
+    CsonBatchRecord *records;
+    int failed = csonDecodeBatch(buffer, len, recModel, MODEL_SIZE, threads, contexts,
+                                 &records, &recordCount);
+
+    CHECK(failed == (count > 7 ? 2 : count > 5 ? 1 : 0));
+    CHECK(recordCount == (size_t) count);
+    for (size_t i = 0; i < recordCount; i++)
+    {
+        struct rec *obj = records[i].obj;
+        if (i == 5 || i == 7)
+        {
+            CHECK(obj == NULL && records[i].error != NULL);
+            CHECK(records[i].error >= records[i].record
+                  && records[i].error <= records[i].record + records[i].length);
+            continue;
+        }
+        CHECK(obj && obj->id == (int) i && obj->v == i + 0.5);
+        CHECK(obj && obj->tags && obj->tags->next && strcmp(obj->tags->next->obj, "b") == 0);
+        CHECK(records[i].error == NULL);
+        CHECK(records[i].record[records[i].length] == '\n');
+    }
+    csonFreeBatch(records, recordCount, recModel, MODEL_SIZE);
+    free(buffer);
+}
+
+
+int main(void)
+{
+    CsonContext contexts[8] = {0};
+    long mallocCount;
+
+    csonInit(checkMalloc, checkFree);
+
+    /* 记录数量少于线程数量以及每个线程只领取一次 */
+    for (int count = 1; count <= 20; count++)
+    {
+        checkBatch(count, 8, NULL);
+    }
+    for (int threads = 1; threads <= 8; threads *= 2)
+    {
+        checkBatch(3000, threads, NULL);
+    }
+    CHECK(checkLiveCount == 0);
+
+    /* 记录数组使用cson的分配函数，解析结果使用各个线程的上下文 */
+    for (int i = 0; i < 8; i++)
+    {
+        contexts[i].malloc = checkMalloc;
+        contexts[i].free = checkFree;
+    }
+    mallocCount = checkMallocCount;
+    checkBatch(3000, 8, contexts);
+    CHECK(checkMallocCount > mallocCount);
+    CHECK(checkLiveCount == 0);
+
+    size_t recordCount = 1;
+    CsonBatchRecord *records = (CsonBatchRecord *) 1;
+    CHECK(csonDecodeBatch("\n \n", 3, recModel, MODEL_SIZE, 4, NULL, &records, &recordCount) == 0);
+    CHECK(records == NULL && recordCount == 0);
+
+    return checkReport("batch");
+}
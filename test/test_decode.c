@@ -0,0 +1,469 @@
+/**
+ * @file test_decode.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief 解析一致性测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 同一份输入分别经过`csonDecode`，`csonDecodeDirect`，`csonDecodeCompiled`
+ *       以及内存池解析，重新编码后的结果必须一致
+ */
+
+#include "cson_check.h"
+#include "test_model.h"
+
+
+/**
+ * @brief 比较各个解析方式的结果
+ *
+ * @param json json字符串
+ * @param compiled 预编译模型
+ */
+static void checkDecode(const char *json, CsonCompiledModel *compiled)
+{
+    static char buffer[1 << 16];
+    CsonArena arena;
+    csonArenaInit(&arena, buffer, sizeof(buffer));
+
+    struct test *tree = csonDecode(json, model, MODEL_SIZE);
+    struct test *direct = csonDecodeDirect(json, model, MODEL_SIZE);
+    struct test *fast = csonDecodeCompiled(json, compiled);
+    struct test *pooled = csonDecodeInArena(&arena, json, model, MODEL_SIZE);
+
+    char *treeJson = checkEncode(tree, model, MODEL_SIZE);
+    char *directJson = checkEncode(direct, model, MODEL_SIZE);
+    char *fastJson = checkEncode(fast, model, MODEL_SIZE);
+    char *pooledJson = checkEncode(pooled, model, MODEL_SIZE);
+
+    CHECK_STR(directJson, treeJson);
+    CHECK_STR(fastJson, treeJson);
+    CHECK_STR(pooledJson, treeJson);
+    if (!pooled)
+    {
+        CHECK(arena.offset == 0);
+    }
+    if (direct && direct->view.str && !direct->view.owned)
+    {
+        CHECK(direct->view.str >= json && direct->view.str < json + strlen(json));
+    }
+
+    csonFree(tree, model, MODEL_SIZE);
+    csonFree(direct, model, MODEL_SIZE);
+    csonFree(fast, model, MODEL_SIZE);
+    free(treeJson);
+    free(directJson);
+    free(fastJson);
+    free(pooledJson);
+}
+
+
+/**
+ * @brief 成员取值检查
+ */
+static void checkValues(void)
+{
+    struct test *obj = csonDecodeDirect(testInputs[0], model, MODEL_SIZE);
+    CHECK(obj != NULL);
+    if (!obj)
+    {
+        return;
+    }
+    CHECK(obj->id == 1 && obj->num == 300 && obj->max == 1000 && obj->value == 10.3);
+    CHECK(obj->longs[0] == 5 && obj->longs[1] == 6);
+    CHECK_STR(obj->name, "let\"ter");
+    CHECK(obj->sub && obj->sub->id == 20 && obj->sub->child && obj->sub->child->id == 3);
+    CHECK(obj->list && obj->list->next && obj->list->next->obj == NULL);
+    CHECK_STR(((struct sub *) obj->list->next->next->obj)->test, "hello \xe4\xb8\xad letter");
+    CHECK(obj->dupA == 5 && obj->dupB == 5);
+    CHECK(obj->view.len == 5 && obj->view.owned);
+    CHECK(obj->vec.len == 3 && ((struct sub *) obj->vec.data)[0].id == 1);
+    CHECK(obj->count == 3 && obj->counted[2] == 3);
+    CHECK(obj->far == 99);
+    CHECK_STR(obj->subjson, "{\"test\":[\"hello\",{\"a\":1}]}");
+    csonFree(obj, model, MODEL_SIZE);
+
+    obj = csonDecodeDirect("{\"view\": \"plain\"}", model, MODEL_SIZE);
+    CHECK(obj && obj->view.len == 5 && !obj->view.owned);
+    csonFree(obj, model, MODEL_SIZE);
+
+    /* 元素数量成员位于数组之前 */
+    struct counted
+    {
+        int n;
+        char pad[40];
+        short arr[4];
+    };
+    CsonModel countedModel[] =
+    {
+        CSON_MODEL_OBJ(struct counted),
+        CSON_MODEL_ARRAY_COUNT(struct counted, arr, CSON_TYPE_SHORT, 4, n)
+    };
+    CHECK(countedModel[1].param.array.countOffset < 0);
+    struct counted *counted = csonDecodeDirect("{\"arr\": [7, 8]}", countedModel, 2);
+    CHECK(counted && counted->n == 2 && counted->arr[1] == 8);
+    char *json = checkEncode(counted, countedModel, 2);
+    CHECK_STR(json, "{\"arr\":[7,8]}");
+    free(json);
+    csonFree(counted, countedModel, 2);
+
+    /* 元素数量成员与数组的距离超过short的范围 */
+    struct wide
+    {
+        int a[10000];
+        int n;
+    };
+    CsonModel wideModel[] =
+    {
+        CSON_MODEL_OBJ(struct wide),
+        CSON_MODEL_ARRAY_COUNT(struct wide, a, CSON_TYPE_INT, 10000, n)
+    };
+    struct wide *wide = csonDecodeDirect("{\"a\": [1, 2, 3]}", wideModel, 2);
+    CHECK(wide && wide->n == 3 && wide->a[2] == 3);
+    json = checkEncode(wide, wideModel, 2);
+    CHECK_STR(json, "{\"a\":[1,2,3]}");
+    free(json);
+    csonFree(wide, wideModel, 2);
+    wide = csonDecode("{\"a\": [4, 5]}", wideModel, 2);
+    CHECK(wide && wide->n == 2 && wide->a[1] == 5);
+    csonFree(wide, wideModel, 2);
+}
+
+
+/**
+ * @brief 上下文分配函数以及错误位置检查
+ */
+static void checkContext(void)
+{
+    CsonContext ctx = {0};
+    ctx.malloc = checkMalloc;
+    ctx.free = checkFree;
+
+    struct test *obj = csonDecodeCtx(&ctx, testInputs[0], model, MODEL_SIZE);
+    CHECK(obj != NULL && ctx.error == NULL);
+    CHECK(checkLiveCount > 0);
+    csonFreeCtx(&ctx, obj, model, MODEL_SIZE);
+    CHECK(checkLiveCount == 0);
+
+    const char *json = "{\"id\": 1, \"name\": tru}";
+    CHECK(csonDecodeCtx(&ctx, json, model, MODEL_SIZE) == NULL);
+    CHECK(ctx.error == json + 18);
+    CHECK(checkLiveCount == 0);
+
+    ctx.options = CSON_OPTION_REQUIRE_END;
+    json = "{\"id\": 1} x";
+    CHECK(csonDecodeCtx(&ctx, json, model, MODEL_SIZE) == NULL);
+    CHECK(ctx.error == json + 10);
+    obj = csonDecodeCtx(&ctx, "{\"id\": 1} \r\n", model, MODEL_SIZE);
+    CHECK(obj != NULL && ctx.error == NULL);
+    csonFreeCtx(&ctx, obj, model, MODEL_SIZE);
+    CHECK(checkLiveCount == 0);
+}
+
+
+/**
+ * @brief 子json原样复制检查
+ */
+static void checkRawJson(void)
+{
+    struct raw
+    {
+        int id;
+        char *raw;
+        char *after;
+    };
+    CsonModel rawModel[] =
+    {
+        CSON_MODEL_OBJ(struct raw),
+        CSON_MODEL_INT(struct raw, id),
+        CSON_MODEL_JSON(struct raw, raw),
+        CSON_MODEL_STRING(struct raw, after)
+    };
+    const char *json = "{\"id\": 1, \"raw\":  { \"a\" : [1.0, 2e3 ,\"x \\\" y\\u00e9\" ] , \"b\":\tnull }  , \"after\": \"z\"}";
+    CsonContext raw = {0};
+    CsonContext minify = {0};
+    raw.options = CSON_OPTION_RAW_JSON;
+    minify.options = CSON_OPTION_RAW_JSON | CSON_OPTION_MINIFY_JSON;
+
+    struct raw *a = csonDecodeCtxEx(NULL, json, rawModel);
+    struct raw *b = csonDecodeCtxEx(&raw, json, rawModel);
+    struct raw *c = csonDecodeCtxEx(&minify, json, rawModel);
+    CHECK(a && b && c);
+    if (a && b && c)
+    {
+        CHECK_STR(a->raw, "{\"a\":[1,2000,\"x \\\" y\xc3\xa9\"],\"b\":null}");
+        CHECK_STR(b->raw, "{ \"a\" : [1.0, 2e3 ,\"x \\\" y\\u00e9\" ] , \"b\":\tnull }");
+        CHECK_STR(c->raw, "{\"a\":[1.0,2e3,\"x \\\" y\\u00e9\"],\"b\":null}");
+
+        char *out = csonEncodeCtx(&raw, c, rawModel, 4, 16, 0);
+        CHECK_STR(out, "{\"id\":1,\"raw\":{\"a\":[1.0,2e3,\"x \\\" y\\u00e9\"],\"b\":null},\"after\":\"z\"}");
+        free(out);
+        out = csonEncodeCtx(NULL, c, rawModel, 4, 16, 0);
+        CHECK_STR(out, "{\"id\":1,\"raw\":{\"a\":[1,2000,\"x \\\" y\xc3\xa9\"],\"b\":null},\"after\":\"z\"}");
+        free(out);
+    }
+    CHECK(csonDecodeCtxEx(&raw, "{\"raw\": [1, }", rawModel) == NULL);
+    csonFreeEx(a, rawModel);
+    csonFreeEx(b, rawModel);
+    csonFreeEx(c, rawModel);
+}
+
+
+/**
+ * @brief 键值大小写检查
+ */
+static void checkCaseSensitive(void)
+{
+    struct keys
+    {
+        int lo;
+        int up;
+        int only;
+    };
+    CsonModel keyModel[] =
+    {
+        CSON_MODEL_OBJ(struct keys),
+        {CSON_TYPE_INT, "dup", offsetof(struct keys, lo)},
+        {CSON_TYPE_INT, "DUP", offsetof(struct keys, up)},
+        CSON_MODEL_INT(struct keys, only)
+    };
+    const char *json = "{\"DUP\": 2, \"dup\": 1, \"Dup\": 9, \"ONLY\": 7, \"\\u006fnly\": 3}";
+    CsonCompiledModel *compiled = csonCompileModelEx(keyModel);
+
+    for (int sensitive = 0; sensitive < 2; sensitive++)
+    {
+        CsonContext ctx = {0};
+        ctx.options = sensitive ? CSON_OPTION_CASE_SENSITIVE : 0;
+        struct keys *direct = csonDecodeCtxEx(&ctx, json, keyModel);
+        struct keys *fast = csonDecodeCompiledCtx(&ctx, json, compiled);
+        CHECK(direct && fast);
+        if (direct && fast)
+        {
+            CHECK(direct->lo == (sensitive ? 1 : 2) && direct->up == 2 && direct->only == (sensitive ? 3 : 7));
+            CHECK(memcmp(direct, fast, sizeof(struct keys)) == 0);
+        }
+        csonFreeEx(direct, keyModel);
+        csonFreeEx(fast, keyModel);
+    }
+    csonFreeCompiledModel(compiled);
+}
+
+
+/**
+ * @brief 转义字符被结束符截断
+ *
+ * @note 结束符之后的内容不属于json，解析不能越过结束符读写
+ */
+static void checkTruncatedEscape(void)
+{
+    static const char truncated[][64] =
+    {
+        "{\"name\": \"\\\0\"after the terminator, longer than the value\"}",
+        "{\"name\": \"ab\\u4\0e2d after the terminator, longer than it\"}",
+        "{\"name\": \"\\ud83d\\ude\0\0 after the terminator, longer than it\"}",
+    };
+
+    for (size_t i = 0; i < sizeof(truncated) / sizeof(truncated[0]); i++)
+    {
+        char *json = malloc(sizeof(truncated[i]));
+        memcpy(json, truncated[i], sizeof(truncated[i]));
+        CHECK(cJSON_Parse(json) == NULL);
+        CHECK(csonDecode(json, model, MODEL_SIZE) == NULL);
+        CHECK(csonDecodeDirect(json, model, MODEL_SIZE) == NULL);
+        free(json);
+    }
+}
+
+
+/**
+ * @brief 跳过的成员值同样检查语法
+ *
+ * @note 数据模型中不存在的成员以及超出数组大小的元素，不能因为被跳过而放宽语法
+ */
+static void checkSkipSyntax(void)
+{
+    static const char *invalid[] =
+    {
+        "{\"unknown\": nuly, \"id\": 1}",
+        "{\"unknown\": [3.,4e38], \"id\": 1}",
+        "{\"unknown\": {, \"id\": 1}",
+        "{\"unknown\": { xd\":true}, \"id\": 1}",
+        "{\"unknown\": {\"a\": [1, {\"b\": falsy}]}, \"id\": 1}",
+        "{\"longs\": [1, 2, -x]}",
+        "{\"intList\": [1, [nuly]]}",
+    };
+    CsonCompiledModel *compiled = csonCompileModel(model, MODEL_SIZE);
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        CsonContext ctx = {0};
+        CHECK(csonDecode(invalid[i], model, MODEL_SIZE) == NULL);
+        CHECK(csonDecodeDirect(invalid[i], model, MODEL_SIZE) == NULL);
+        CHECK(csonDecodeCompiled(invalid[i], compiled) == NULL);
+        CHECK(csonDecodeCtx(&ctx, invalid[i], model, MODEL_SIZE) == NULL && ctx.error != NULL);
+    }
+    csonFreeCompiledModel(compiled);
+}
+
+
+/**
+ * @brief 超过2^53的long成员
+ *
+ * @note 直接解析按64位整数精确保存，`csonDecode`经过cJSON树，只能得到double舍入后的值
+ */
+static void checkLargeLong(void)
+{
+    if (sizeof(long) < 8)
+    {
+        return;
+    }
+    const char *json = "{\"big\": 9007199254740993, \"longs\": [-9223372036854775807, 1]}";
+    struct test *tree = csonDecode(json, model, MODEL_SIZE);
+    struct test *direct = csonDecodeDirect(json, model, MODEL_SIZE);
+
+    CHECK(direct && direct->big == 9007199254740993L && direct->longs[0] == -9223372036854775807L);
+    CHECK(tree && tree->big == 9007199254740992L && tree->longs[0] == (long) -9223372036854775807.0);
+    csonFree(tree, model, MODEL_SIZE);
+    csonFree(direct, model, MODEL_SIZE);
+}
+
+
+/**
+ * @brief 元素数量超过short范围的数组
+ *
+ * @note 超出数组大小的元素只跳过，不能因为索引回绕而写到数组之前
+ */
+static void checkLongArray(void)
+{
+    struct arr
+    {
+        int before;
+        int a[4];
+        int n;
+    };
+    CsonModel arrModel[] =
+    {
+        CSON_MODEL_OBJ(struct arr),
+        CSON_MODEL_INT(struct arr, before),
+        CSON_MODEL_ARRAY_COUNT(struct arr, a, CSON_TYPE_INT, 4, n)
+    };
+    static char buffer[1 << 12];
+    CsonArena arena;
+    size_t count = 70000;
+    char *json = malloc(count * 2 + 32);
+    char *pos = json + sprintf(json, "{\"before\": 5, \"a\": [");
+
+    for (size_t i = 0; i < count; i++)
+    {
+        *pos++ = '1' + i % 9;
+        *pos++ = ',';
+    }
+    strcpy(pos - 1, "]}");
+
+    CsonCompiledModel *compiled = csonCompileModel(arrModel, 3);
+    csonArenaInit(&arena, buffer, sizeof(buffer));
+    struct arr *objs[] =
+    {
+        csonDecodeDirect(json, arrModel, 3),
+        csonDecodeCompiled(json, compiled),
+        csonDecodeInArena(&arena, json, arrModel, 3),
+        csonDecode(json, arrModel, 3),
+    };
+    for (size_t i = 0; i < sizeof(objs) / sizeof(objs[0]); i++)
+    {
+        CHECK(objs[i] && objs[i]->before == 5 && objs[i]->n == 4);
+        CHECK(objs[i] && objs[i]->a[0] == 1 && objs[i]->a[3] == 4);
+    }
+    csonFree(objs[0], arrModel, 3);
+    csonFree(objs[1], arrModel, 3);
+    csonFree(objs[3], arrModel, 3);
+    csonFreeCompiledModel(compiled);
+    free(json);
+}
+
+
+static size_t checkLargest = 0;             /**< 最大的分配请求 */
+
+/**
+ * @brief 记录最大的分配请求，超过1MB时分配失败
+ *
+ * @param size 内存大小
+ * @return void* 分配的内存
+ */
+static void *checkLimitMalloc(size_t size)
+{
+    checkLargest = size > checkLargest ? size : checkLargest;
+    return size > (1 << 20) ? NULL : checkMalloc(size);
+}
+
+
+/**
+ * @brief 元素总大小超过int范围的CsonVector
+ *
+ * @note 分配大小按size_t计算，不能截断为1MB后再按完整大小清零
+ */
+static void checkLargeVector(void)
+{
+    struct big
+    {
+        int id;
+        char pad[(1 << 20) - sizeof(int)];
+    };
+    struct holder
+    {
+        CsonVector vec;
+    };
+    CsonModel bigModel[] =
+    {
+        CSON_MODEL_OBJ(struct big),
+        CSON_MODEL_INT(struct big, id)
+    };
+    CsonModel holderModel[] =
+    {
+        CSON_MODEL_OBJ(struct holder),
+        CSON_MODEL_VECTOR(struct holder, vec, bigModel, 2)
+    };
+    CsonContext ctx = {0};
+    size_t count = 4097;
+    char *json = malloc(count * 6 + 32);
+    char *pos = json + sprintf(json, "{\"vec\": [");
+
+    for (size_t i = 0; i < count; i++)
+    {
+        pos += sprintf(pos, "null,");
+    }
+    strcpy(pos - 1, "]}");
+
+    ctx.malloc = checkLimitMalloc;
+    ctx.free = checkFree;
+    CHECK(csonDecodeCtx(&ctx, json, holderModel, 2) == NULL);
+    CHECK(sizeof(size_t) == 4 || checkLargest == count << 20);
+    CHECK(checkLiveCount == 0);
+    free(json);
+}
+
+
+int main(void)
+{
+    csonInit(malloc, free);
+
+    CsonCompiledModel *compiled = csonCompileModel(model, MODEL_SIZE);
+    for (size_t i = 0; i < TEST_INPUT_COUNT; i++)
+    {
+        checkDecode(testInputs[i], compiled);
+    }
+    csonFreeCompiledModel(compiled);
+
+    checkValues();
+    checkContext();
+    checkRawJson();
+    checkCaseSensitive();
+    checkTruncatedEscape();
+    checkSkipSyntax();
+    checkLargeLong();
+    checkLongArray();
+    checkLargeVector();
+
+    return checkReport("decode");
+}
@@ -0,0 +1,331 @@
+/**
+ * @file test_encode.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief 编码一致性测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note `csonEncode`，`csonEncodeInto`，`csonEncodeStream`的输出
+ *       必须与经过cJSON树的`csonEncodeObject`一致
+ */
+
+#include "cson_check.h"
+#include "test_model.h"
+#include "cson_number.h"
+#include "stdint.h"
+
+
+/**
+ * @brief 输出缓冲
+ */
+typedef struct
+{
+    char *buf;                              /**< 缓冲区 */
+    size_t len;                             /**< 已输出长度 */
+    size_t calls;                           /**< 输出次数 */
+    size_t failAt;                          /**< 第几次输出返回失败，为0时不失败 */
+} CheckOutput;
+
+
+/**
+ * @brief 输出函数
+ *
+ * @param param 输出缓冲
+ * @param data 数据
+ * @param len 数据长度
+ * @return int 0 成功 -1 失败
+ */
+static int checkWrite(void *param, const char *data, size_t len)
+{
+    CheckOutput *out = param;
+    if (out->failAt && out->calls + 1 >= out->failAt)
+    {
+        return -1;
+    }
+    out->calls++;
+    out->buf = realloc(out->buf, out->len + len + 1);
+    memcpy(out->buf + out->len, data, len);
+    out->len += len;
+    out->buf[out->len] = '\0';
+    return 0;
+}
+
+
+/**
+ * @brief 比较各个编码方式的输出
+ *
+ * @param obj 对象
+ */
+static void checkEncodeObject(struct test *obj)
+{
+    cJSON *tree = csonEncodeObject(obj, model, MODEL_SIZE);
+    char *treeJson = cJSON_PrintUnformatted(tree);
+    char *treeFormatted = cJSON_Print(tree);
+    cJSON_Delete(tree);
+
+    char *json = csonEncode(obj, model, MODEL_SIZE, 16, 0);
+    char *formatted = csonEncode(obj, model, MODEL_SIZE, 16, 1);
+    char *unformatted = csonEncodeUnformatted(obj, model, MODEL_SIZE);
+    CHECK_STR(json, treeJson);
+    CHECK_STR(formatted, treeFormatted);
+    CHECK_STR(unformatted, treeJson);
+
+    /* 缓冲区恰好足够，以及少一个字节 */
+    size_t len = strlen(treeJson);
+    size_t written = 0;
+    char *buf = malloc(len + 1);
+    CHECK(csonEncodeInto(obj, model, MODEL_SIZE, buf, len + 1, &written) == 0);
+    CHECK(written == len && strcmp(buf, treeJson) == 0);
+    written = 0;
+    CHECK(csonEncodeInto(obj, model, MODEL_SIZE, buf, len, &written) == -1);
+    CHECK(written == len);
+    CHECK(csonEncodeInto(obj, model, MODEL_SIZE, NULL, 0, &written) == -1);
+    CHECK(written == len);
+    free(buf);
+
+    for (int fmt = 0; fmt < 2; fmt++)
+    {
+        CheckOutput out = {0};
+        CHECK(csonEncodeStream(obj, model, MODEL_SIZE, checkWrite, &out, fmt) == 0);
+        CHECK_STR(out.buf, fmt ? treeFormatted : treeJson);
+        size_t calls = out.calls;
+        for (size_t fail = 1; fail <= calls; fail++)
+        {
+            out.len = 0;
+            out.calls = 0;
+            out.failAt = fail;
+            CHECK(csonEncodeStream(obj, model, MODEL_SIZE, checkWrite, &out, fmt) == -1);
+        }
+        free(out.buf);
+    }
+
+    /* 编码结果再次解析后编码不变 */
+    struct test *again = csonDecodeDirect(json, model, MODEL_SIZE);
+    char *againJson = checkEncode(again, model, MODEL_SIZE);
+    CHECK_STR(againJson, json);
+    csonFree(again, model, MODEL_SIZE);
+
+    free(againJson);
+    free(treeJson);
+    free(treeFormatted);
+    csonFreeJson(json);
+    csonFreeJson(formatted);
+    csonFreeJson(unformatted);
+}
+
+
+/**
+ * @brief 需要转义的字符串以及长字符串
+ */
+static void checkStrings(void)
+{
+    struct test obj = {0};
+    char *name = malloc(5000);
+    for (int i = 0; i < 4999; i++)
+    {
+        name[i] = (i % 37 == 0) ? '\n' : (i % 41 == 0) ? 1 : (i % 43 == 0) ? '"' : 'a' + i % 26;
+    }
+    name[4999] = '\0';
+    obj.name = name;
+    obj.str[0] = "\xe4\xb8\xad\\/\t";
+    obj.str[1] = "";
+    obj.view.str = "view\"";
+    obj.view.len = 4;
+    checkEncodeObject(&obj);
+
+    char *json = csonEncodeUnformatted(&obj, model, MODEL_SIZE);
+    struct test *back = csonDecodeDirect(json, model, MODEL_SIZE);
+    CHECK(back && back->name && strcmp(back->name, name) == 0);
+    CHECK(back && back->view.len == 4 && memcmp(back->view.str, "view", 4) == 0);
+    csonFree(back, model, MODEL_SIZE);
+    csonFreeJson(json);
+    free(name);
+}
+
+
+/**
+ * @brief 超过2^53的long成员
+ *
+ * @note 直接编码按64位整数原样输出，cJSON树以double保存，打印结果经过舍入
+ */
+static void checkLargeLong(void)
+{
+    if (sizeof(long) < 8)
+    {
+        return;
+    }
+    struct test obj = {0};
+    obj.big = 9007199254740993L;
+    obj.longs[0] = -9223372036854775807L;
+    obj.str[0] = obj.str[1] = "";
+
+    char *json = csonEncodeUnformatted(&obj, model, MODEL_SIZE);
+    CHECK(json && strstr(json, "\"big\":9007199254740993,"));
+    CHECK(json && strstr(json, "\"longs\":[-9223372036854775807,0]"));
+    csonFreeJson(json);
+
+    cJSON *root = csonEncodeObject(&obj, model, MODEL_SIZE);
+    json = cJSON_PrintUnformatted(root);
+    CHECK(json && strstr(json, "\"big\":9007199254740992,"));
+    CHECK(json && !strstr(json, "9223372036854775807"));
+    free(json);
+    cJSON_Delete(root);
+}
+
+
+/**
+ * @brief 有效数字位数
+ *
+ * @param str 数字
+ * @return int 去掉符号、指数以及首尾的0之后的位数
+ */
+static int checkDigits(const char *str)
+{
+    int first = -1, last = -1, n = 0;
+
+    for (; *str && *str != 'e'; str++)
+    {
+        if (*str >= '1' && *str <= '9')
+        {
+            first = first < 0 ? n : first;
+            last = n;
+        }
+        n += *str >= '0' && *str <= '9';
+    }
+    return first < 0 ? 0 : last - first + 1;
+}
+
+
+/**
+ * @brief 检查数字能否还原
+ *
+ * @param str 数字
+ * @param value 原值
+ * @param single 是否为单精度浮点数，解析后转换为float比较
+ * @return int 能否还原
+ */
+static int checkRoundTrip(const char *str, double value, int single)
+{
+    double parsed = strtod(str, NULL);
+    return single ? (float) parsed == (float) value : parsed == value;
+}
+
+
+/**
+ * @brief 检查是否存在指定位数的表示
+ *
+ * @param value 原值
+ * @param single 是否为单精度浮点数
+ * @param digits 有效数字位数
+ * @return int 是否存在
+ * @note 能还原的表示是一个区间，区间不一定以原值为中心，
+ *       除了最接近的一个，还要检查两边相邻的数
+ */
+static int checkShorter(double value, int single, int digits)
+{
+    char str[64], mantissa[32];
+    char *exp;
+    long long m;
+    int n = 0;
+
+    if (digits < 1)
+    {
+        return 0;
+    }
+    snprintf(str, sizeof(str), "%.*e", digits - 1, value < 0 ? -value : value);
+    if (checkRoundTrip(str, value < 0 ? -value : value, single))
+    {
+        return 1;
+    }
+    exp = strchr(str, 'e');
+    for (char *p = str; p < exp; p++)
+    {
+        if (*p >= '0' && *p <= '9')
+        {
+            mantissa[n++] = *p;
+        }
+    }
+    mantissa[n] = 0;
+    m = atoll(mantissa);
+    for (int d = -1; d <= 1; d += 2)
+    {
+        snprintf(str, sizeof(str), "%llde%d", m + d, atoi(exp + 1) - (digits - 1));
+        if (m + d > 0 && checkRoundTrip(str, value < 0 ? -value : value, single))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief 浮点数输出最短且可以还原
+ *
+ * @note Grisu2对少数数值会多输出一位，这些数值需要回退检查
+ */
+static void checkShortest(void)
+{
+    char str[CSON_NUMBER_BUFFER_SIZE];
+    uint64_t x = 88172645463325252ULL;
+    double d;
+    float f;
+    uint32_t bits;
+
+    csonNumberPrint(str, 30892612233637952.0);
+    CHECK_STR(str, "30892612233637950");
+    csonNumberPrint(str, 2.7183163742986588e+276);
+    CHECK_STR(str, "2.718316374298659e+276");
+    csonNumberPrint(str, 5e-324);
+    CHECK_STR(str, "5e-324");
+    csonNumberPrintFloat(str, -124936224.0f);
+    CHECK_STR(str, "-124936220");
+
+    for (int i = 0; i < 200000; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        memcpy(&d, &x, sizeof(d));
+        if (d == d && d - d == 0)
+        {
+            csonNumberPrint(str, d);
+            CHECK(checkRoundTrip(str, d, 0) && !checkShorter(d, 0, checkDigits(str) - 1));
+        }
+        bits = (uint32_t) (x >> 32);
+        memcpy(&f, &bits, sizeof(f));
+        if (f == f && f - f == 0)
+        {
+            csonNumberPrintFloat(str, f);
+            CHECK(checkRoundTrip(str, f, 1) && !checkShorter(f, 1, checkDigits(str) - 1));
+        }
+    }
+}
+
+
+int main(void)
+{
+    csonInit(malloc, free);
+
+    for (size_t i = 0; i < TEST_INPUT_COUNT; i++)
+    {
+        struct test *obj = csonDecodeDirect(testInputs[i], model, MODEL_SIZE);
+        /* cJSON_CreateString不接受NULL，字符串数组未填满的对象无法经过cJSON树比较 */
+        if (obj && obj->str[0] && obj->str[1])
+        {
+            checkEncodeObject(obj);
+        }
+        csonFree(obj, model, MODEL_SIZE);
+    }
+    checkStrings();
+    checkLargeLong();
+    checkShortest();
+
+    char *json = csonEncodeUnformatted(NULL, model, MODEL_SIZE);
+    CHECK_STR(json, "null");
+    csonFreeJson(json);
+
+    return checkReport("encode");
+}
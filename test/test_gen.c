@@ -0,0 +1,172 @@
+/**
+ * @file test_gen.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief 生成函数测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note `CSON_GENERATE`生成的解析和编码函数必须与`csonDecodeDirect`，`csonEncode`一致，
+ *       包括随机修改后的非法输入
+ */
+
+#include "cson_check.h"
+#include "cson_gen.h"
+
+
+struct pt
+{
+    int x;
+    double y;
+    char *tag;
+};
+
+struct test
+{
+    int id;
+    char c;
+    short s;
+    long l;
+    float f;
+    double d;
+    char b;
+    char *name;
+    CsonStringView view;
+    char *raw;
+    struct pt *pos;
+    CsonList *pts;
+    CsonList *ints;
+    CsonVector vpts;
+    CsonVector strs;
+    int arr[4];
+    char *sarr[2];
+};
+
+#define PT_FIELDS(X, T) \
+        X(T, INT, x, 0) \
+        X(T, DOUBLE, y, 0) \
+        X(T, STRING, tag, 0)
+
+CSON_GENERATE(pt, struct pt, PT_FIELDS)
+
+#define TEST_FIELDS(X, T) \
+        X(T, INT, id, 0) \
+        X(T, CHAR, c, 0) \
+        X(T, SHORT, s, 0) \
+        X(T, LONG, l, 0) \
+        X(T, FLOAT, f, 0) \
+        X(T, DOUBLE, d, 0) \
+        X(T, BOOL, b, 0) \
+        X(T, STRING, name, 0) \
+        X(T, STRING_VIEW, view, 0) \
+        X(T, JSON, raw, 0) \
+        X(T, STRUCT, pos, pt) \
+        X(T, LIST, pts, pt) \
+        X(T, LIST, ints, csonInt) \
+        X(T, VECTOR, vpts, pt) \
+        X(T, VECTOR, strs, csonString) \
+        X(T, INT_ARRAY, arr, 4) \
+        X(T, STRING_ARRAY, sarr, 2)
+
+CSON_GENERATE(test, struct test, TEST_FIELDS)
+
+
+static const char *inputs[] =
+{
+    "{\"id\": 1, \"c\": 65, \"s\": 70000, \"l\": -5, \"f\": 1.5, \"d\": 1e300, \"b\": true, \"name\": \"n\\u00e9\", "
+    "\"view\": \"v\\t\", \"raw\": {\"a\": [1, 2]}, \"pos\": {\"x\": 1, \"y\": 2, \"tag\": \"t\"}, "
+    "\"pts\": [{\"x\": 2}, null, {\"tag\": \"q\"}], \"ints\": [1, 2, 3], \"vpts\": [{\"x\": 9}], \"strs\": [\"a\", 2], "
+    "\"arr\": [1, 2, 3, 4, 5], \"sarr\": [\"x\"], \"ID\": 7}",
+    "{\"ID\": 3, \"id\": 4, \"Id\": 5, \"NAME\": \"up\", \"name\": \"down\", \"\\u0069d\": 8, \"pos\": null}",
+    "{}", "null", "[1, 2]", "5", "\"s\"", "{\"pos\": 5, \"pts\": {}, \"ints\": \"x\", \"arr\": 1}",
+    "{\"id\": 1,}", "{,\"id\": 1}", "{\"id\" 1}", "{\"id\": 1 \"c\": 2}", "{\"pos\": {\"x\": tru}}",
+    "{\"unknown\": {\"deep\": [1, {\"a\": null}]}, \"id\": 2}",
+    "  {  \"id\"  :  1  ,  \"b\"  :  false  }  ",
+    "{\"unknown\": nuly, \"id\": 1}", "{\"unknown\": [3.,4e38], \"id\": 1}",
+    "{\"unknown\": {, \"id\": 1}", "{\"unknown\": { xd\":true}, \"id\": 1}",
+    "{\"arr\": [1, 2, 3, 4, 5, -x]}",
+};
+
+
+/**
+ * @brief 比较生成函数与数据模型函数
+ *
+ * @param json json字符串
+ */
+static void checkGenerated(const char *json)
+{
+    struct test *direct = csonDecodeDirect(json, testModel, testModelSize);
+    struct test *generated = testDecode(json);
+
+    CHECK((direct == NULL) == (generated == NULL));
+    if (direct && generated)
+    {
+        for (int fmt = 0; fmt < 2; fmt++)
+        {
+            char *a = csonEncode(direct, testModel, testModelSize, 16, fmt);
+            char *b = csonEncode(generated, testModel, testModelSize, 16, fmt);
+            char *c = testEncode(direct, 16, fmt);
+            CHECK_STR(b, a);
+            CHECK_STR(c, a);
+            free(a);
+            free(b);
+            free(c);
+        }
+    }
+    csonFree(direct, testModel, testModelSize);
+    testFree(generated);
+}
+
+
+int main(void)
+{
+    csonInit(malloc, free);
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+    {
+        checkGenerated(inputs[i]);
+    }
+
+    /* 随机替换，截断或删除一个字符 */
+    srand(1);
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+    {
+        size_t len = strlen(inputs[i]);
+        for (int j = 0; j < 200; j++)
+        {
+            char buf[1024];
+            size_t pos = rand() % (len ? len : 1);
+            memcpy(buf, inputs[i], len + 1);
+            switch (rand() % 3)
+            {
+            case 0:
+                buf[pos] = " {}[],:\"0a\\"[rand() % 11];
+                break;
+            case 1:
+                buf[pos] = '\0';
+                break;
+            default:
+                memmove(buf + pos, buf + pos + 1, len - pos);
+                break;
+            }
+            checkGenerated(buf);
+        }
+    }
+
+    char *json = testEncode(NULL, 0, 0);
+    CHECK_STR(json, "null");
+    free(json);
+
+    static char buffer[1 << 16];
+    CsonArena arena;
+    CsonContext ctx = {0};
+    csonArenaInit(&arena, buffer, sizeof(buffer));
+    ctx.arena = &arena;
+    ctx.options = CSON_OPTION_REQUIRE_END;
+    struct test *obj = testDecodeCtx(&ctx, inputs[0]);
+    CHECK(obj && obj->id == 1 && obj->pos && obj->pos->x == 1);
+    CHECK(testDecodeCtx(&ctx, "{} x") == NULL && ctx.error != NULL);
+
+    return checkReport("gen");
+}
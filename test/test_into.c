@@ -0,0 +1,283 @@
+/**
+ * @file test_into.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief 就地更新测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 用cJSON把原对象的json与更新json按更新规则合并，
+ *       `csonDecodeInto`的结果必须与直接解析合并结果一致
+ */
+
+#include "cson_check.h"
+
+
+struct pt
+{
+    int x;
+    double y;
+    char *tag;
+    CsonList *ints;
+};
+
+struct test
+{
+    int id;
+    char *name;
+    CsonStringView view;
+    char *raw;
+    struct pt *pos;
+    CsonList *pts;
+    CsonList *strs;
+    CsonList *ints;
+    CsonVector vpts;
+    CsonVector vstrs;
+    CsonVector vd;
+    int arr[3];
+    char *sarr[2];
+    int n;
+    char *after;
+};
+
+CsonModel ptModel[] =
+{
+    CSON_MODEL_OBJ(struct pt),
+    CSON_MODEL_INT(struct pt, x),
+    CSON_MODEL_DOUBLE(struct pt, y),
+    CSON_MODEL_STRING(struct pt, tag),
+    CSON_MODEL_LIST(struct pt, ints, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE)
+};
+
+CsonModel model[] =
+{
+    CSON_MODEL_OBJ(struct test),
+    CSON_MODEL_INT(struct test, id),
+    CSON_MODEL_STRING(struct test, name),
+    CSON_MODEL_STRING_VIEW(struct test, view),
+    CSON_MODEL_JSON(struct test, raw),
+    CSON_MODEL_STRUCT(struct test, pos, ptModel, 5),
+    CSON_MODEL_LIST(struct test, pts, ptModel, 5),
+    CSON_MODEL_LIST(struct test, strs, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_LIST(struct test, ints, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(struct test, vpts, ptModel, 5),
+    CSON_MODEL_VECTOR(struct test, vstrs, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(struct test, vd, CSON_MODEL_DOUBLE_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_ARRAY_COUNT(struct test, arr, CSON_TYPE_INT, 3, n),
+    CSON_MODEL_ARRAY(struct test, sarr, CSON_TYPE_STRING, 2),
+    CSON_MODEL_STRING(struct test, after)
+};
+
+#define MODEL_SIZE  ((int) (sizeof(model) / sizeof(CsonModel)))
+
+
+static const char *bases[] =
+{
+    "{\"id\": 1, \"name\": \"a long name here\", \"view\": \"vv\", \"raw\": [1, {\"a\": 2}], "
+    "\"pos\": {\"x\": 1, \"y\": 2, \"tag\": \"tagtag\", \"ints\": [1, 2]}, "
+    "\"pts\": [{\"x\": 1, \"tag\": \"p1\"}, null, {\"x\": 3, \"ints\": [7]}], \"strs\": [\"one\", \"two\", \"three\"], "
+    "\"ints\": [1, 2, 3, 4], \"vpts\": [{\"x\": 5, \"tag\": \"vp\"}, {\"y\": 1.5}], \"vstrs\": [\"s1\", \"s2\", \"s3\"], "
+    "\"vd\": [1.5, 2.5], \"arr\": [1, 2, 3], \"sarr\": [\"x\", \"y\"], \"after\": \"z\"}",
+    "{}",
+    "{\"pos\": 5, \"pts\": [], \"vpts\": [null], \"after\": null}",
+    "{\"name\": \"\", \"pos\": {}}",
+};
+
+static const char *updates[] =
+{
+    "{}", "null", "{\"id\": 9}", "{\"name\": \"short\"}", "{\"name\": \"a much much longer name than before\"}",
+    "{\"name\": \"esc\\u00e9\\n\"}", "{\"name\": null, \"after\": 5}",
+    "{\"pos\": {\"y\": 9, \"tag\": \"t2\"}}", "{\"pos\": null}", "{\"pos\": {\"ints\": [5, 6, 7]}}", "{\"pos\": 3}",
+    "{\"pts\": [{\"y\": 1}]}", "{\"pts\": [null, {\"x\": 2}, {\"tag\": \"new\"}, {\"x\": 4}]}", "{\"pts\": []}", "{\"pts\": 5}",
+    "{\"strs\": [\"o\", \"a longer string\", null, \"4\"]}", "{\"strs\": [\"q\"]}", "{\"ints\": [9]}", "{\"ints\": [1, 2, 3, 4, 5, 6]}",
+    "{\"vpts\": [{\"x\": 1}]}", "{\"vpts\": [{\"tag\": \"a\"}, null, {\"x\": 3}]}", "{\"vpts\": []}",
+    "{\"vstrs\": [\"t\", 5]}", "{\"vstrs\": [\"a\", \"b\", \"c\", \"d\"]}", "{\"vd\": [3]}",
+    "{\"arr\": [7]}", "{\"arr\": 5, \"sarr\": [\"m\"]}", "{\"view\": \"new\\tview\", \"raw\": {\"b\": null}}",
+    "{\"ID\": 4, \"id\": 5, \"Name\": \"N\", \"name\": \"n\"}",
+    "{\"id\": 1,}", "{\"name\": \"x\" \"id\": 2}", "{\"strs\": [\"a\",]}", "{\"pts\": [{\"x\": 1} 2]}",
+    "{\"vpts\": [{\"x\": tru}]}", "[1]", "{\"pos\": {\"tag\": \"x\", \"ints\": [1,}}",
+};
+
+
+/**
+ * @brief 按更新规则合并json
+ *
+ * @param base 原对象json
+ * @param update 更新json
+ * @param model 数据模型
+ * @param modelSize 数据模型大小
+ * @param flags 更新选项
+ * @return cJSON* 合并结果
+ */
+static cJSON *checkMerge(cJSON *base, cJSON *update, CsonModel *model, int modelSize, int flags)
+{
+    cJSON *out = cJSON_CreateObject();
+    for (int i = 0; i < modelSize; i++)
+    {
+        if (model[i].type == CSON_TYPE_OBJ)
+        {
+            continue;
+        }
+        cJSON *baseItem = base ? cJSON_GetObjectItem(base, model[i].key) : NULL;
+        cJSON *updateItem = update ? cJSON_GetObjectItem(update, model[i].key) : NULL;
+        if (updateItem && updateItem->type == cJSON_NULL && (flags & CSON_UPDATE_IGNORE_NULL))
+        {
+            updateItem = NULL;
+        }
+        cJSON *item;
+        if (model[i].type == CSON_TYPE_STRUCT && !(flags & CSON_UPDATE_REPLACE_STRUCT)
+            && baseItem && baseItem->type != cJSON_NULL && updateItem && updateItem->type == cJSON_Object)
+        {
+            item = checkMerge(baseItem->type == cJSON_Object ? baseItem : NULL, updateItem,
+                              model[i].param.sub.model, model[i].param.sub.size, flags);
+        }
+        else
+        {
+            item = cJSON_Duplicate(updateItem ? updateItem : baseItem, 1);
+        }
+        if (item)
+        {
+            cJSON_AddItemToObject(out, model[i].key, item);
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief 空向量释放数据，与直接解析的结果统一
+ *
+ * @param obj 对象
+ */
+static void checkNormalize(struct test *obj)
+{
+    CsonVector *vectors[] = {&obj->vpts, &obj->vstrs, &obj->vd};
+    for (int i = 0; i < 3; i++)
+    {
+        if (vectors[i]->data && vectors[i]->len == 0)
+        {
+            free(vectors[i]->data);
+            vectors[i]->data = NULL;
+            vectors[i]->cap = 0;
+        }
+    }
+}
+
+
+/**
+ * @brief 更新结果检查
+ *
+ * @param base 原对象json
+ * @param update 更新json
+ * @param flags 更新选项
+ */
+static void checkUpdate(const char *base, const char *update, int flags)
+{
+    struct test *obj = csonDecodeDirect(base, model, MODEL_SIZE);
+    char *before = csonEncodeUnformatted(obj, model, MODEL_SIZE);
+    int ret = csonDecodeInto(obj, update, model, MODEL_SIZE, flags);
+    cJSON *updateJson = cJSON_Parse(update);
+
+    CHECK((ret == 0) == (updateJson && (updateJson->type == cJSON_Object || updateJson->type == cJSON_NULL)));
+    if (ret == 0)
+    {
+        checkNormalize(obj);
+        char *got = csonEncodeUnformatted(obj, model, MODEL_SIZE);
+        cJSON *baseJson = cJSON_Parse(before);
+        cJSON *merged = checkMerge(baseJson, updateJson->type == cJSON_Object ? updateJson : NULL,
+                                   model, MODEL_SIZE, flags);
+        char *mergedJson = cJSON_PrintUnformatted(merged);
+        struct test *ref = csonDecodeDirect(mergedJson, model, MODEL_SIZE);
+        char *exp = csonEncodeUnformatted(ref, model, MODEL_SIZE);
+        CHECK_STR(got, exp);
+        free(got);
+        free(exp);
+        free(mergedJson);
+        cJSON_Delete(baseJson);
+        cJSON_Delete(merged);
+        csonFree(ref, model, MODEL_SIZE);
+    }
+    cJSON_Delete(updateJson);
+    free(before);
+    csonFree(obj, model, MODEL_SIZE);
+}
+
+
+/**
+ * @brief 已有内存复用检查
+ */
+static void checkReuse(void)
+{
+    struct test *obj = csonDecodeDirect(bases[0], model, MODEL_SIZE);
+    CsonList *first = obj->pts;
+    void *firstObj = obj->pts->obj;
+    void *vectorData = obj->vpts.data;
+    char *name = obj->name;
+
+    CHECK(csonDecodeInto(obj, "{\"name\": \"short\", \"pts\": [{\"x\": 8}], \"vpts\": [{\"x\": 2}]}",
+                         model, MODEL_SIZE, 0) == 0);
+    CHECK(obj->name == name && strcmp(obj->name, "short") == 0);
+    CHECK(obj->pts == first && obj->pts->obj == firstObj && obj->pts->next == NULL);
+    CHECK(obj->vpts.data == vectorData && obj->vpts.len == 1 && obj->vpts.cap == 2);
+    CHECK(((struct pt *) obj->pts->obj)->x == 8 && ((struct pt *) obj->pts->obj)->tag == NULL);
+    csonFree(obj, model, MODEL_SIZE);
+}
+
+
+/**
+ * @brief 上下文分配函数以及选项检查
+ */
+static void checkContext(void)
+{
+    CsonContext ctx = {0};
+    ctx.malloc = checkMalloc;
+    ctx.free = checkFree;
+
+    struct test *obj = csonDecodeCtx(&ctx, bases[0], model, MODEL_SIZE);
+    CHECK(obj != NULL);
+    CHECK(csonDecodeIntoCtx(&ctx, obj, updates[4], model, MODEL_SIZE, 0) == 0);
+    CHECK(csonDecodeIntoCtx(&ctx, obj, "{\"pts\": [null, {\"x\": 2}, {\"tag\": \"new\"}, {\"x\": 4}], "
+                            "\"vstrs\": [\"a\", \"b\", \"c\", \"d\"], \"pos\": null}", model, MODEL_SIZE, 0) == 0);
+    CHECK_STR(obj->name, "a much much longer name than before");
+    CHECK(obj->pos == NULL && obj->vstrs.len == 4);
+
+    ctx.options = CSON_OPTION_CASE_SENSITIVE | CSON_OPTION_REQUIRE_END;
+    CHECK(csonDecodeIntoCtx(&ctx, obj, "{\"ID\": 4, \"id\": 5, \"Name\": \"N\"}", model, MODEL_SIZE, 0) == 0);
+    CHECK(obj->id == 5 && strcmp(obj->name, "a much much longer name than before") == 0);
+    const char *json = "{\"id\": 6} x";
+    CHECK(csonDecodeIntoCtx(&ctx, obj, json, model, MODEL_SIZE, 0) == -1);
+    CHECK(ctx.error == json + 10 && obj->id == 6);
+    CHECK(csonDecodeIntoCtx(&ctx, obj, "null", model, MODEL_SIZE, 0) == 0 && ctx.error == NULL);
+
+    /* 被替换的成员由上下文释放 */
+    csonFreeCtx(&ctx, obj, model, MODEL_SIZE);
+    CHECK(checkLiveCount == 0);
+
+    static char buffer[1024];
+    CsonArena arena;
+    struct test empty = {0};
+    csonArenaInit(&arena, buffer, sizeof(buffer));
+    ctx.arena = &arena;
+    CHECK(csonDecodeIntoCtx(&ctx, &empty, "{\"id\": 1}", model, MODEL_SIZE, 0) == -1);
+}
+
+
+int main(void)
+{
+    csonInit(malloc, free);
+
+    for (int flags = 0; flags < 4; flags++)
+    {
+        for (size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); i++)
+        {
+            for (size_t j = 0; j < sizeof(updates) / sizeof(updates[0]); j++)
+            {
+                checkUpdate(bases[i], updates[j], flags);
+            }
+        }
+    }
+    checkReuse();
+    checkContext();
+
+    return checkReport("into");
+}
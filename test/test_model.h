@@ -0,0 +1,157 @@
+/**
+ * @file test_model.h
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief cson测试数据模型
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 覆盖所有成员类型的数据模型，解析，增量解析，编码以及msgpack测试共用
+ */
+
+#ifndef __TEST_MODEL_H__
+#define __TEST_MODEL_H__
+
+#include "cson.h"
+
+
+struct sub
+{
+    int id;
+    char *test;
+    struct sub *child;
+};
+
+struct test
+{
+    char id;
+    short num;
+    int max;
+    double value;
+    long big;
+    long longs[2];
+    char *name;
+    struct sub *sub;
+    CsonList *list;
+    char *str[2];
+    CsonList *intList;
+    CsonList *strList;
+    char *subjson;
+    char flag;
+    float f;
+    CsonStringView view;
+    int dupA;
+    int dupB;
+    float fa[3];
+    CsonList *dlist;
+    CsonVector vec;
+    int counted[3];
+    int count;
+    int far;
+};
+
+CsonModel subModel[] =
+{
+    CSON_MODEL_OBJ(struct sub),
+    CSON_MODEL_INT(struct sub, id),
+    CSON_MODEL_STRING(struct sub, test),
+    CSON_MODEL_STRUCT(struct sub, child, subModel, 4)
+};
+
+CsonModel model[] =
+{
+    CSON_MODEL_OBJ(struct test),
+    CSON_MODEL_CHAR(struct test, id),
+    CSON_MODEL_SHORT(struct test, num),
+    CSON_MODEL_INT(struct test, max),
+    CSON_MODEL_DOUBLE(struct test, value),
+    CSON_MODEL_LONG(struct test, big),
+    CSON_MODEL_ARRAY(struct test, longs, CSON_TYPE_LONG, 2),
+    CSON_MODEL_STRING(struct test, name),
+    CSON_MODEL_STRUCT(struct test, sub, subModel, 4),
+    CSON_MODEL_LIST(struct test, list, subModel, 4),
+    CSON_MODEL_ARRAY(struct test, str, CSON_TYPE_STRING, 2),
+    CSON_MODEL_LIST(struct test, intList, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_LIST(struct test, strList, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_JSON(struct test, subjson),
+    CSON_MODEL_BOOL(struct test, flag),
+    CSON_MODEL_FLOAT(struct test, f),
+    CSON_MODEL_STRING_VIEW(struct test, view),
+    {CSON_TYPE_INT, "dup", offsetof(struct test, dupA)},
+    {CSON_TYPE_INT, "DUP", offsetof(struct test, dupB)},
+    CSON_MODEL_ARRAY(struct test, fa, CSON_TYPE_FLOAT, 3),
+    CSON_MODEL_LIST(struct test, dlist, CSON_MODEL_DOUBLE_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(struct test, vec, subModel, 4),
+    CSON_MODEL_ARRAY_COUNT(struct test, counted, CSON_TYPE_INT, 3, count),
+    CSON_MODEL_INT(struct test, far)
+};
+
+#define MODEL_SIZE  ((int) (sizeof(model) / sizeof(CsonModel)))
+
+
+/**
+ * @brief 测试输入，所有解析方式都必须得到相同的结果
+ */
+static const char *testInputs[] =
+{
+    "{\"id\": 1, \"num\": 300, \"max\": 1000, \"value\": 10.3, \"big\": 7, \"longs\": [5, 6, 7], "
+    "\"name\": \"let\\\"ter\", \"sub\": {\"id\": 20, \"test\": \"hello world\", \"child\": {\"id\": 3, \"child\": null}}, "
+    "\"list\": [{\"id\": 21, \"test\": \"hello cson\"}, null, {\"id\": 22, \"test\": \"hello \\u4e2d letter\"}], "
+    "\"str\": [\"array1\", \"array2\"], \"intList\": [1, 12, 52, {}, [1]], \"strList\": [\"str1\", \"str2\", 5], "
+    "\"subjson\": {\"test\": [\"hello\", {\"a\": 1}]}, \"far\": 99, \"flag\": true, \"f\": 1.1, \"view\": \"v\\\\iew\", "
+    "\"Dup\": 5, \"fa\": [1.5, true, {\"x\": 1}, 4], \"dlist\": [1e300, -2.5], "
+    "\"vec\": [{\"id\": 1}, null, {\"test\": \"v\"}], \"counted\": [1, 2, 3, 4], "
+    "\"unknown\": {\"a\": [1, 2, {\"b\": \"}]\"}]}}",
+    "{}",
+    "  { \"ID\" : 4 , \"id\": 5, \"Name\": null }  ",
+    "null",
+    "[1,2]",
+    "\"str\"",
+    "12",
+    "true",
+    "{\"sub\": [1, 2], \"list\": {\"a\": 1}, \"longs\": {\"a\": 1}, \"name\": [1], \"max\": {\"x\": [\"y\"]}, \"str\": [[1], {}, \"x\"]}",
+    "{\"sub\": null, \"list\": null, \"sub\": {\"id\": 1}, \"list\": [{\"id\": 1}]}",
+    "{\"list\": [[1], 5, \"s\"]}",
+    "{\"sub\": 5}",
+    "{\"sub\": \"str\"}",
+    "{\"vec\": [], \"counted\": [], \"str\": 5}",
+    "{\"vec\": {\"a\": 1}, \"counted\": [7]}",
+    "{\"longs\": [true, false], \"counted\": [true, \"1\", null]}",
+    "{\"id\": 1,}",
+    "{\"id\" 1}",
+    "{\"id\": 1",
+    "{\"id\": }",
+    "[1,]",
+    "{\"sub\": {\"id\": 1, \"test\": \"x}}",
+    "{\"id\": tru}",
+    "{\"list\": [{\"id\": 1},]}",
+    "{\"intList\": [1 2]}",
+    "{\"a\": [1, 2}",
+    "{\"a\": {\"b\": 1]}",
+    "{\"value\": -}",
+    "{\"value\": 1.5e}",
+    "{\"value\": 1e5, \"f\": 3.4e39}",
+    "{\"unknown\": \"a\\\"b\", \"id\": 3}",
+    "{\"\\u0069d\": 7}",
+    "",
+    "   ",
+    "{\"id\":1}\n",
+    "{\"a\"\t:\r\n[ ]}",
+    "{\"unknown\": [-0.5E+3, 0, -1, \"a\\\"]\", {\"b\" : [true, false, null, { }, [ ]]}], \"id\": 2}",
+    "{\"unknown\": nuly, \"id\": 1}",
+    "{\"unknown\": [3.,4e38], \"id\": 1}",
+    "{\"unknown\": {, \"id\": 1}",
+    "{\"unknown\": { xd\":true}, \"id\": 1}",
+    "{\"unknown\": {\"a\" 1}, \"id\": 1}",
+    "{\"unknown\": [1 2], \"id\": 1}",
+    "{\"unknown\": [1, {\"a\": tru}], \"id\": 1}",
+    "{\"unknown\": 01, \"id\": 1}",
+    "{\"counted\": [1, 2, 3, 4, 5.]}",
+    "{\"intList\": [1, [nuly]]}",
+    "{\"vec\": [{\"x\": 3.}]}",
+};
+
+#define TEST_INPUT_COUNT    (sizeof(testInputs) / sizeof(testInputs[0]))
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * @file test_msgpack.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief msgpack编解码测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 对象编码为msgpack后再解析，得到的对象与原对象的json编码一致，
+ *       截断以及随机修改的数据不能导致越界访问
+ */
+
+#include "cson_check.h"
+#include "test_model.h"
+
+
+/**
+ * @brief 输出缓冲
+ */
+typedef struct
+{
+    char *buf;                              /**< 缓冲区 */
+    size_t len;                             /**< 已输出长度 */
+} CheckOutput;
+
+
+/**
+ * @brief 输出函数
+ *
+ * @param param 输出缓冲
+ * @param data 数据
+ * @param len 数据长度
+ * @return int 0 成功
+ */
+static int checkWrite(void *param, const char *data, size_t len)
+{
+    CheckOutput *out = param;
+    out->buf = realloc(out->buf, out->len + len);
+    memcpy(out->buf + out->len, data, len);
+    out->len += len;
+    return 0;
+}
+
+
+/**
+ * @brief msgpack往返检查
+ *
+ * @param obj 对象
+ * @param seed 随机修改的种子
+ */
+static void checkRoundTrip(struct test *obj, unsigned int seed)
+{
+    static char buffer[1 << 17];
+    size_t len = 0;
+    char *json = csonEncodeUnformatted(obj, model, MODEL_SIZE);
+    char *data = csonEncodeMsgpack(obj, model, MODEL_SIZE, &len);
+    CHECK(data != NULL && len > 0);
+
+    CheckOutput out = {0};
+    CHECK(csonEncodeMsgpackStream(obj, model, MODEL_SIZE, checkWrite, &out) == 0);
+    CHECK(out.len == len && memcmp(out.buf, data, len) == 0);
+    free(out.buf);
+
+    struct test *back = csonDecodeMsgpack(data, len, model, MODEL_SIZE);
+    char *backJson = checkEncode(back, model, MODEL_SIZE);
+    CHECK_STR(backJson, json);
+    csonFree(back, model, MODEL_SIZE);
+    free(backJson);
+
+    /* 截断的数据必须解析失败 */
+    for (size_t i = 0; i < len; i++)
+    {
+        char *part = malloc(i + 1);
+        memcpy(part, data, i);
+        back = csonDecodeMsgpack(part, i, model, MODEL_SIZE);
+        CHECK(back == NULL);
+        csonFree(back, model, MODEL_SIZE);
+        free(part);
+    }
+
+    /* 随机修改的数据可以解析成功，但不能越界 */
+    srand(seed);
+    for (int i = 0; i < 500; i++)
+    {
+        char *copy = malloc(len);
+        memcpy(copy, data, len);
+        for (int j = 0; j < 3; j++)
+        {
+            copy[rand() % len] = (char) rand();
+        }
+        back = csonDecodeMsgpack(copy, len, model, MODEL_SIZE);
+        if (back)
+        {
+            size_t size;
+            free(csonEncodeUnformatted(back, model, MODEL_SIZE));
+            free(csonEncodeMsgpack(back, model, MODEL_SIZE, &size));
+            csonFree(back, model, MODEL_SIZE);
+        }
+        free(copy);
+    }
+
+    /* 内存池以及结束检查 */
+    CsonArena arena;
+    CsonContext ctx = {0};
+    csonArenaInit(&arena, buffer, sizeof(buffer));
+    ctx.arena = &arena;
+    ctx.options = CSON_OPTION_REQUIRE_END;
+    back = csonDecodeMsgpackCtx(&ctx, data, len, model, MODEL_SIZE);
+    backJson = checkEncode(back, model, MODEL_SIZE);
+    CHECK_STR(backJson, json);
+    free(backJson);
+    csonArenaReset(&arena);
+
+    char *longer = malloc(len + 1);
+    memcpy(longer, data, len);
+    longer[len] = '\0';
+    CHECK(csonDecodeMsgpackCtx(&ctx, longer, len + 1, model, MODEL_SIZE) == NULL);
+    CHECK(ctx.error == longer + len);
+    CHECK(arena.offset == 0);
+    free(longer);
+
+    csonFreeJson(data);
+    csonFreeJson(json);
+}
+
+
+/**
+ * @brief 整数边界值
+ */
+static void checkIntegers(void)
+{
+    struct test obj = {0};
+    const long values[] = {0, 1, -1, 127, 128, -32, -33, 255, 256, 65535, 65536, -32768, -32769,
+                           2147483647L, -2147483647L - 1, 9007199254740993L, -9223372036854775807L - 1};
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        size_t len;
+        obj.big = values[i];
+        obj.longs[0] = -values[i] / 3;
+        char *data = csonEncodeMsgpack(&obj, model, MODEL_SIZE, &len);
+        struct test *back = csonDecodeMsgpack(data, len, model, MODEL_SIZE);
+        CHECK(back && back->big == obj.big && back->longs[0] == obj.longs[0]);
+        csonFree(back, model, MODEL_SIZE);
+        csonFreeJson(data);
+    }
+}
+
+
+int main(void)
+{
+    csonInit(malloc, free);
+
+    for (size_t i = 0; i < TEST_INPUT_COUNT; i++)
+    {
+        struct test *obj = csonDecodeDirect(testInputs[i], model, MODEL_SIZE);
+        if (obj)
+        {
+            checkRoundTrip(obj, (unsigned int) i);
+        }
+        csonFree(obj, model, MODEL_SIZE);
+    }
+    checkIntegers();
+
+    size_t len;
+    char *data = csonEncodeMsgpack(NULL, model, MODEL_SIZE, &len);
+    CHECK(len == 1 && (unsigned char) data[0] == 0xc0);
+    CHECK(csonDecodeMsgpack(data, len, model, MODEL_SIZE) == NULL);
+    csonFreeJson(data);
+
+    return checkReport("msgpack");
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_pool.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief 节点池测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 检查节点池统计，稳定运行后不再调用分配函数，多线程下各自缓存，
+ *       以及线程退出后不遗留缓存的节点
+ */
+
+#include "cson_check.h"
+#include "cson_batch.h"
+#include "pthread.h"
+
+
+struct pt
+{
+    int x;
+    char *tag;
+};
+
+struct test
+{
+    int id;
+    CsonList *pts;
+    CsonList *ints;
+    CsonList *strs;
+};
+
+CsonModel ptModel[] =
+{
+    CSON_MODEL_OBJ(struct pt),
+    CSON_MODEL_INT(struct pt, x),
+    CSON_MODEL_STRING(struct pt, tag)
+};
+
+CsonModel model[] =
+{
+    CSON_MODEL_OBJ(struct test),
+    CSON_MODEL_INT(struct test, id),
+    CSON_MODEL_LIST(struct test, pts, ptModel, 3),
+    CSON_MODEL_LIST(struct test, ints, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_LIST(struct test, strs, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE)
+};
+
+#define MODEL_SIZE  ((int) (sizeof(model) / sizeof(CsonModel)))
+
+static const char *json =
+    "{\"id\": 1, \"pts\": [{\"x\": 1, \"tag\": \"a\"}, {\"x\": 2}], \"ints\": [1, 2, 3, 4], \"strs\": [\"a\", \"b\"]}";
+
+
+/**
+ * @brief 解析，编码，更新并释放
+ *
+ * @param count 次数
+ */
+static void checkRun(int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        struct test *tree = csonDecode(json, model, MODEL_SIZE);
+        struct test *direct = csonDecodeDirect(json, model, MODEL_SIZE);
+        char *treeJson = checkEncode(tree, model, MODEL_SIZE);
+        char *directJson = checkEncode(direct, model, MODEL_SIZE);
+        CHECK_STR(directJson, treeJson);
+        CHECK(csonDecodeInto(direct, "{\"ints\": [5, 6, 7, 8, 9]}", model, MODEL_SIZE, 0) == 0);
+        csonFree(tree, model, MODEL_SIZE);
+        csonFree(direct, model, MODEL_SIZE);
+        checkFree(treeJson);
+        checkFree(directJson);
+    }
+}
+
+
+/**
+ * @brief 工作线程
+ *
+ * @param param 线程的节点池统计
+ * @return void* NULL
+ * @note 检查计数不是线程安全的，统计交给主线程检查
+ */
+static void *checkThread(void *param)
+{
+    CsonPoolStats *stats = param;
+
+    for (int i = 0; i < 200; i++)
+    {
+        void *obj = csonDecodeDirect(json, model, MODEL_SIZE);
+        csonFree(obj, model, MODEL_SIZE);
+        obj = csonDecode(json, model, MODEL_SIZE);
+        csonFree(obj, model, MODEL_SIZE);
+    }
+    csonPoolGetStats(CSON_POOL_JSON, &stats[0]);
+    csonPoolGetStats(CSON_POOL_LIST, &stats[1]);
+    csonPoolRelease();
+    return NULL;
+}
+
+
+/**
+ * @brief 批量解析的工作线程退出时释放缓存
+ *
+ * @note 解析失败的记录在工作线程中释放，节点进入工作线程的节点池
+ */
+static void checkBatch(void)
+{
+    const char *line = "{\"pts\": [{\"x\": 1}, {\"x\": 2}], \"ints\": [1, 2, 3], tru}\n"
+                       "{\"id\": 2, \"ints\": [4, 5]}\n";
+    size_t lineLen = strlen(line);
+    size_t len = lineLen * 1024;
+    char *buffer = malloc(len);
+    CsonBatchRecord *records;
+    size_t count;
+
+    for (size_t i = 0; i < 1024; i++)
+    {
+        memcpy(buffer + i * lineLen, line, lineLen);
+    }
+    CHECK(csonDecodeBatch(buffer, len, model, MODEL_SIZE, 4, NULL, &records, &count) == 1024);
+    CHECK(count == 2048);
+    csonFreeBatch(records, count, model, MODEL_SIZE);
+    csonPoolRelease();
+    CHECK(checkLiveCount == 0);
+    free(buffer);
+}
+
+
+int main(void)
+{
+    CsonPoolStats json, list, before;
+
+    csonInit(checkMalloc, checkFree);
+
+    /* 默认关闭 */
+    checkRun(10);
+    csonPoolGetStats(CSON_POOL_JSON, &json);
+    csonPoolGetStats(CSON_POOL_LIST, &list);
+    CHECK(json.hits == 0 && json.cached == 0);
+    CHECK(list.hits == 0 && list.cached == 0);
+
+    /* 稳定运行后不再调用分配函数 */
+    csonPoolConfig(256, 256);
+    checkRun(5);
+    csonPoolGetStats(CSON_POOL_JSON, &json);
+    csonPoolGetStats(CSON_POOL_LIST, &list);
+    checkRun(100);
+    csonPoolGetStats(CSON_POOL_JSON, &before);
+    CHECK(before.misses == json.misses && before.hits > json.hits);
+    csonPoolGetStats(CSON_POOL_LIST, &before);
+    CHECK(before.misses == list.misses && before.hits > list.hits);
+
+    /* 每个线程各自缓存 */
+    pthread_t tids[4];
+    CsonPoolStats stats[4][CSON_POOL_TYPE_COUNT];
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK(pthread_create(&tids[i], NULL, checkThread, stats[i]) == 0);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        pthread_join(tids[i], NULL);
+        CHECK(stats[i][CSON_POOL_JSON].hits > 0 && stats[i][CSON_POOL_LIST].hits > 0);
+    }
+    csonPoolRelease();
+    CHECK(checkLiveCount == 0);
+
+    checkBatch();
+
+    /* 缓存已满时直接释放 */
+    csonPoolConfig(2, 2);
+    checkRun(3);
+    csonPoolGetStats(CSON_POOL_LIST, &list);
+    CHECK(list.cached <= 2 && list.releases > 0);
+    csonPoolRelease();
+    csonPoolGetStats(CSON_POOL_LIST, &list);
+    CHECK(list.cached == 0);
+    CHECK(checkLiveCount == 0);
+
+    return checkReport("pool");
+}
@@ -0,0 +1,153 @@
+/**
+ * @file test_stream.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief 增量解析测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 输入按任意位置拆分为多个数据块送入增量解析器，
+ *       结果以及错误位置必须与`csonDecodeCtx`一致
+ */
+
+#include "cson_check.h"
+#include "test_model.h"
+
+
+static unsigned int randomSeed = 1;
+
+/**
+ * @brief 伪随机数
+ *
+ * @return unsigned int 随机数
+ */
+static unsigned int checkRandom(void)
+{
+    randomSeed = randomSeed * 1103515245 + 12345;
+    return randomSeed >> 8;
+}
+
+/**
+ * @brief 拆分输入进行增量解析
+ *
+ * @param ctx 解析上下文
+ * @param compiled 预编译模型，为NULL时使用数据模型
+ * @param json json字符串
+ * @param split 首个数据块大小，为0时按随机大小拆分
+ * @param offset 解析失败时的出错位置
+ * @return struct test* 解析得到的对象
+ */
+static struct test *checkFeed(CsonContext *ctx, CsonCompiledModel *compiled,
+                              const char *json, size_t split, size_t *offset)
+{
+    size_t len = strlen(json);
+    size_t pos = 0;
+    CsonDecoder *decoder = compiled
+        ? csonDecoderCreateCompiled(ctx, compiled)
+        : csonDecoderCreate(ctx, model, MODEL_SIZE);
+
+    while (pos < len)
+    {
+        size_t size = split ? (pos == 0 ? split : len - pos) : 1 + checkRandom() % 7;
+        if (size > len - pos)
+        {
+            size = len - pos;
+        }
+        /* 每个数据块单独分配，解析器不能在块之后继续读取 */
+        char *chunk = malloc(size);
+        memcpy(chunk, json + pos, size);
+        int ret = csonDecoderFeed(decoder, chunk, size);
+        free(chunk);
+        pos += size;
+        if (ret != 0)
+        {
+            break;
+        }
+    }
+    *offset = csonDecoderOffset(decoder);
+    return csonDecoderFinish(decoder);
+}
+
+
+/**
+ * @brief 比较增量解析与整体解析
+ *
+ * @param json json字符串
+ * @param options 解析选项
+ * @param compiled 预编译模型
+ */
+static void checkStream(const char *json, int options, CsonCompiledModel *compiled)
+{
+    CsonContext ctx = {0};
+    ctx.options = options;
+    struct test *ref = csonDecodeCtx(&ctx, json, model, MODEL_SIZE);
+    size_t refOffset = ctx.error ? (size_t) (ctx.error - json) : 0;
+    char *refJson = checkEncode(ref, model, MODEL_SIZE);
+    size_t len = strlen(json);
+
+    for (size_t split = 0; split <= len + 1; split++)
+    {
+        for (int useCompiled = 0; useCompiled < 2; useCompiled++)
+        {
+            size_t offset;
+            struct test *obj = checkFeed(&ctx, useCompiled ? compiled : NULL,
+                                         json, split > len ? 1 : split, &offset);
+            char *objJson = checkEncode(obj, model, MODEL_SIZE);
+            CHECK_STR(objJson, refJson);
+            if (!obj && ref == NULL && ctx.error)
+            {
+                CHECK(offset == refOffset);
+            }
+            if (obj && obj->view.str)
+            {
+                /* 数据块已经释放，字符串视图必须持有自己的副本 */
+                CHECK(obj->view.owned);
+            }
+            csonFree(obj, model, MODEL_SIZE);
+            free(objJson);
+        }
+    }
+
+    csonFree(ref, model, MODEL_SIZE);
+    free(refJson);
+}
+
+
+/**
+ * @brief 内存池增量解析，失败时内存池回退
+ */
+static void checkArena(void)
+{
+    static char buffer[1 << 16];
+    CsonArena arena;
+    CsonContext ctx = {0};
+    size_t offset;
+    csonArenaInit(&arena, buffer, sizeof(buffer));
+    ctx.arena = &arena;
+
+    struct test *obj = checkFeed(&ctx, NULL, testInputs[0], 0, &offset);
+    CHECK(obj && obj->far == 99 && arena.offset > 0);
+    csonArenaReset(&arena);
+
+    obj = checkFeed(&ctx, NULL, "{\"name\": \"abc\", \"list\": [{\"id\": 1}, tru]}", 0, &offset);
+    CHECK(obj == NULL && arena.offset == 0);
+}
+
+
+int main(void)
+{
+    csonInit(malloc, free);
+
+    CsonCompiledModel *compiled = csonCompileModel(model, MODEL_SIZE);
+    for (size_t i = 0; i < TEST_INPUT_COUNT; i++)
+    {
+        checkStream(testInputs[i], 0, compiled);
+        checkStream(testInputs[i], CSON_OPTION_REQUIRE_END, compiled);
+    }
+    csonFreeCompiledModel(compiled);
+
+    checkArena();
+
+    return checkReport("stream");
+}
@@ -0,0 +1,202 @@
+/**
+ * @file test_validate.c
+ * @author Letter (NevermindZZT@gmail.com)
+ * @brief 数据校验测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2019 Letter
+ *
+ * @note 检查错误码，出错成员以及出错位置，校验过程不能分配内存，
+ *       校验通过的json必须可以解析
+ */
+
+#include "cson_check.h"
+
+
+struct pt
+{
+    int x;
+    char *tag;
+};
+
+struct test
+{
+    int id;
+    char *name;
+    double d;
+    char b;
+    struct pt *pos;
+    CsonList *pts;
+    CsonList *ints;
+    CsonVector vs;
+    int arr[3];
+    int n;
+    char *raw;
+    CsonStringView v;
+};
+
+CsonModel ptModel[] =
+{
+    CSON_MODEL_OBJ(struct pt),
+    CSON_MODEL_INT(struct pt, x),
+    CSON_MODEL_STRING(struct pt, tag)
+};
+
+CsonModel model[] =
+{
+    CSON_MODEL_OBJ(struct test),
+    CSON_MODEL_INT(struct test, id),
+    CSON_MODEL_STRING(struct test, name),
+    CSON_MODEL_DOUBLE(struct test, d),
+    {CSON_TYPE_BOOL, "b", offsetof(struct test, b)},
+    CSON_MODEL_STRUCT(struct test, pos, ptModel, 3),
+    CSON_MODEL_LIST(struct test, pts, ptModel, 3),
+    CSON_MODEL_LIST(struct test, ints, CSON_MODEL_INT_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_VECTOR(struct test, vs, CSON_MODEL_STRING_LIST, CSON_BASIC_LIST_MODEL_SIZE),
+    CSON_MODEL_ARRAY_COUNT(struct test, arr, CSON_TYPE_INT, 3, n),
+    CSON_MODEL_JSON(struct test, raw),
+    CSON_MODEL_STRING_VIEW(struct test, v)
+};
+
+#define MODEL_SIZE  ((int) (sizeof(model) / sizeof(CsonModel)))
+
+#define GOOD_JSON \
+        "{\"id\": 1, \"name\": \"n\\u00e9\\n\", \"d\": -1.5e-3, \"b\": true, \"pos\": {\"x\": 0, \"tag\": null}, " \
+        "\"pts\": [{\"x\": 1, \"tag\": \"a\"}, null], \"ints\": [1, 2], \"vs\": [\"a\", null], \"arr\": [1, 2, 3], " \
+        "\"raw\": {\"any\": [1, {\"z\": false}]}, \"v\": \"x\", \"extra\": [1, {\"q\": \"r\"}]}"
+
+
+static const struct
+{
+    const char *json;                       /**< 输入 */
+    int code;                               /**< 错误码 */
+    const char *key;                        /**< 出错成员 */
+    int offset;                             /**< 出错位置，-1不检查 */
+} cases[] =
+{
+    {GOOD_JSON, CSON_VALIDATE_OK, NULL, -1},
+    {"{\"ID\": 1, \"name\": null, \"d\": 0, \"b\": false, \"pos\": null, \"pts\": null, \"ints\": [], "
+     "\"vs\": null, \"arr\": null, \"raw\": null, \"v\": null}", CSON_VALIDATE_OK, NULL, -1},
+    {"{\"id\": 1}", CSON_VALIDATE_MISSING, "name", 8},
+    {"{\"id\": \"1\", \"name\": null}", CSON_VALIDATE_TYPE, "id", 7},
+    {"{\"id\": 1, \"name\": 5}", CSON_VALIDATE_TYPE, "name", 18},
+    {"{\"id\": 1, \"b\": 1}", CSON_VALIDATE_TYPE, "b", 15},
+    {"{\"id\": 1, \"arr\": [1, 2, 3, 4]}", CSON_VALIDATE_BOUNDS, "arr", 27},
+    {"{\"id\": 1, \"arr\": [1, \"2\"]}", CSON_VALIDATE_TYPE, "arr", 21},
+    {"{\"pos\": {\"x\": 1}}", CSON_VALIDATE_MISSING, "tag", 15},
+    {"{\"pos\": {\"x\": 1, \"tag\": 2}}", CSON_VALIDATE_TYPE, "tag", 24},
+    {"{\"pts\": [{\"x\": 1, \"tag\": \"\"}, 5]}", CSON_VALIDATE_TYPE, "pts", 30},
+    {"{\"ints\": [1, \"a\"]}", CSON_VALIDATE_TYPE, "ints", 13},
+    {"{\"pos\": [1]}", CSON_VALIDATE_TYPE, "pos", 8},
+    {"{\"id\": 01}", CSON_VALIDATE_SYNTAX, NULL, 8},
+    {"{\"id\": 1,}", CSON_VALIDATE_SYNTAX, NULL, 9},
+    {"{\"id\": 1", CSON_VALIDATE_SYNTAX, NULL, 8},
+    {"{\"name\": \"abc", CSON_VALIDATE_SYNTAX, "name", 13},
+    {"{\"name\": \"a\\x\"}", CSON_VALIDATE_SYNTAX, "name", 12},
+    {"{\"name\": \"a\\u12g4\"}", CSON_VALIDATE_SYNTAX, "name", 12},
+    {"{\"name\": \"a\tb\"}", CSON_VALIDATE_SYNTAX, "name", 11},
+    {"{\"raw\": [1, tru]}", CSON_VALIDATE_SYNTAX, "raw", 12},
+    {"{\"raw\": {\"a\" 1}}", CSON_VALIDATE_SYNTAX, "raw", 13},
+    {"{\"d\": 1.}", CSON_VALIDATE_SYNTAX, "d", 8},
+    {"{\"d\": 1e}", CSON_VALIDATE_SYNTAX, "d", 8},
+    {"{\"d\": -}", CSON_VALIDATE_SYNTAX, "d", 7},
+    {GOOD_JSON " x", CSON_VALIDATE_SYNTAX, NULL, (int) sizeof(GOOD_JSON)},
+    {"[1]", CSON_VALIDATE_TYPE, NULL, 0},
+    {"  null", CSON_VALIDATE_TYPE, NULL, 2},
+    {"", CSON_VALIDATE_SYNTAX, NULL, 0},
+};
+
+
+/**
+ * @brief 校验结果与解析结果一致
+ *
+ * @note 输入中包含结束符，解析只处理结束符之前的部分，校验必须同样失败
+ */
+static void checkAgreement(void)
+{
+    struct one
+    {
+        char *a;
+    };
+    CsonModel oneModel[] =
+    {
+        CSON_MODEL_OBJ(struct one),
+        CSON_MODEL_STRING(struct one, a)
+    };
+#define CHECK_JSON(json)    {json, sizeof(json) - 1}
+    static const struct
+    {
+        const char *json;                   /**< 输入 */
+        size_t len;                         /**< 长度，包含中间的结束符 */
+    } inputs[] =
+    {
+        CHECK_JSON("{\"a\":\"\\\0\"}"),
+        CHECK_JSON("{\"a\":\"x\\\0y\"}"),
+        CHECK_JSON("{\"a\":\"\\u00\0\0\"}"),
+        CHECK_JSON("{\"a\":\"x\0\"}"),
+        CHECK_JSON("{\"a\":\"\\\\\"}"),
+        CHECK_JSON("{\"a\":\"\\u00e9\\/\"}"),
+        CHECK_JSON("{\"a\":null}"),
+    };
+#undef CHECK_JSON
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+    {
+        int valid = csonValidate(inputs[i].json, inputs[i].len, oneModel, 2, NULL) == 0;
+        void *direct = csonDecodeDirect(inputs[i].json, oneModel, 2);
+        void *tree = csonDecode(inputs[i].json, oneModel, 2);
+        CHECK(valid == (direct != NULL));
+        CHECK(valid == (tree != NULL));
+        csonFree(direct, oneModel, 2);
+        csonFree(tree, oneModel, 2);
+    }
+}
+
+
+int main(void)
+{
+    csonInit(checkMalloc, checkFree);
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        CsonValidateError error;
+        long mallocCount = checkMallocCount;
+        int ret = csonValidate(cases[i].json, strlen(cases[i].json), model, MODEL_SIZE, &error);
+
+        CHECK(checkMallocCount == mallocCount);
+        CHECK((ret == 0) == (cases[i].code == CSON_VALIDATE_OK));
+        CHECK(error.code == cases[i].code);
+        CHECK_STR(error.key, cases[i].key);
+        CHECK(cases[i].offset < 0 || (int) error.offset == cases[i].offset);
+        if (ret == 0)
+        {
+            void *obj = csonDecodeDirect(cases[i].json, model, MODEL_SIZE);
+            CHECK(obj != NULL);
+            csonFree(obj, model, MODEL_SIZE);
+        }
+    }
+
+    /* 深层嵌套 */
+    size_t len = strlen("{\"raw\": ");
+    char *deep = malloc(len + 40001);
+    memcpy(deep, "{\"raw\": ", len);
+    memset(deep + len, '[', 40000);
+    deep[len + 40000] = '\0';
+    CsonValidateError error;
+    CHECK(csonValidate(deep, len + 40000, model, MODEL_SIZE, &error) != 0);
+    CHECK(error.code == CSON_VALIDATE_SYNTAX);
+    free(deep);
+
+    /* 所有前缀都不完整 */
+    for (size_t i = 0; i < strlen(GOOD_JSON); i++)
+    {
+        CHECK(csonValidate(GOOD_JSON, i, model, MODEL_SIZE, NULL) != 0);
+    }
+    CHECK(csonValidateEx(GOOD_JSON, model, NULL) == 0);
+
+    checkAgreement();
+    CHECK(checkLiveCount == 0);
+
+    return checkReport("validate");
+}